@@ -20,11 +20,12 @@
 
 #include <LinAlg/Matrix.hpp>
 #include <LinAlg/SpdMatrix.hpp>
+#include <LinAlg/SubMatrix.hpp>
 
 namespace BOOM{
     class Chol{
     public:
-      Chol(const Matrix &A);
+      explicit Chol(const Matrix &A);
       uint nrow()const;
       uint ncol()const;
       uint dim()const;
@@ -33,6 +34,15 @@ namespace BOOM{
       Matrix solve(const Matrix &B)const;
       Vector solve(const Vector &b)const;
       SpdMatrix inv()const;  // inverse of A
+
+      // Returns L^{-T} z, which is N(0, A^{-1}) if z is N(0, I).  Only
+      // the lower triangle of the decomposition is referenced, so
+      // this avoids the copy made by getL().
+      Vector LTsolve(const Vector &z)const;
+
+      // Returns x^T A x, computed as |L^T x|^2.
+      double quadratic_form(const Vector &x)const;
+
       SpdMatrix original_matrix()const;
       double det()const;     // det(A)
       double logdet()const;  // log(det(A))
@@ -48,5 +58,25 @@ namespace BOOM{
   Chol operator*(double a, const Chol &C);
   Chol operator*(const Chol &C, double a);
 
+  // Given the lower triangular Cholesky factor L of a matrix A,
+  // overwrite L with the Cholesky factor of A + x * x^T.  The update
+  // costs O(n^2) instead of the O(n^3) needed to refactor from
+  // scratch.  Only the lower triangle of L is referenced.
+  //
+  // Args:
+  //   L:  The Cholesky factor to be updated.
+  //   x: A vector with length matching the dimension of L.  It is
+  //     used as workspace, and its contents are destroyed.
+  void cholesky_rank_one_update(SubMatrix L, VectorView x);
+
+  // Given the lower triangular Cholesky factor L of a matrix A,
+  // overwrite L with the Cholesky factor of A - x * x^T.  Arguments
+  // are as in cholesky_rank_one_update.
+  //
+  // Returns:
+  //   true if A - x * x^T is positive definite.  If false is returned
+  //   then the contents of L are unspecified.
+  bool cholesky_rank_one_downdate(SubMatrix L, VectorView x);
+
 }
 #endif// BOOM_CHOL_HPP
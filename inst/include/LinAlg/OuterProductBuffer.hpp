@@ -0,0 +1,68 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_OUTER_PRODUCT_BUFFER_HPP
+#define BOOM_OUTER_PRODUCT_BUFFER_HPP
+
+#include <LinAlg/Matrix.hpp>
+#include <LinAlg/SpdMatrix.hpp>
+#include <LinAlg/VectorView.hpp>
+
+namespace BOOM {
+
+  // Accumulates a stream of weighted outer products w * x * x^T into
+  // the upper triangle of an SpdMatrix.  Adding them one at a time
+  // costs a rank-one update (dsyr) per vector, which makes a full pass
+  // over the target matrix for every observation.  An
+  // OuterProductBuffer stores up to 'capacity' scaled vectors
+  // sqrt(w) * x, and adds them all with a single rank-k update (dsyrk)
+  // when the buffer fills, or when flush() is called.
+  //
+  // A sufficient statistic that uses a buffer must flush it before
+  // reading the target matrix.  Only the upper triangle of the target
+  // is modified.
+  class OuterProductBuffer {
+   public:
+    explicit OuterProductBuffer(int capacity = 64);
+
+    // Add w * x * x^T to 'target', which must be x.size() square.
+    // The addition may be deferred until the next call to flush().
+    // Negative weights are added immediately.
+    void add(const ConstVectorView &x, double w, SpdMatrix &target);
+
+    // Add any deferred outer products to 'target', and empty the
+    // buffer.  'target' must be the matrix passed to add().
+    void flush(SpdMatrix &target);
+
+    // Discard any deferred outer products.
+    void clear() {size_ = 0;}
+
+    bool empty() const {return size_ == 0;}
+
+   private:
+    int capacity_;
+    int size_;
+
+    // Column i holds sqrt(w) * x for the i'th deferred vector.  The
+    // storage is allocated on first use.
+    Matrix columns_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_OUTER_PRODUCT_BUFFER_HPP
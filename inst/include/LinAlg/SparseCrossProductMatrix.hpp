@@ -0,0 +1,120 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_SPARSE_CROSS_PRODUCT_MATRIX_HPP
+#define BOOM_SPARSE_CROSS_PRODUCT_MATRIX_HPP
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <LinAlg/Selector.hpp>
+#include <LinAlg/SpdMatrix.hpp>
+#include <LinAlg/Vector.hpp>
+#include <LinAlg/VectorView.hpp>
+
+namespace BOOM {
+
+  // A symmetric matrix of cross products X'WX, stored sparsely.  When
+  // the rows of X are sparse (e.g. many one-hot encoded categorical
+  // predictors) most elements of X'WX are zero, and a dense SpdMatrix
+  // with p^2 elements can be far larger than the data.  This class
+  // stores only the nonzero elements of the upper triangle, sorted by
+  // column, so memory is proportional to the number of nonzeros.
+  //
+  // Outer products are accumulated as (position, value) pairs in a
+  // buffer, which is sorted and merged into the stored elements when
+  // it fills, or when an element is read.  Reading is therefore
+  // logically const but not thread safe.
+  //
+  // Callers that need dense blocks (e.g. to factor the posterior
+  // precision of the included coefficients in a spike and slab
+  // model) pull them on demand with select().
+  class SparseCrossProductMatrix {
+   public:
+    // Args:
+    //   dim:  The number of rows (and columns) in the matrix.
+    //   buffer_capacity: The number of pending elements to collect
+    //     before they are merged into the stored matrix.
+    explicit SparseCrossProductMatrix(int dim = 0,
+                                      int buffer_capacity = 1 << 20);
+
+    int dim() const {return dim_;}
+
+    // The number of distinct nonzero elements in the upper triangle
+    // (including the diagonal).
+    std::size_t nonzeros() const;
+
+    // Set all elements to zero, keeping the dimension.
+    void clear();
+
+    // Add w * x * x^T, where x is a sparse vector with value
+    // values[k] in position index[k], for k = 0, ..., nnz - 1.  The
+    // positions must be distinct.
+    void add_outer(const int *index, const double *values, int nnz,
+                   double w = 1.0);
+
+    // Add w * x * x^T for a dense vector x.  Zero elements of x are
+    // skipped.
+    void add_outer(const ConstVectorView &x, double w = 1.0);
+
+    // Add another matrix of the same dimension to this one.
+    void add(const SparseCrossProductMatrix &rhs);
+
+    // Element (i, j).  Costs O(log(nonzeros())).
+    double operator()(int i, int j) const;
+
+    // The diagonal elements.  The cost is proportional to
+    // nonzeros(), not to dim()^2.
+    Vector diag() const;
+
+    // The rows and columns of the matrix for the included variables.
+    // The cost is proportional to the number of nonzero elements in
+    // the included columns, not to dim()^2.
+    SpdMatrix select(const Selector &inc) const;
+
+    // The full matrix.  This needs dim()^2 storage, so it should be
+    // avoided for large problems.
+    SpdMatrix dense() const;
+
+    // Serialize as [nonzeros, (position, value) pairs...].  Positions
+    // are stored exactly as doubles, which limits dim() to about 9e7.
+    Vector vectorize() const;
+    Vector::const_iterator unvectorize(Vector::const_iterator &v);
+
+   private:
+    // Elements are keyed by column * dim + row, with row <= column, so
+    // sorting by key sorts by column, and by row within a column.
+    std::uint64_t key(int i, int j) const {
+      return i <= j ? std::uint64_t(j) * dim_ + i
+          : std::uint64_t(i) * dim_ + j;
+    }
+    void push(int i, int j, double value);
+
+    // Merge the pending elements into keys_ and values_.
+    void flush() const;
+
+    int dim_;
+    std::size_t buffer_capacity_;
+    mutable std::vector<std::uint64_t> keys_;
+    mutable std::vector<double> values_;
+    mutable std::vector<std::pair<std::uint64_t, double> > pending_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_SPARSE_CROSS_PRODUCT_MATRIX_HPP
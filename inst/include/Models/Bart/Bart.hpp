@@ -19,6 +19,8 @@
 #ifndef BOOM_BART_HPP_
 #define BOOM_BART_HPP_
 
+#include <cstdint>
+#include <functional>
 #include <set>
 
 #include <LinAlg/SubMatrix.hpp>
@@ -29,12 +31,14 @@
 #include <Models/Policies/PriorPolicy.hpp>
 #include <distributions/rng.hpp>
 #include <cpputil/math_utils.hpp>
+#include <cpputil/ThreadTools.hpp>
 
 namespace BOOM {
 
   namespace Bart {
     class TreeNode;
     class VariableSummaryImpl;
+    class BinnedPredictors;
 
     // The default BART algorithm operates by having each tree sample
     // a model for its data, conditional on all the other trees.  The
@@ -66,6 +70,11 @@ namespace BOOM {
       // Add relevant functions of data to the sufficient statistics
       // being modeled.
       virtual void update(const ResidualRegressionData &data) = 0;
+
+      // Add the sufficient statistics in rhs to *this.  The concrete
+      // type of rhs must match the concrete type of *this.
+      virtual void combine(const SufficientStatisticsBase &rhs) = 0;
+
       virtual SufficientStatisticsBase * create() const {
         SufficientStatisticsBase * ans = clone();
         ans->clear();
@@ -85,7 +94,9 @@ namespace BOOM {
 
       // Choose cutpoints at random according to a discretization of
       // the empirical CDF.  This will put more cutpoints into regions
-      // where there is more data.
+      // where there is more data.  The cutpoints are a set of
+      // empirical quantiles, and are handled exactly like the values
+      // of a discrete variable.
       DISCRETE_QUANTILES
     };
 
@@ -153,8 +164,14 @@ namespace BOOM {
       // Args:
       //   discrete_distribution_cutoff: The number of unique values a
       //     numeric variable must have before it is considered continuous.
+      //   strategy:  How to choose cutpoints for continuous variables.
+      //   number_of_quantiles: The number of quantile bins to use for
+      //     continuous variables if strategy is DISCRETE_QUANTILES.
+      //     The cutpoints are the boundaries between bins, so there
+      //     are at most number_of_quantiles - 1 of them.
       void finalize(int discrete_distribution_cutoff = 20,
-                    ContinuousCutpointStrategy = UNIFORM_CONTINUOUS);
+                    ContinuousCutpointStrategy strategy = UNIFORM_CONTINUOUS,
+                    int number_of_quantiles = 100);
 
       // Serialize the value of this variable summary for long term
       // storage.
@@ -184,6 +201,12 @@ namespace BOOM {
       // at node or at any of its descendants.
       bool is_legal_configuration(const TreeNode *node) const;
 
+      // Returns the full set of cutpoints for a discrete variable,
+      // ignoring any restrictions imposed by the ancestors of a node.
+      // It is an error to call this function on a continuous
+      // variable.
+      const Vector &cutpoints() const;
+
      private:
       // Checks whether finalize() has been called.  Throws an
       // exception if it has not.
@@ -223,6 +246,7 @@ namespace BOOM {
       bool is_continuous() const override {return false;}
       Vector get_cutpoint_range(const TreeNode *node) const override;
       bool is_legal_configuration(const TreeNode *node) const override;
+      const Vector &cutpoint_values() const {return cutpoint_values_;}
      private:
       Vector cutpoint_values_;
     };
@@ -242,6 +266,190 @@ namespace BOOM {
       Vector range_;  // lower and upper limits for cutpoints
     };
 
+    //======================================================================
+    // The residual data for a Bart model, shared by all the trees in
+    // the model.  The ResidualRegressionData objects are owned by the
+    // posterior sampler.  The table keeps a copy of the predictors
+    // stored by column, so that assigning observations to nodes reads
+    // a contiguous array instead of following a pointer to each
+    // observation.  If binned predictors have been set, then the trees
+    // use them instead of the raw predictors.
+    class ResidualTable {
+     public:
+      ResidualTable() : pool_(nullptr), minimum_shard_size_(0) {}
+      void add_data(ResidualRegressionData *data_point);
+      int size() const {return data_.size();}
+      ResidualRegressionData *operator[](int i) const {return data_[i];}
+
+      // The data points in their original order.
+      ResidualRegressionData *const *data_points() const {
+        return data_.data();
+      }
+
+      // The values of the given predictor variable for each
+      // observation in the table.
+      const double *predictor(int variable) const {
+        return predictors_[variable].data();
+      }
+
+      // Loops over large ranges of observations (computing
+      // sufficient statistics, adjusting residuals, partitioning a
+      // node's data) can be split into shards that run on a thread
+      // pool.
+      // Args:
+      //   pool: The pool to use.  The pool is owned by the caller,
+      //     and must outlive the table or be replaced.  NULL means
+      //     run everything in the calling thread.
+      //   minimum_shard_size: Ranges are split so that each shard
+      //     has at least this many observations, so small nodes
+      //     don't pay the cost of thread synchronization.
+      void set_thread_pool(ThreadWorkerPool *pool, int minimum_shard_size);
+
+      // The number of shards to use for a loop over 'size'
+      // observations.  This is 1 unless a pool with more than one
+      // thread has been set, and 'size' is large enough to split.
+      int number_of_shards(int size) const;
+
+      // Split positions [begin, end) into number_of_shards(end -
+      // begin) contiguous shards, and call f(shard, shard_begin,
+      // shard_end) for each one.  The calls run in parallel, so f
+      // must only modify state belonging to its own shard.
+      void run_sharded(int begin, int end,
+                       const std::function<void(int, int, int)> &f) const;
+
+      void set_binned_predictors(
+          const boost::shared_ptr<BinnedPredictors> &bins) {
+        bins_ = bins;
+      }
+      // Returns NULL if no binned predictors have been set.
+      const BinnedPredictors *binned_predictors() const {return bins_.get();}
+
+     private:
+      std::vector<ResidualRegressionData *> data_;
+      std::vector<std::vector<double>> predictors_;
+      boost::shared_ptr<BinnedPredictors> bins_;
+      ThreadWorkerPool *pool_;
+      int minimum_shard_size_;
+    };
+
+    //======================================================================
+    // Predictors quantized to the cutpoints of a set of discrete
+    // variables, and stored by column.  The bin code for observation i
+    // on variable j is the number of cutpoints for variable j that are
+    // strictly less than x[i, j].  Thus x[i, j] <= cutpoints[j][k] if
+    // and only if code(i, j) <= k, so the trees can assign
+    // observations to nodes by comparing small integers from a
+    // contiguous array, instead of following a pointer to each
+    // observation's predictor Vector.
+    class BinnedPredictors {
+     public:
+      typedef uint16_t BinCode;
+
+      // Args:
+      //   cutpoints: Element j is the sorted vector of cutpoints for
+      //     variable j.  Each variable can have at most 65535
+      //     cutpoints.
+      //   data:  The observations to be binned.
+      BinnedPredictors(const std::vector<Vector> &cutpoints,
+                       const ResidualTable &data);
+
+      int number_of_observations() const {return number_of_observations_;}
+      int number_of_variables() const {return cutpoints_.size();}
+
+      // The number of distinct bin codes for a variable, which is one
+      // more than the number of cutpoints.
+      int number_of_bins(int variable) const {
+        return cutpoints_[variable].size() + 1;
+      }
+
+      // The bin codes for all observations on the given variable.
+      const BinCode *codes(int variable) const {
+        return codes_.data() + variable * number_of_observations_;
+      }
+      int code(int observation, int variable) const {
+        return codes(variable)[observation];
+      }
+
+      // Observations with code(i, variable) <= bin(variable, cutpoint)
+      // fall to the left of a split at 'cutpoint'.  If the cutpoint is
+      // not one of the variable's cutpoints it is treated as the
+      // largest cutpoint below it, and -1 is returned if there is no
+      // such cutpoint.
+      int bin(int variable, double cutpoint) const;
+
+     private:
+      int number_of_observations_;
+      std::vector<Vector> cutpoints_;
+      std::vector<BinCode> codes_;
+    };
+
+    //======================================================================
+    // Each tree keeps its own ordering of the observations in a
+    // ResidualTable, arranged so that the observations assigned to
+    // any node occupy a contiguous range of positions.  Splitting a
+    // node rearranges its range in place (as in quicksort), with the
+    // observations falling to the left child placed first, and
+    // observations keeping their relative order within each child.  The
+    // children then own the two halves of their parent's range.
+    //
+    // The data pointers are stored alongside the observation numbers,
+    // so that loops over a node's data read a contiguous block of
+    // pointers rather than going through the table.
+    class DataPartition {
+     public:
+      explicit DataPartition(const boost::shared_ptr<ResidualTable> &data);
+
+      int size() const {return index_.size();}
+
+      // The data point at the given position in the ordering.
+      ResidualRegressionData *operator[](int position) const {
+        return data_points_[position];
+      }
+
+      // The data points in the order of the partition, so that
+      // positions [begin, end) can be traversed without going back
+      // through the partition object.
+      ResidualRegressionData *const *data_points() const {
+        return data_points_.data();
+      }
+
+      // The observation number (the position in the ResidualTable) of
+      // the data point at the given position in the ordering.
+      int observation(int position) const {return index_[position];}
+
+      const BinnedPredictors *binned_predictors() const {
+        return data_->binned_predictors();
+      }
+
+      // The table of data points in its original order.
+      const ResidualTable &table() const {return *data_;}
+
+      // Rearranges positions [begin, end) so that observations with
+      // x[variable] <= cutpoint come first.
+      // Returns:
+      //   The position of the first observation with x[variable] >
+      //   cutpoint, or 'end' if there are no such observations.
+      int partition(int begin, int end, int variable, double cutpoint);
+
+     private:
+      template <class GOES_LEFT>
+      int stable_partition(int begin, int end, const GOES_LEFT &goes_left);
+      template <class GOES_LEFT>
+      int parallel_stable_partition(int begin, int end, int number_of_shards,
+                                    const GOES_LEFT &goes_left);
+
+      boost::shared_ptr<ResidualTable> data_;
+      std::vector<int> index_;
+      std::vector<ResidualRegressionData *> data_points_;
+
+      // Scratch space for partition().
+      std::vector<int> index_workspace_;
+      std::vector<ResidualRegressionData *> data_workspace_;
+      // side_workspace_[i] is 1 if position i goes left.  Used when
+      // partitioning in parallel.
+      std::vector<unsigned char> side_workspace_;
+    };
+
     //======================================================================
     // A TreeNode is one node in a Tree.  The node can be either a
     // leaf or an interior node.
@@ -373,24 +581,20 @@ namespace BOOM {
       void populate_sufficient_statistics(SufficientStatisticsBase *suf,
                                           bool recursive = true);
 
-      // Associate an observation with this node.
+      // Assign a range of observations to this node, and distribute
+      // them among the node's descendants.
       // Args:
-      //   dp:  The data point pointer to associate with this node.
-      //   recursive: If true then dp is also associated with either
-      //     the left or right child of *this, depending on whether
-      //     dp->x() indicates that the observation should fall to the
-      //     left or the right.
-      void populate_data(ResidualRegressionData *dp,
-                         bool recursive = true);
-
-      // Clear the data below this node, and drop this node's data
-      // down through the subtree formed by this node's descendants.
+      //   partition:  The ordering of the data owned by the tree.
+      //   begin, end: The node is assigned the observations at
+      //     positions [begin, end) of the partition.  The positions
+      //     may be rearranged among the node's descendants.
+      void populate_data(DataPartition *partition, int begin, int end);
+
+      // Divide this node's data between its children according to
+      // the splitting rule, and recursively refresh the data in the
+      // subtree formed by this node's descendants.
       void refresh_subtree_data();
 
-      // Take this data point, and recursively distribute it to either
-      // the left or right child.
-      void drop_data_to_subtree(ResidualRegressionData *dp);
-
       // Swaps the variable and cutpoint values for the two nodes.
       // ***** Note that this may introduce structural dead branches
       // in the tree (branches where it would be impossible to attract
@@ -409,8 +613,12 @@ namespace BOOM {
       // "is_current" observer.
       const SufficientStatisticsBase & compute_suf();
 
-      // The vector of data associated with this node.
-      const std::vector<ResidualRegressionData *> & data() const;
+      // The data associated with this node are the observations at
+      // positions [data_begin(), data_end()) of data_partition().
+      // The partition is NULL if no data have been assigned.
+      const DataPartition *data_partition() const {return partition_;}
+      int data_begin() const {return data_begin_;}
+      int data_end() const {return data_end_;}
 
       // Remove the effect of this node on the predicted values of the
       // data associated with it.  (I.e. adjust the predictions as if
@@ -437,7 +645,7 @@ namespace BOOM {
                                Matrix *tree_matrix) const;
 
       int sample_size() const {
-        return data_.size();
+        return data_end_ - data_begin_;
       }
 
      private:
@@ -453,8 +661,12 @@ namespace BOOM {
       // nodes, but only used if the node is a leaf.
       double mean_;
 
-      // The data for a node is not owned by the node.
-      std::vector<ResidualRegressionData *> data_;
+      // The data for a node is not owned by the node.  It is the
+      // range of positions [data_begin_, data_end_) in a partition
+      // owned by the tree.
+      DataPartition *partition_;
+      int data_begin_;
+      int data_end_;
       boost::shared_ptr<SufficientStatisticsBase> suf_;
 
       // For interior nodes predictions are made by going left if x <=
@@ -581,9 +793,9 @@ namespace BOOM {
       // statistics for the data that has been assigned to it.
       void populate_sufficient_statistics(SufficientStatisticsBase *suf);
 
-      // Drops the data pointer through the tree.  Each node that it
-      // falls through keeps a copy of the pointer.
-      void populate_data(ResidualRegressionData *data);
+      // Drops the data through the tree.  Each node keeps track of
+      // the range of observations that fall through it.
+      void populate_data(const boost::shared_ptr<ResidualTable> &data);
 
       // Removes the data from the nodes in the tree, and deletes the
       // sufficient statistics objects summarizing the data.
@@ -623,6 +835,10 @@ namespace BOOM {
       std::set<TreeNode *> parents_of_leaves_;
       std::set<TreeNode *> interior_nodes_;
 
+      // The tree's ordering of the observations.  NULL if the tree
+      // has no data.
+      boost::shared_ptr<DataPartition> partition_;
+
       // A function to be called by special constructors (e.g., copy,
       // deserialization).  Iterates through each node in the tree and
       // registers it as needed with leaves_ and parents_of_leaves_.
@@ -663,6 +879,20 @@ namespace BOOM {
     double predict(const VectorView &x) const;
     double predict(const ConstVectorView &x) const;
 
+    // Predict each row of X, placing the result in the corresponding
+    // element of 'out'.  The trees are compiled into a
+    // Bart::FlatForest, which is much faster than calling predict()
+    // one row at a time when X has many rows.  Callers scoring many
+    // matrices against the same trees (or scoring a whole posterior
+    // sample) should build a FlatForest themselves and reuse it.
+    // Args:
+    //   X:  The matrix of predictors, with one row per observation.
+    //   out:  Must have length nrow(X).
+    //   number_of_threads: The number of threads to use.  Zero means
+    //     run in the calling thread.
+    void predict(const Matrix &X, VectorView out,
+                 int number_of_threads = 0) const;
+
     // The number of variables being modeled.  The dimension of 'x'.
     int number_of_variables() const;
 
@@ -687,11 +917,13 @@ namespace BOOM {
 
     // After you're done adding data to the model, call
     // finalize_data() to let the variable summaries know that all
-    // data has been observed.
+    // data has been observed.  See VariableSummary::finalize for the
+    // meaning of the arguments.
     void finalize_data(
         int discrete_distribution_cutoff = 20,
         Bart::ContinuousCutpointStrategy strategy =
-        Bart::UNIFORM_CONTINUOUS);
+        Bart::UNIFORM_CONTINUOUS,
+        int number_of_quantiles = 100);
 
     // Returns the VariableSummary associated with the variable at the
     // given index.
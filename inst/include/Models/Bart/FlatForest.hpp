@@ -0,0 +1,140 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_BART_FLAT_FOREST_HPP_
+#define BOOM_BART_FLAT_FOREST_HPP_
+
+#include <vector>
+#include <LinAlg/Matrix.hpp>
+#include <LinAlg/Vector.hpp>
+#include <LinAlg/VectorView.hpp>
+#include <Models/Bart/Bart.hpp>
+#include <cpputil/ThreadTools.hpp>
+
+namespace BOOM {
+  namespace Bart {
+
+    // A read-only copy of a collection of trees, compiled for fast
+    // prediction.  The pointer-based Tree is convenient for MCMC,
+    // where nodes are constantly being added and removed, but it is
+    // a poor structure for scoring many rows: each prediction chases
+    // pointers through nodes scattered across the heap, and takes a
+    // data-dependent branch at every level.
+    //
+    // A FlatForest stores the nodes of all its trees as parallel
+    // arrays (variable, cutpoint, children, value), with each tree
+    // laid out in breadth-first order.  A node's children are
+    // adjacent in memory, and a leaf is its own child, so every
+    // observation can take exactly 'depth' steps through a tree with
+    // no branching:
+    //
+    //   node = children[2 * node + !(x[variable[node]] <= cutpoint[node])]
+    //
+    // Batch prediction works on blocks of rows, so that the nodes of
+    // a tree stay in cache while the whole block passes through it.
+    // Blocks can be spread across the threads of a worker pool.
+    //
+    // Because a forest may hold any number of trees, it can also
+    // score an entire posterior sample at once: adding each tree from
+    // each of M saved draws with scale 1/M makes predict() return the
+    // posterior mean of the sum of trees.
+    class FlatForest {
+     public:
+      FlatForest();
+
+      // Compile the current trees in 'model'.
+      explicit FlatForest(const BartModelBase &model);
+
+      // The forest owns a thread pool, so it cannot be copied.
+      FlatForest(const FlatForest &rhs) = delete;
+      FlatForest & operator=(const FlatForest &rhs) = delete;
+
+      // Add a tree to the forest.  The tree is copied, so later changes
+      // to 'tree' are not reflected in the forest.
+      // Args:
+      //   tree:  The tree to add.
+      //   scale: A factor multiplying each of the tree's leaf values.
+      void add_tree(const Tree &tree, double scale = 1.0);
+
+      // Add each tree in 'model' to the forest.
+      void add_trees(const BartModelBase &model, double scale = 1.0);
+
+      // Remove all trees from the forest.
+      void clear();
+
+      int number_of_trees() const {return roots_.size();}
+      int number_of_nodes() const {return variable_.size();}
+
+      // Batch prediction uses a pool with this many threads.  With
+      // zero threads (the default) prediction runs in the calling
+      // thread.
+      void set_number_of_threads(int n);
+
+      // Returns the sum of the trees in the forest evaluated at x.
+      double predict(const ConstVectorView &x) const;
+
+      // Evaluate the sum of trees at each row of X.
+      // Args:
+      //   X:  A matrix of predictors, with one row per observation.
+      //   out: On output, out[i] is the sum of trees evaluated at
+      //     X.row(i).  Must have length nrow(X).
+      //
+      // The batch version of predict() uses the forest's thread pool,
+      // so concurrent calls on the same forest are not allowed.
+      void predict(const Matrix &X, VectorView out) const;
+      Vector predict(const Matrix &X) const;
+
+     private:
+      // Add the nodes of the (sub)tree rooted at 'root' in breadth-first
+      // order.  Returns the depth of the deepest leaf.
+      int add_nodes(const TreeNode *root, double scale);
+
+      // Predict rows [begin, end) of X, adding the results to the
+      // corresponding elements of out.
+      void predict_rows(const Matrix &X, int begin, int end,
+                        double *out) const;
+
+      // The variable and cutpoint used to split each node.  Leaves
+      // have variable 0 and an infinite cutpoint, but the values are
+      // irrelevant because a leaf's children are itself.
+      std::vector<int> variable_;
+      std::vector<double> cutpoint_;
+
+      // children_[2 * i] and children_[2 * i + 1] are the positions
+      // of the left and right children of node i.
+      std::vector<int> children_;
+
+      // The (scaled) mean parameter for leaves, and zero for interior
+      // nodes.
+      std::vector<double> value_;
+
+      // The position of the root of each tree, and the depth of its
+      // deepest leaf.
+      std::vector<int> roots_;
+      std::vector<int> depths_;
+
+      // One more than the largest variable index used in a split.
+      int number_of_variables_;
+
+      mutable ThreadWorkerPool pool_;
+    };
+
+  }  // namespace Bart
+}  // namespace BOOM
+
+#endif  // BOOM_BART_FLAT_FOREST_HPP_
@@ -23,6 +23,7 @@
 #include <Models/GaussianModel.hpp>
 #include <Models/PosteriorSamplers/PosteriorSampler.hpp>
 #include <cpputil/math_utils.hpp>
+#include <cpputil/ThreadTools.hpp>
 #include <Samplers/MoveAccounting.hpp>
 
 namespace BOOM {
@@ -200,6 +201,31 @@ namespace BOOM {
     // To be called with a new tree.
     void fill_tree_with_residual_data(Bart::Tree *tree);
 
+    // In binned mode the trees assign observations to nodes using
+    // predictors quantized to each variable's cutpoints (see
+    // Bart::BinnedPredictors), and the discrete cutpoint slice
+    // sampler evaluates candidate cutpoints using per-bin histograms
+    // of sufficient statistics.  Every variable must be discrete, so
+    // the model's data must be finalized with the UNIFORM_DISCRETE or
+    // DISCRETE_QUANTILES strategy.  The residuals are rebuilt at the
+    // start of the next draw.
+    void use_binned_predictors(bool binned = true);
+
+    // Loops over the data belonging to large tree nodes (computing
+    // sufficient statistics, adjusting residuals after drawing leaf
+    // means, and assigning data to a node's children) are split into
+    // shards and run on a pool of worker threads.  Each shard
+    // accumulates partial sufficient statistics, which are combined
+    // when the shards finish.
+    // Args:
+    //   number_of_threads: The number of worker threads.  Zero or one
+    //     means run everything in the calling thread.
+    //   minimum_shard_size: Nodes are only split into shards of at
+    //     least this many observations, so small nodes avoid the cost
+    //     of thread synchronization.
+    void set_number_of_threads(int number_of_threads,
+                               int minimum_shard_size = 10000);
+
     //--------------------------------------------------------------
     // Moves used to implement draw.
 
@@ -234,6 +260,14 @@ namespace BOOM {
     void slice_sample_continuous_cutpoint(Bart::TreeNode *node);
     void slice_sample_discrete_cutpoint(Bart::TreeNode *node);
 
+    // Slice samples the cutpoint of a node whose children are both
+    // leaves.  The log likelihood for each candidate cutpoint is
+    // computed from a histogram of the sufficient statistics for the
+    // node's data, so the data need only be partitioned once, for the
+    // final cutpoint.  Requires binned predictors.
+    void slice_sample_discrete_cutpoint_from_histogram(
+        Bart::TreeNode *node, const Vector &potential_cutpoint_values);
+
 
     // Conditional on the tree structure and sigma, sample the mean
     // parameters at the leaves.
@@ -338,6 +372,14 @@ namespace BOOM {
     // the number of elements in the MoveType enum.
     Vector move_probabilities_;
 
+    // The residual data shared by the trees in model_.
+    boost::shared_ptr<Bart::ResidualTable> residual_table_;
+    bool use_binned_predictors_;
+
+    // The pool used for sharded loops over the residual data.
+    ThreadWorkerPool pool_;
+    int minimum_shard_size_;
+
   };
 
 }
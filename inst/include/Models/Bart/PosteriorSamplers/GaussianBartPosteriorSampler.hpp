@@ -71,6 +71,10 @@ namespace BOOM {
       virtual void update(const GaussianResidualRegressionData &data) {
         suf_.update_raw(data.residual());
       }
+      void combine(const SufficientStatisticsBase &rhs) override {
+        suf_.combine(
+            dynamic_cast<const GaussianBartSufficientStatistics &>(rhs).suf_);
+      }
       double n() const {return suf_.n();}
       double ybar() const {return suf_.ybar();}
       double sum() const {return suf_.sum();}
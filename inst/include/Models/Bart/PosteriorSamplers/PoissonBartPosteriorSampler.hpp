@@ -176,6 +176,7 @@ namespace BOOM {
       // contributions to the sufficient statistics.
       void update(const ResidualRegressionData &data) override;
       virtual void update(const PoissonResidualRegressionData &data);
+      void combine(const SufficientStatisticsBase &rhs) override;
 
       double sum_of_weights() const {return sum_of_weights_;}
       double weighted_sum_of_residuals() const {
@@ -71,6 +71,7 @@ namespace BOOM {
       void clear() override;
       void update(const ResidualRegressionData &abstract_data) override;
       virtual void update(const ProbitResidualData &data);
+      void combine(const SufficientStatisticsBase &rhs) override;
       int sample_size()const;
       double sum()const;
      private:
@@ -41,7 +41,7 @@ namespace BOOM{
   public:
     RefCounted rc_;
     void up_count(){rc_.up_count();}
-    void down_count(){rc_.down_count();}
+    unsigned int down_count(){return rc_.down_count();}
     unsigned int ref_count(){return rc_.ref_count();}
 
     enum missing_status{
@@ -25,6 +25,8 @@
 #include <Models/Policies/CompositeParamPolicy.hpp>
 #include <Models/Policies/MixtureDataPolicy.hpp>
 #include <Models/MultinomialModel.hpp>
+#include <cpputil/ThreadTools.hpp>
+#include <distributions/rng.hpp>
 
 namespace BOOM{
 
@@ -49,6 +51,19 @@ namespace BOOM{
 
     void clear_component_data();
     void impute_latent_data(RNG &rng) override;
+
+    // Impute latent data using n worker threads.  Each worker gets its
+    // own random number stream, split from seeding_rng, a contiguous
+    // block of observations, and its own copies of the mixture
+    // components.  The threads are created here, and reused by each
+    // call to impute_latent_data().  The workers evaluate densities
+    // and draw the latent classes.  The data are then added to the
+    // mixture components serially, so the components end up with the
+    // same data, in the same order, as with serial imputation.
+    // Setting n = 0 returns to serial imputation.
+    void set_nthreads(int n, RNG &seeding_rng = GlobalRng::rng);
+    int nthreads() const;
+
     void class_membership_probability(Ptr<Data>, Vector &ans)const;
     double last_loglike()const;
 
@@ -92,6 +107,25 @@ namespace BOOM{
     double last_loglike_;
     Matrix class_membership_probabilities_;
     std::vector<int> which_mixture_component_;
+
+    // Per-worker state for threaded imputation.  None of it is copied
+    // by the copy constructor.
+    std::vector<std::vector<Ptr<MixtureComponent> > > worker_components_;
+    std::vector<RNG> worker_rngs_;
+    std::vector<double> worker_loglike_;
+    ThreadWorkerPool pool_;
+
+    // Fill rows [begin, end) of class_membership_probabilities_ using
+    // the densities of 'components', and draw the latent class of each
+    // observation in the range.  If add_data is true, each observation
+    // is also added to the corresponding element of 'components'.
+    // Returns the log likelihood of the observations in the range.
+    double impute_latent_data_block(
+        int begin, int end,
+        const std::vector<Ptr<MixtureComponent> > &components,
+        RNG &rng,
+        bool add_data = true);
+    void impute_latent_data_with_threads();
   };
   //----------------------------------------------------------------------
   template <class FwdIt>
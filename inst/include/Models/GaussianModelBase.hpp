@@ -89,6 +89,11 @@ namespace BOOM{
     virtual void set_sigsq(double sigsq)=0;
     double pdf(Ptr<Data> dp, bool logscale)const override;
     double pdf(const Data * dp, bool logscale)const override;
+    using MixtureComponent::batch_logp;
+    void batch_logp(const std::vector<Ptr<Data> > &data,
+                    int begin,
+                    int end,
+                    VectorView ans) const override;
     double Logp(double x, double &g, double &h, uint nd)const override;
     double Logp(const Vector & x, Vector &g, Matrix &h, uint nd)const;
 
@@ -78,6 +78,13 @@ namespace BOOM{
 
     virtual SpdMatrix xtx()const;
 
+    // In columnar data for this model, y holds the number of
+    // successes and the weights hold the number of trials.  If there
+    // are no weights each observation is a single trial.  Columnar
+    // data are used by BinomialLogitAuxmixSampler.
+    void set_columnar_data(const Ptr<ColumnarRegressionData> &data) override;
+    void clear_data() override;
+
     // see comments in LogisticRegressionModel
     void set_nonevent_sampling_prob(double alpha);
     double log_alpha()const;
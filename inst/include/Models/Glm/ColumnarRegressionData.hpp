@@ -0,0 +1,125 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_COLUMNAR_REGRESSION_DATA_HPP_
+#define BOOM_COLUMNAR_REGRESSION_DATA_HPP_
+
+#include <utility>
+#include <vector>
+#include <LinAlg/Matrix.hpp>
+#include <LinAlg/SpdMatrix.hpp>
+#include <LinAlg/Vector.hpp>
+#include <LinAlg/VectorView.hpp>
+#include <cpputil/RefCounted.hpp>
+
+namespace BOOM {
+
+  // A regression data set stored by column.  The predictors are a
+  // single column-major Matrix, and the responses and weights are
+  // Vectors.  This is an alternative to a std::vector of
+  // Ptr<RegressionData>, which puts each observation (and its
+  // predictor Vector) in its own heap allocation.  For large data
+  // sets that overhead can exceed the size of the data itself.
+  //
+  // A model that supports columnar data keeps a Ptr to it (see
+  // GlmModel::set_columnar_data) instead of a vector of data points.
+  // Its posterior samplers and sufficient statistics then work
+  // through the data a block of rows at a time, so the work is done
+  // by level 2 and level 3 BLAS.
+  //
+  // The meaning of the weights depends on the model:
+  //   - precision weights for a Gaussian regression
+  //   - the number of trials for a binomial regression
+  //   - the exposure for a Poisson regression
+  // If no weights are given, each weight is 1.
+  //
+  // The data cannot be changed after construction, so one data set
+  // can be shared by several models (e.g. parallel MCMC chains).
+  class ColumnarRegressionData : private RefCounted {
+   public:
+    // The number of rows processed at a time by the block operations.
+    static const int kBlockSize = 256;
+
+    // Args:
+    //   X: The design matrix.  Include a column of 1's if an
+    //     intercept is desired.
+    //   y: The response vector.  Its size must match nrow(X).
+    //   weights: Either empty, or of the same size as y.
+    ColumnarRegressionData(const Matrix &X, const Vector &y);
+    ColumnarRegressionData(const Matrix &X,
+                           const Vector &y,
+                           const Vector &weights);
+
+    int nobs() const {return y_.size();}
+    int xdim() const {return X_.ncol();}
+
+    const Matrix &X() const {return X_;}
+    const Vector &y() const {return y_;}
+    double y(int i) const {return y_[i];}
+
+    // The predictors for observation i.  This is a strided view of
+    // row i of X.
+    ConstVectorView x(int i) const {return X_.row(i);}
+
+    bool has_weights() const {return !weights_.empty();}
+    double weight(int i) const {
+      return weights_.empty() ? 1.0 : weights_[i];
+    }
+    const Vector &weights() const {return weights_;}
+
+    // Sets eta[i] = x(first + i).dot(beta) for each element of eta.
+    void predict(const Vector &beta, int first, VectorView eta) const;
+
+    // Adds the weighted cross products of a block of rows to the
+    // upper triangle of xtwx and to xtwy:
+    //
+    //   xtwx += sum_i weights[i] * x_i * x_i^T
+    //   xtwy += sum_i weighted_y[i] * x_i
+    //
+    // where i indexes rows first, ..., first + weighted_y.size() - 1.
+    // If 'weights' is empty every weight is 1.  Otherwise the weights
+    // must be non-negative.  The lower triangle of xtwx is not
+    // touched, so the caller must reflect() it before use.
+    void add_cross_products(int first,
+                            const ConstVectorView &weights,
+                            const ConstVectorView &weighted_y,
+                            SpdMatrix &xtwx,
+                            Vector &xtwy) const;
+
+    // Split the rows into 'number_of_ranges' contiguous ranges
+    // [first, second) of nearly equal size, for processing by
+    // separate threads.  Range boundaries fall on multiples of
+    // kBlockSize.  Empty ranges are omitted.
+    std::vector<std::pair<int, int> > row_ranges(int number_of_ranges) const;
+
+    friend void intrusive_ptr_add_ref(ColumnarRegressionData *d) {
+      d->up_count();
+    }
+    friend void intrusive_ptr_release(ColumnarRegressionData *d) {
+      if (d->down_count() == 0) delete d;
+    }
+
+   private:
+    Matrix X_;
+    Vector y_;
+    Vector weights_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_COLUMNAR_REGRESSION_DATA_HPP_
@@ -22,6 +22,7 @@
 #include <Models/ParamTypes.hpp>
 #include <Models/ModelTypes.hpp>
 #include <Models/Glm/GlmCoefs.hpp>
+#include <Models/Glm/ColumnarRegressionData.hpp>
 #include <LinAlg/Selector.hpp>
 #include <LinAlg/VectorView.hpp>
 
@@ -183,6 +184,28 @@ namespace BOOM{
     virtual double predict(const Vector &x) const;
     virtual double predict(const VectorView &x) const;
     virtual double predict(const ConstVectorView &x) const;
+
+    //---- columnar data ----
+    // Replaces the model's data with a ColumnarRegressionData.  Any
+    // data points held in the usual way are cleared.  Models that can
+    // use columnar data override this function, and the default
+    // implementation reports an error.  Overrides should call
+    // store_columnar_data().
+    virtual void set_columnar_data(const Ptr<ColumnarRegressionData> &data);
+
+    // The columnar data assigned by set_columnar_data, or nullptr if
+    // the model's data are held as individual data points.
+    const Ptr<ColumnarRegressionData> &columnar_data() const {
+      return columnar_data_;
+    }
+
+   protected:
+    // Checks the dimension of 'data' and stores it.  Passing nullptr
+    // drops any columnar data.
+    void store_columnar_data(const Ptr<ColumnarRegressionData> &data);
+
+   private:
+    Ptr<ColumnarRegressionData> columnar_data_;
   };
 
   //============================================================
@@ -87,6 +87,13 @@ namespace BOOM {
 
     double pdf(const Data *, bool logscale)const override;
     double logp(const PoissonRegressionData &data)const;
+
+    // In columnar data for this model, y holds the event counts and
+    // the weights hold the exposures.  If there are no weights each
+    // exposure is 1.  Columnar data are used by
+    // PoissonRegressionAuxMixSampler.
+    void set_columnar_data(const Ptr<ColumnarRegressionData> &data) override;
+    void clear_data() override;
   };
 
 } // namespace BOOM
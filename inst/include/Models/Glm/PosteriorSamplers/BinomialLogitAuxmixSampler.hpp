@@ -21,10 +21,12 @@
 
 #include <Models/PosteriorSamplers/PosteriorSampler.hpp>
 #include <Models/PosteriorSamplers/Imputer.hpp>
+#include <Models/Glm/PosteriorSamplers/ColumnarLatentDataImputer.hpp>
 
 #include <Models/Glm/BinomialLogitModel.hpp>
 #include <Models/Glm/PosteriorSamplers/BinomialLogitDataImputer.hpp>
 #include <Models/MvnBase.hpp>
+#include <LinAlg/OuterProductBuffer.hpp>
 
 namespace BOOM {
 
@@ -56,12 +58,21 @@ namespace BOOM {
       void update(const Vector &x,
                   double weighted_value,
                   double weight);
+      // Adds a block of rows from 'data', starting with row 'first'.
+      // Row first + i contributes as if by update(x, weighted_value[i],
+      // weight[i]).
+      void add_columnar_data(const ColumnarRegressionData &data,
+                             int first,
+                             const ConstVectorView &weighted_value,
+                             const ConstVectorView &weight);
       void clear();
       void combine(const SufficientStatistics &rhs);
      private:
       mutable SpdMatrix xtx_;
       Vector xty_;
       mutable bool sym_;
+      // Observations passed to update() are added to xtx_ in blocks.
+      mutable OuterProductBuffer xtx_buffer_;
     };
 
     // By default, this class updates its own latent data through a
@@ -96,6 +107,21 @@ namespace BOOM {
     const SufficientStatistics & suf() const {return suf_;}
 
    private:
+    // Imputes the latent data when the model holds columnar data.
+    // The rows are split into one contiguous shard per worker.  Each
+    // shard is imputed in its own thread, with its own sufficient
+    // statistics and random number stream, and the partial sufficient
+    // statistics are combined into suf_ at the end.
+    void impute_columnar_latent_data();
+
+    // Impute the latent data for rows [begin, end) of the model's
+    // columnar data, adding the results to *suf.  The linear
+    // predictors and the sufficient statistics are computed a block
+    // of rows at a time.
+    void impute_columnar_rows(int begin, int end,
+                              SufficientStatistics *suf,
+                              RNG &rng) const;
+
     BinomialLogitModel *model_;
     Ptr<MvnBase> prior_;
     SufficientStatistics suf_;
@@ -107,6 +133,9 @@ namespace BOOM {
     // A flag that can be use to turn off data augmentation.  If this
     // flag is set then impute_latent_data is a no-op.
     bool latent_data_fixed_;
+
+    // Shards the imputation of columnar data across worker threads.
+    ColumnarLatentDataImputer<SufficientStatistics> columnar_imputer_;
   };
 
   //======================================================================
@@ -202,6 +202,40 @@ namespace BOOM {
         double eta) const;
   };
 
+  //=======================================================================
+  // Polya-Gamma data augmentation (Polson, Scott, and Windle 2013).
+  // A single latent variable omega ~ PG(number_of_trials, log_odds)
+  // is imputed for each observation, however many trials it has.
+  // Conditional on omega, the binomial likelihood is exactly a
+  // Gaussian likelihood with precision omega for the "observation"
+  // (number_of_successes - number_of_trials / 2) / omega.  No mixture
+  // approximation is involved.
+  class BinomialLogitPolyaGammaDataImputer
+      : public BinomialLogitDataImputer {
+   public:
+    // Args:
+    //   clt_threshold: The smallest number_of_trials for which omega
+    //     is drawn from a normal approximation to the Polya-Gamma
+    //     distribution, rather than exactly.  The cost of an exact
+    //     draw grows linearly with number_of_trials.
+    BinomialLogitPolyaGammaDataImputer(int clt_threshold = 10);
+
+    // Returns:
+    //   The first element of the returned pair is the information
+    //   weighted sum, number_of_successes - number_of_trials / 2.  The
+    //   second is the information, omega.  Both are zero if
+    //   number_of_trials is zero.
+    std::pair<double, double> impute(RNG &rng,
+                                     double number_of_trials,
+                                     double number_of_successes,
+                                     double log_odds) const override;
+
+    int clt_threshold() const override;
+
+   private:
+    int clt_threshold_;
+  };
+
 }
 
 #endif  // BOOM_BINOMIAL_LOGIT_DATA_IMPUTER_HPP_
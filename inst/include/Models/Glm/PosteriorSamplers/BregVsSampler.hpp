@@ -26,6 +26,7 @@
 #include <Models/MvnGivenSigma.hpp>
 #include <Models/GammaModel.hpp>
 #include <Models/ChisqModel.hpp>
+#include <Models/Glm/PosteriorSamplers/IncrementalSlabPosterior.hpp>
 
 namespace BOOM{
   struct ZellnerPriorParameters {
@@ -55,9 +56,10 @@ namespace BOOM{
   class BregVsSampler : public PosteriorSampler{
    public:
 
-    // Omega inverse is 'prior_nobs' * XTX/n. The intercept term in
-    // 'b' is ybar (sample mean of the responses).  The slope terms in
-    // b are all zero.  The prior for 1/sigsq is
+    // Omega inverse is 'prior_nobs' * XTX/n, or its diagonal if the
+    // model's sufficient statistics are a SparseRegSuf. The intercept
+    // term in 'b' is ybar (sample mean of the responses).  The slope
+    // terms in b are all zero.  The prior for 1/sigsq is
     // Gamma(prior_nobs/2, prior_ss/2), with
     // prior_ss = prior_nobs*sigma_guess^2, and
     // sigma_guess = sample_variance*(1-expected_rsq)
@@ -70,6 +72,8 @@ namespace BOOM{
 
     // Omega inverse is kappa*[(1-alpha)*XTX/n + alpha*(XTX/n)].
     // kappa is 'prior_beta_nobs', and alpha is 'diagonal_shrinkage'.
+    // If the model's sufficient statistics are a SparseRegSuf then
+    // alpha is taken to be 1, so Omega inverse is diagonal.
     // The prior on 1/sigsq is Gamma(prior_sigma_nobs/2, priors_ss/2)
     // with prior_ss = prior_sigma_guess^2 * prior_sigma_nobs.
     // b = [ybar, 0, 0, ...]
@@ -202,12 +206,38 @@ namespace BOOM{
 
     mutable Vector beta_tilde_;      // this is work space for computing
     mutable SpdMatrix iV_tilde_;        // posterior model probs
+    mutable Matrix iV_tilde_chol_;      // lower Cholesky factor of iV_tilde_
     mutable double DF_, SS_;
 
     GenericGaussianVarianceSampler sigsq_sampler_;
 
+    // Cholesky factors of the prior and posterior precision for the
+    // included coefficients.  These are refactored at the start of
+    // each call to draw_model_indicators, and then updated as
+    // individual indicators are flipped.
+    IncrementalSlabPosterior slab_posterior_;
+
+    // Workspace holding the diagonal of Omega^{-1} when the prior is
+    // an IndependentMvnModelGivenScalarSigma.  slab_posterior_ keeps
+    // a pointer to it.
+    Vector unscaled_prior_precision_diagonal_;
+
+    // The rows and columns of Omega^{-1} for the included variables.
+    // A diagonal prior is read without forming the p x p matrix.
+    SpdMatrix unscaled_prior_precision(const Selector &g) const;
+
     double set_reg_post_params(const Selector &g, bool do_ldoi)const;
 
+    // Equivalent to log_model_prob(g), but computed from
+    // slab_posterior_, which must be synchronized with g.
+    double incremental_log_model_prob(const Selector &g) const;
+
+    // Equivalent to mcmc_one_flip, but keeps slab_posterior_
+    // synchronized with inclusion_indicators.
+    double incremental_mcmc_one_flip(Selector &inclusion_indicators,
+                                     uint which_var,
+                                     double current_logp);
+
     void draw_beta();
     void draw_model_indicators();
     void draw_sigma();
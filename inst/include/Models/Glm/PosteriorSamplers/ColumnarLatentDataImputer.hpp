@@ -0,0 +1,121 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_COLUMNAR_LATENT_DATA_IMPUTER_HPP_
+#define BOOM_COLUMNAR_LATENT_DATA_IMPUTER_HPP_
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <Models/Glm/ColumnarRegressionData.hpp>
+#include <distributions/rng.hpp>
+#include <cpputil/ThreadTools.hpp>
+
+namespace BOOM {
+
+  // Imputes latent data for a ColumnarRegressionData object in
+  // parallel.  The rows are split into one contiguous shard per
+  // worker.  Each shard is imputed with its own sufficient statistics
+  // and random number stream, and the partial sufficient statistics
+  // are combined at the end.
+  //
+  // The first call to impute() runs the shards one after the other in
+  // the calling thread, for the same reason ParallelLatentDataImputer
+  // does: some imputers (e.g. PoissonDataImputer) fill shared tables
+  // the first time they see the data.  Because each shard keeps its
+  // own RNG, the serial pass draws exactly what a threaded pass would.
+  //
+  // Type requirements:
+  //   SUFFICIENT_STATISTICS: Must be copyable, and provide clear() and
+  //     combine(const SUFFICIENT_STATISTICS &).
+  template <class SUFFICIENT_STATISTICS>
+  class ColumnarLatentDataImputer {
+   public:
+    // Imputes the latent data for rows [begin, end) of the data,
+    // adding the results to *suf.
+    typedef std::function<void(int begin,
+                               int end,
+                               SUFFICIENT_STATISTICS *suf,
+                               RNG &rng)> RowImputer;
+
+    ColumnarLatentDataImputer() : first_pass_(true) {}
+
+    // Args:
+    //   data:  The data to be augmented.
+    //   number_of_shards: The number of shards (and threads) to use.
+    //     If this is 1 or less all rows are imputed in the calling
+    //     thread using 'rng'.
+    //   suf: The complete data sufficient statistics to be filled.
+    //     It is cleared on entry, and its cleared value is copied to
+    //     create the per-shard sufficient statistics.
+    //   rng: Used directly when there is a single shard.  Otherwise
+    //     it seeds one RNG per shard whenever the number of shards
+    //     changes.
+    //   impute_rows:  Imputes the latent data for a range of rows.
+    void impute(const ColumnarRegressionData &data,
+                int number_of_shards,
+                SUFFICIENT_STATISTICS *suf,
+                RNG &rng,
+                const RowImputer &impute_rows) {
+      suf->clear();
+      if (number_of_shards <= 1) {
+        impute_rows(0, data.nobs(), suf, rng);
+        return;
+      }
+      if (shard_sufs_.size() != number_of_shards) {
+        shard_sufs_.assign(number_of_shards, *suf);
+        shard_rngs_.clear();
+        for (int i = 0; i < number_of_shards; ++i) {
+          shard_rngs_.push_back(split_rng(rng));
+        }
+        pool_.set_number_of_threads(number_of_shards);
+      }
+      std::vector<std::pair<int, int> > ranges =
+          data.row_ranges(number_of_shards);
+      std::vector<std::function<void()>> tasks;
+      for (int i = 0; i < ranges.size(); ++i) {
+        std::pair<int, int> range = ranges[i];
+        SUFFICIENT_STATISTICS *shard_suf = &shard_sufs_[i];
+        RNG *shard_rng = &shard_rngs_[i];
+        tasks.push_back([&impute_rows, range, shard_suf, shard_rng]() {
+            shard_suf->clear();
+            impute_rows(range.first, range.second, shard_suf, *shard_rng);
+          });
+      }
+      if (first_pass_) {
+        for (int i = 0; i < tasks.size(); ++i) tasks[i]();
+        first_pass_ = false;
+      } else {
+        pool_.run(tasks);
+      }
+      for (int i = 0; i < ranges.size(); ++i) {
+        suf->combine(shard_sufs_[i]);
+      }
+    }
+
+   private:
+    std::vector<SUFFICIENT_STATISTICS> shard_sufs_;
+    std::vector<RNG> shard_rngs_;
+    ThreadWorkerPool pool_;
+    bool first_pass_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_COLUMNAR_LATENT_DATA_IMPUTER_HPP_
@@ -0,0 +1,212 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_GLM_INCREMENTAL_SLAB_POSTERIOR_HPP_
+#define BOOM_GLM_INCREMENTAL_SLAB_POSTERIOR_HPP_
+
+#include <vector>
+#include <LinAlg/Matrix.hpp>
+#include <LinAlg/SpdMatrix.hpp>
+#include <LinAlg/Vector.hpp>
+#include <LinAlg/Selector.hpp>
+#include <LinAlg/SparseCrossProductMatrix.hpp>
+
+namespace BOOM {
+
+  // Spike and slab samplers for Gaussian (or conditionally Gaussian)
+  // regressions evaluate the marginal posterior probability of a
+  // model once for each inclusion indicator they consider flipping.
+  // Each evaluation needs the Cholesky factors of the prior and
+  // posterior precision matrices for the included coefficients.
+  // Computing these from scratch costs O(k^3) per flip, where k is
+  // the number of included variables.
+  //
+  // This class keeps the two Cholesky factors for the current set of
+  // included variables, and updates them in O(k^2) when a single
+  // variable is added or removed.  With slab prior N(mu, Omega) and
+  // data contributing X'WX and X'Wy, the quantities of interest (for
+  // the included subset g) are
+  //
+  //   prior precision:      Omega_g
+  //   posterior precision:  V_g = Omega_g + data_weight * (X'WX)_g
+  //   prior_mahalanobis:    mu_g' Omega_g mu_g
+  //   posterior_mahalanobis: b_g' V_g^{-1} b_g,
+  //     where b_g = data_weight * (X'Wy)_g + Omega_g * mu_g.
+  //
+  // The factors are stored in the order in which variables were
+  // added, not in the order of the Selector.  None of the quantities
+  // above depend on the ordering.
+  //
+  // Rounding error accumulates as the factors are updated, so
+  // callers should call reset() at the start of each MCMC sweep.
+  class IncrementalSlabPosterior {
+   public:
+    IncrementalSlabPosterior();
+
+    // Refactor from scratch.
+    // Args:
+    //   inclusion_indicators:  The initial set of included variables.
+    //   prior_precision: The (full) precision matrix of the slab
+    //     prior.  This object keeps a pointer to it, so it must
+    //     remain valid until the next call to reset().
+    //   prior_precision_scale: A multiplier for prior_precision.
+    //     This is for models where the prior precision is expressed
+    //     relative to a residual variance.
+    //   prior_mean: The (full) mean vector of the slab prior.  This
+    //     object keeps a pointer to it.
+    //   xtx:  The (full) cross product matrix X'WX.  A copy is made.
+    //   xty:  The (full) cross product vector X'Wy.  A copy is made.
+    //   data_weight: A multiplier for xtx and xty (typically
+    //     1/sigsq, or 1).
+    //
+    // Returns:
+    //   true if both the prior and posterior precision matrices for
+    //   the included variables are positive definite.
+    bool reset(const Selector &inclusion_indicators,
+               const SpdMatrix &prior_precision,
+               double prior_precision_scale,
+               const Vector &prior_mean,
+               const SpdMatrix &xtx,
+               const Vector &xty,
+               double data_weight);
+
+    // As above, but with X'WX held in a sparse matrix.  This object
+    // keeps a pointer to 'xtx' rather than a copy, so it must remain
+    // valid (and unchanged) until the next call to reset().  Elements
+    // of xtx are looked up as variables are added, so the cost of a
+    // flip does not depend on the total number of variables.
+    bool reset(const Selector &inclusion_indicators,
+               const SpdMatrix &prior_precision,
+               double prior_precision_scale,
+               const Vector &prior_mean,
+               const SparseCrossProductMatrix &xtx,
+               const Vector &xty,
+               double data_weight);
+
+    // As above, but with a slab prior whose precision matrix is
+    // diagonal.  'prior_precision_diagonal' holds the diagonal
+    // elements.  This object keeps a pointer to it.  Together with a
+    // sparse xtx this avoids any storage proportional to the square
+    // of the number of potential variables.
+    bool reset(const Selector &inclusion_indicators,
+               const Vector &prior_precision_diagonal,
+               double prior_precision_scale,
+               const Vector &prior_mean,
+               const SparseCrossProductMatrix &xtx,
+               const Vector &xty,
+               double data_weight);
+
+    // Add variable i if it is excluded, otherwise drop it.
+    // Returns:
+    //   true if the flip succeeded.  Adding a variable fails if the
+    //   resulting prior or posterior precision matrix would not be
+    //   positive definite.  If the flip fails the state is unchanged.
+    bool flip(int i);
+    bool add(int i);
+    void drop(int i);
+
+    // Return variable i to the given inclusion state, e.g. after a
+    // rejected MCMC proposal to flip it.  Restoring a dropped
+    // variable can only fail through accumulated rounding error, in
+    // which case the factors are recomputed from scratch.
+    void restore(int i, bool included);
+
+    bool inc(int i) const {return factor_position_[i] >= 0;}
+    int nvars() const {return positions_.size();}
+
+    // Log determinants of the prior and posterior precision matrices
+    // for the included variables.
+    double prior_logdet() const;
+    double posterior_logdet() const;
+
+    double prior_mahalanobis() const;
+    double posterior_mahalanobis() const;
+
+   private:
+    double prior_precision(int i, int j) const {
+      if (prior_precision_diagonal_) {
+        return i == j ? prior_precision_scale_ * (*prior_precision_diagonal_)[i]
+            : 0.0;
+      }
+      return prior_precision_scale_ * (*prior_precision_)(i, j);
+    }
+    double xtx(int i, int j) const {
+      return sparse_xtx_ ? (*sparse_xtx_)(i, j) : xtx_(i, j);
+    }
+    double posterior_precision(int i, int j) const {
+      return prior_precision(i, j) + data_weight_ * xtx(i, j);
+    }
+
+    // The parts of reset() that do not depend on how xtx or the prior
+    // precision are stored.  The caller must have set
+    // prior_precision_ or prior_precision_diagonal_.
+    bool reset_factors(const Selector &inclusion_indicators,
+                       int prior_dim,
+                       double prior_precision_scale,
+                       const Vector &prior_mean,
+                       const Vector &xty,
+                       double data_weight);
+
+    // Make room in the factors and workspace for 'size' variables.
+    void ensure_capacity(int size);
+
+    // Append one row to the Cholesky factor L, whose first k rows
+    // and columns are occupied.  'column' holds the new row of the
+    // original matrix.  Returns false if the extended matrix is not
+    // positive definite, in which case L is unchanged.
+    static bool append_row(Matrix &L, int k, Vector &column);
+
+    // Remove row and column m from the k x k Cholesky factor L.
+    void remove_row(Matrix &L, int k, int m);
+
+    void ensure_mahalanobis() const;
+
+    const SpdMatrix *prior_precision_;
+    const Vector *prior_precision_diagonal_;
+    double prior_precision_scale_;
+    const Vector *prior_mean_;
+    SpdMatrix xtx_;
+    const SparseCrossProductMatrix *sparse_xtx_;
+    Vector xty_;
+    double data_weight_;
+
+    // positions_[r] is the variable in row r of the factors.
+    // factor_position_[i] is the row of variable i in the factors,
+    // or -1 if variable i is excluded.
+    std::vector<int> positions_;
+    std::vector<int> factor_position_;
+
+    // The leading nvars() rows and columns hold the lower Cholesky
+    // factors.  Their capacity grows geometrically with the number of
+    // included variables, so storage is proportional to the square of
+    // the largest model visited, not of the number of potential
+    // variables, and most updates do not allocate.
+    Matrix prior_chol_;
+    Matrix posterior_chol_;
+
+    // Workspace.
+    mutable Vector workspace_;
+    mutable Vector b_;
+    mutable bool mahalanobis_current_;
+    mutable double prior_mahalanobis_;
+    mutable double posterior_mahalanobis_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_GLM_INCREMENTAL_SLAB_POSTERIOR_HPP_
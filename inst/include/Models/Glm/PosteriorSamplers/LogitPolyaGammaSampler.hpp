@@ -0,0 +1,83 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_LOGIT_POLYA_GAMMA_SAMPLER_HPP_
+#define BOOM_LOGIT_POLYA_GAMMA_SAMPLER_HPP_
+
+#include <Models/PosteriorSamplers/PosteriorSampler.hpp>
+#include <Models/PosteriorSamplers/Imputer.hpp>
+#include <Models/Glm/LogisticRegressionModel.hpp>
+#include <Models/Glm/WeightedRegressionModel.hpp>
+#include <Models/MvnBase.hpp>
+
+namespace BOOM {
+
+  // Imputes the Polya-Gamma latent variable omega ~ PG(1, x'beta) for
+  // one binary observation, and adds the pseudo-observation
+  // (y - 1/2) / omega, with weight omega, to a WeightedRegSuf.
+  class LogitPolyaGammaRegressionDataImputer
+      : public LatentDataImputer<BinaryRegressionData, WeightedRegSuf> {
+   public:
+    explicit LogitPolyaGammaRegressionDataImputer(
+        const GlmCoefs *coefficients);
+
+    void impute_latent_data(const BinaryRegressionData &observation,
+                            WeightedRegSuf *complete_data_suf,
+                            RNG &rng) const override;
+
+   private:
+    const GlmCoefs *coefficients_;
+  };
+
+  //======================================================================
+  // A posterior sampler for logistic regression using Polya-Gamma data
+  // augmentation.  This is an exact alternative to LogitSampler (which
+  // imputes a latent logistic variable and a mixing weight for each
+  // observation), and can impute the latent data in several threads.
+  class LogitPolyaGammaSampler : public PosteriorSampler {
+   public:
+    LogitPolyaGammaSampler(LogisticRegressionModel *model,
+                           Ptr<MvnBase> prior,
+                           RNG &seeding_rng = GlobalRng::rng);
+
+    double logpri() const override;
+    void draw() override;
+
+    void impute_latent_data();
+    void draw_params();
+
+    // Use 'n' workers, each in its own thread, to impute the latent
+    // data.  n must be at least 1.
+    void set_number_of_workers(int n);
+
+    const WeightedRegSuf &complete_data_sufficient_statistics() const {
+      return suf_;
+    }
+
+   private:
+    LogisticRegressionModel *model_;
+    Ptr<MvnBase> prior_;
+    WeightedRegSuf suf_;
+    ParallelLatentDataImputer<BinaryRegressionData,
+                              WeightedRegSuf,
+                              LogisticRegressionModel> parallel_data_imputer_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_LOGIT_POLYA_GAMMA_SAMPLER_HPP_
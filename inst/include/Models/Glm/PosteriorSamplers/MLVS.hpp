@@ -23,6 +23,7 @@
 #include <Models/PosteriorSamplers/PosteriorSampler.hpp>
 #include <Models/Glm/VariableSelectionPrior.hpp>
 #include <Models/Glm/PosteriorSamplers/MLVS_data_imputer.hpp>
+#include <Models/Glm/PosteriorSamplers/IncrementalSlabPosterior.hpp>
 #include <Models/PosteriorSamplers/Imputer.hpp>
 
 namespace BOOM{
@@ -115,10 +116,14 @@ namespace BOOM{
     bool select_;
     uint max_nflips_;
 
-    SpdMatrix Ominv;
-    SpdMatrix iV_tilde_;
+    // Cholesky factors of the prior and posterior precision for the
+    // included coefficients, updated as inclusion indicators flip.
+    IncrementalSlabPosterior slab_posterior_;
     virtual void draw_inclusion_vector();
-    double log_model_prob(const Selector &inc);
+
+    // The log of the marginal posterior probability of model 'inc',
+    // which must match the included set in slab_posterior_.
+    double log_model_prob(const Selector &inc) const;
   };
 
 }
@@ -23,6 +23,7 @@
 
 #include <Models/PosteriorSamplers/PosteriorSampler.hpp>
 #include <Models/PosteriorSamplers/Imputer.hpp>
+#include <Models/Glm/PosteriorSamplers/ColumnarLatentDataImputer.hpp>
 #include <Models/Glm/PosteriorSamplers/PoissonDataImputer.hpp>
 #include <Models/Glm/PoissonRegressionModel.hpp>
 #include <Models/Glm/WeightedRegressionModel.hpp>
@@ -105,6 +106,21 @@ namespace BOOM{
         const Vector &x);
 
    private:
+    // Imputes the latent data when the model holds columnar data.
+    // The rows are split into one contiguous shard per worker, each
+    // imputed in its own thread with its own sufficient statistics
+    // and random number stream.  The partial sufficient statistics
+    // are combined into complete_data_suf_ at the end.
+    void impute_columnar_latent_data();
+
+    // Impute the latent data for rows [begin, end) of the model's
+    // columnar data, adding the results to *suf.  The linear
+    // predictors and the sufficient statistics are computed a block
+    // of rows at a time.
+    void impute_columnar_rows(int begin, int end,
+                              WeightedRegSuf *suf,
+                              RNG &rng) const;
+
     PoissonRegressionModel *model_;
     Ptr<MvnBase> prior_;
     WeightedRegSuf complete_data_suf_;
@@ -112,6 +128,9 @@ namespace BOOM{
                               WeightedRegSuf,
                               PoissonRegressionModel> parallel_data_imputer_;
     bool latent_data_fixed_;
+
+    // Shards the imputation of columnar data across worker threads.
+    ColumnarLatentDataImputer<WeightedRegSuf> columnar_imputer_;
   };
 
 }  // namespace BOOM
@@ -0,0 +1,90 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_REGRESSION_SPIKE_SLAB_SAMPLER_HPP_
+#define BOOM_REGRESSION_SPIKE_SLAB_SAMPLER_HPP_
+
+#include <Models/GammaModel.hpp>
+#include <Models/Glm/PosteriorSamplers/SpikeSlabSampler.hpp>
+#include <Models/Glm/RegressionModel.hpp>
+#include <Models/Glm/VariableSelectionPrior.hpp>
+#include <Models/Glm/WeightedRegressionModel.hpp>
+#include <Models/MvnBase.hpp>
+#include <Models/PosteriorSamplers/GenericGaussianVarianceSampler.hpp>
+#include <Models/PosteriorSamplers/PosteriorSampler.hpp>
+
+namespace BOOM {
+
+  // A spike and slab sampler for a Gaussian RegressionModel whose
+  // slab prior does not depend on sigma:
+  //
+  //   beta | gamma ~ N(b_gamma, V_gamma)
+  //      1/sigsq   ~ Gamma
+  //
+  // The inclusion indicators and coefficients are drawn given sigsq,
+  // and sigsq is drawn from its full conditional.  BregVsSampler
+  // integrates sigsq out instead, but requires the prior variance to
+  // be proportional to sigsq.
+  //
+  // If the model's sufficient statistics are a SparseRegSuf then X'X
+  // is read element by element, and the p x p matrix is never
+  // formed.  Pair it with an IndependentMvnModel slab prior to avoid
+  // p x p storage altogether.
+  class RegressionSpikeSlabSampler : public PosteriorSampler {
+   public:
+    RegressionSpikeSlabSampler(RegressionModel *model,
+                               Ptr<MvnBase> slab,
+                               Ptr<VariableSelectionPrior> spike,
+                               Ptr<GammaModelBase> residual_precision_prior,
+                               RNG &seeding_rng = GlobalRng::rng);
+
+    void draw() override;
+    double logpri() const override;
+
+    void allow_model_selection(bool allow) {
+      spike_slab_sampler_.allow_model_selection(allow);
+    }
+
+    void limit_model_selection(int max_flips) {
+      spike_slab_sampler_.limit_model_selection(max_flips);
+    }
+
+    void set_sigma_upper_limit(double sigma_upper_limit) {
+      sigsq_sampler_.set_sigma_max(sigma_upper_limit);
+    }
+
+   private:
+    void draw_model_indicators_and_coefficients();
+    void draw_sigma_full_conditional();
+
+    RegressionModel *model_;
+    Ptr<MvnBase> slab_;
+    Ptr<VariableSelectionPrior> spike_;
+    Ptr<GammaModelBase> residual_precision_prior_;
+    SpikeSlabSampler spike_slab_sampler_;
+    GenericGaussianVarianceSampler sigsq_sampler_;
+
+    // Dense sufficient statistics are copied here, in the form
+    // expected by spike_slab_sampler_.  It is created on first use,
+    // so models with sparse sufficient statistics never allocate it.
+    Ptr<WeightedRegSuf> dense_suf_;
+  };
+
+}  // namespace BOOM
+
+#endif  //  BOOM_REGRESSION_SPIKE_SLAB_SAMPLER_HPP_
@@ -5,6 +5,9 @@
 #include <Models/MvnBase.hpp>
 #include <Models/Glm/VariableSelectionPrior.hpp>
 #include <Models/Glm/WeightedRegressionModel.hpp>
+#include <Models/Glm/RegressionModel.hpp>
+#include <functional>
+#include <Models/Glm/PosteriorSamplers/IncrementalSlabPosterior.hpp>
 
 namespace BOOM {
 
@@ -42,6 +45,14 @@ namespace BOOM {
     // sufficient statistics.
     void draw_beta(RNG &rng, const WeightedRegSuf &suf, double sigsq = 1.0);
 
+    // Versions of draw_model_indicators and draw_beta for sufficient
+    // statistics with a sparse X'WX.  Only the elements of X'WX
+    // involving included variables are read.  If the slab prior is an
+    // IndependentMvnModel then no p x p matrix is formed.
+    void draw_model_indicators(
+        RNG &rng, const SparseRegSuf &suf, double sigsq = 1.0);
+    void draw_beta(RNG &rng, const SparseRegSuf &suf, double sigsq = 1.0);
+
     // If tf == true then draw_model_indicators is a no-op.  Otherwise
     // model indicators will be sampled each iteration.
     void allow_model_selection(bool tf);
@@ -55,15 +66,49 @@ namespace BOOM {
    private:
     // Compute the log of the marginal posterior probability of model 'g'.
     // Args:
+    //   g: The set of included coefficients defining the model.  The
+    //     included set in slab_posterior_ must match g.
+    double log_model_prob(const Selector &g) const;
+
+    // Refactor slab_posterior_ for the model 'g'.
+    // Args:
     //   g: The set of included coefficients defining the model.
     //   suf:  The set of complete data sufficient statistics.
     //   sigsq: If the model has a residual variance parameter that is
     //     not reflected in 'suf' provide it here.  Models that do not
     //     have a separate residual variance parameter should use
     //     sigsq = 1.0.
-    double log_model_prob(const Selector &g,
-                          const WeightedRegSuf &suf,
-                          double sigsq) const;
+    // Returns:
+    //   true if the posterior precision for model 'g' is positive
+    //   definite.
+    bool reset_slab_posterior(const Selector &g,
+                              const WeightedRegSuf &suf,
+                              double sigsq);
+    bool reset_slab_posterior(const Selector &g,
+                              const SparseRegSuf &suf,
+                              double sigsq);
+
+    // The body of draw_model_indicators.
+    // Args:
+    //   rng:  The uniform random number generator.
+    //   reset: Refactors slab_posterior_ for a given model, as
+    //     reset_slab_posterior does.
+    void sweep_model_indicators(
+        RNG &rng, const std::function<bool(const Selector &)> &reset);
+
+    // Draw the included coefficients given the elements of X'WX and
+    // X'Wy for the included variables.
+    void draw_included_coefficients(RNG &rng,
+                                    const Selector &inclusion_indicators,
+                                    const SpdMatrix &included_xtx,
+                                    const Vector &included_xty,
+                                    double sigsq);
+
+    // The rows and columns of the slab prior precision for the
+    // included variables.  A diagonal prior is read without forming
+    // the full precision matrix.
+    SpdMatrix included_prior_precision(
+        const Selector &inclusion_indicators) const;
 
     // A single MCMC step for a single position in the set of
     // coefficient indicators 'g'.
@@ -74,24 +119,26 @@ namespace BOOM {
     //   which_variable:  The position in 'g' to consider changing.
     //   logp_old: The value of log_model_prob(g) prior to calling
     //     this function.
-    //   suf:  The set of complete data sufficient statistics.
-    //   sigsq: If the model has a residual variance parameter that is
-    //     not reflected in 'suf' provide it here.  Models that do not
-    //     have a separate residual variance parameter should use
-    //     sigsq = 1.0.
     double mcmc_one_flip(
         RNG &rng,
         Selector &g,
         int which_variable,
-        double logp_old,
-        const WeightedRegSuf &suf,
-        double sigsq);
+        double logp_old);
 
     GlmModel *model_;
     Ptr<MvnBase> slab_prior_;
     Ptr<VariableSelectionPrior> spike_prior_;
     int max_flips_;
     bool allow_model_selection_;
+
+    // Cholesky factors of the prior and posterior precision for the
+    // included coefficients, updated incrementally as individual
+    // inclusion indicators are flipped.
+    IncrementalSlabPosterior slab_posterior_;
+
+    // The diagonal of the slab prior precision, when the slab prior is
+    // an IndependentMvnModel.  slab_posterior_ keeps a pointer to it.
+    Vector prior_precision_diagonal_;
   };
 
 }  // namespace BOOM
@@ -23,6 +23,9 @@
 #include <uint.hpp>
 #include <Models/Glm/Glm.hpp>
 #include <LinAlg/QR.hpp>
+#include <LinAlg/OuterProductBuffer.hpp>
+#include <LinAlg/SparseCrossProductMatrix.hpp>
+#include <Models/Glm/SparseRegressionData.hpp>
 #include <Models/Sufstat.hpp>
 #include <Models/ParamTypes.hpp>
 #include <Models/Policies/ParamPolicy_2.hpp>
@@ -90,6 +93,12 @@ namespace BOOM{
     virtual void add_mixture_data(double y, const Vector &x, double prob) = 0;
     virtual void add_mixture_data(double y, const ConstVectorView &x,
                                   double prob) = 0;
+
+    // Adds every row of 'data' as if by add_mixture_data(y, x, w),
+    // where w is the row's weight.  The default implementation does
+    // exactly that, one row at a time.
+    virtual void add_columnar_data(const ColumnarRegressionData &data);
+
     virtual void combine(Ptr<RegSuf>) = 0;
 
     ostream &print(ostream &out) const override;
@@ -180,6 +189,10 @@ namespace BOOM{
     void add_mixture_data(
         double y, const ConstVectorView &x, double prob) override;
     void Update(const RegressionData & rdp) override;
+
+    // Accumulates X^T W X in blocks of rows using dsyrk.
+    void add_columnar_data(const ColumnarRegressionData &data) override;
+
     uint size() const override;  // dimension of beta
     double yty() const override;
     Vector xty() const override;
@@ -204,11 +217,15 @@ namespace BOOM{
     ostream &print(ostream &out) const override;
 
     // Adding data only updates the upper triangle of xtx_.  Calling
-    // reflect() fills the lower triangle as well, if needed.
+    // reflect() adds any buffered outer products, and fills the lower
+    // triangle as well, if needed.
     void reflect() const;
   private:
     mutable SpdMatrix xtx_;
     mutable bool needs_to_reflect_;
+    // Observations added one at a time are collected here and added
+    // to xtx_ in blocks.
+    mutable OuterProductBuffer xtx_buffer_;
     Vector xty_;
     bool xtx_is_fixed_;
     double sumsqy;
@@ -231,6 +248,68 @@ namespace BOOM{
   }
 
 
+  //------------------------------------------------------------------
+  // Sufficient statistics for a regression with a sparse design
+  // matrix.  X'X is held in a SparseCrossProductMatrix, so memory is
+  // proportional to its nonzero elements rather than p^2.  The
+  // selected versions of xtx() and xty() only touch the included
+  // variables, which is all that variable selection samplers need.
+  // The full xtx(), beta_hat() and SSE() build a dense p x p matrix,
+  // and should be avoided when p is large.
+  class SparseRegSuf
+      : public RegSuf,
+        public SufstatDetails<RegressionData>
+  {
+   public:
+    explicit SparseRegSuf(uint p);
+    SparseRegSuf *clone() const override;
+
+    void clear() override;
+    void add_mixture_data(
+        double y, const Vector &x, double prob) override;
+    void add_mixture_data(
+        double y, const ConstVectorView &x, double prob) override;
+    void Update(const RegressionData &rdp) override;
+
+    // Adds every row of 'data', weighted by its weight.
+    void add_sparse_data(const SparseRegressionData &data);
+
+    uint size() const override;  // dimension of beta
+    double yty() const override;
+    Vector xty() const override;
+    SpdMatrix xtx() const override;
+    Vector xty(const Selector &) const override;
+    SpdMatrix xtx(const Selector &) const override;
+    Vector beta_hat() const override;
+    double SSE() const override;
+    double SST() const override;
+    double ybar() const override;
+    Vector xbar() const override;
+    double n() const override;
+    void combine(Ptr<RegSuf>) override;
+    void combine(const RegSuf &);
+    SparseRegSuf * abstract_combine(Sufstat *s) override;
+
+    Vector vectorize(bool minimal=true) const override;
+    Vector::const_iterator unvectorize(
+        Vector::const_iterator &v, bool minimal=true) override;
+    Vector::const_iterator unvectorize(
+        const Vector &v, bool minimal=true) override;
+    ostream &print(ostream &out) const override;
+
+    // The cross product matrix, for samplers that read individual
+    // elements of it (see IncrementalSlabPosterior).
+    const SparseCrossProductMatrix &sparse_xtx() const {return xtx_;}
+
+   private:
+    SparseCrossProductMatrix xtx_;
+    Vector xty_;
+    double sumsqy_;
+    double n_;
+    double sumy_;
+    Vector x_column_sums_;
+  };
+
   //------------------------------------------------------------------
   class RegressionDataPolicy
     : public SufstatDataPolicy<RegressionData, RegSuf>
@@ -282,6 +361,11 @@ namespace BOOM{
     RegressionModel(const Matrix &X, const Vector &y);
 
     RegressionModel(const DatasetType &d, bool include_all_variables = true);
+
+    // Equivalent to RegressionModel(data->xdim()) followed by
+    // set_sparse_data(data), but the sufficient statistics are sparse
+    // from the start, so no p x p matrix is allocated.
+    explicit RegressionModel(const Ptr<SparseRegressionData> &data);
     RegressionModel(const RegressionModel &rhs);
     RegressionModel * clone() const override;
 
@@ -343,8 +427,29 @@ namespace BOOM{
 
     void add_mixture_data(Ptr<Data>, double prob) override;
 
+    // The sufficient statistics are computed from the columnar data
+    // when it is assigned, after which posterior samplers that only
+    // use suf() (e.g. RegressionConjSampler, BregVsSampler) work as
+    // usual.  A QR-based suf is replaced by normal equations.
+    void set_columnar_data(const Ptr<ColumnarRegressionData> &data) override;
+    void clear_data() override;
+
+    // Replaces the model's data with a SparseRegressionData, and its
+    // sufficient statistics with a SparseRegSuf computed from it.
+    // Data points added later are accumulated into the same
+    // SparseRegSuf.
+    void set_sparse_data(const Ptr<SparseRegressionData> &data);
+
+    // The data assigned by set_sparse_data, or nullptr.
+    const Ptr<SparseRegressionData> &sparse_data() const {
+      return sparse_data_;
+    }
+
     //--- diagnostics ---
     AnovaTable anova()const{return suf()->anova();}
+
+   private:
+    Ptr<SparseRegressionData> sparse_data_;
   };
 
 }  // namespace BOOM
@@ -0,0 +1,136 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_SPARSE_REGRESSION_DATA_HPP_
+#define BOOM_SPARSE_REGRESSION_DATA_HPP_
+
+#include <cstddef>
+#include <vector>
+#include <LinAlg/Matrix.hpp>
+#include <LinAlg/SparseCrossProductMatrix.hpp>
+#include <LinAlg/Vector.hpp>
+#include <LinAlg/VectorView.hpp>
+#include <cpputil/RefCounted.hpp>
+
+namespace BOOM {
+
+  // A regression data set with a sparse design matrix, stored in
+  // compressed sparse row (CSR) format.  The nonzero elements of row
+  // i are values()[k] in column column_indices()[k], for k in
+  // [row_offsets()[i], row_offsets()[i + 1]).  Memory is proportional
+  // to the number of nonzero predictors, so data sets with many
+  // one-hot encoded categorical predictors fit where a dense
+  // ColumnarRegressionData (or a vector of RegressionData) would not.
+  //
+  // A RegressionModel given sparse data (see
+  // RegressionModel::set_sparse_data) keeps its cross products in a
+  // SparseRegSuf, so that posterior samplers only form the dense
+  // blocks of X'X they need.
+  //
+  // The weights have the same meaning as in ColumnarRegressionData.
+  // The data cannot be changed after construction, so one data set
+  // can be shared by several models.
+  class SparseRegressionData : private RefCounted {
+   public:
+    // Build from a dense design matrix, dropping the zeros.
+    // Args:
+    //   X: The design matrix.  Include a column of 1's if an
+    //     intercept is desired.
+    //   y: The response vector.  Its size must match nrow(X).
+    //   weights: Either empty, or of the same size as y.
+    SparseRegressionData(const Matrix &X, const Vector &y,
+                         const Vector &weights = Vector());
+
+    // Build from the CSR arrays.
+    // Args:
+    //   xdim:  The number of columns in the design matrix.
+    //   row_offsets: A vector of size nobs + 1, with row_offsets[0] ==
+    //     0 and row_offsets[nobs] == values.size().
+    //   column_indices: The column of each nonzero value.  Within a
+    //     row the columns must be strictly increasing.
+    //   values:  The nonzero values of the design matrix.
+    //   y:  The response vector, with one element per row.
+    //   weights: Either empty, or of the same size as y.
+    SparseRegressionData(int xdim,
+                         const std::vector<std::size_t> &row_offsets,
+                         const std::vector<int> &column_indices,
+                         const Vector &values,
+                         const Vector &y,
+                         const Vector &weights = Vector());
+
+    int nobs() const {return y_.size();}
+    int xdim() const {return xdim_;}
+    std::size_t nonzeros() const {return values_.size();}
+
+    const Vector &y() const {return y_;}
+    double y(int i) const {return y_[i];}
+
+    bool has_weights() const {return !weights_.empty();}
+    double weight(int i) const {
+      return weights_.empty() ? 1.0 : weights_[i];
+    }
+    const Vector &weights() const {return weights_;}
+
+    // The nonzero elements of row i.
+    int row_size(int i) const {
+      return row_offsets_[i + 1] - row_offsets_[i];
+    }
+    const int *column_indices(int i) const {
+      return column_indices_.data() + row_offsets_[i];
+    }
+    const double *values(int i) const {
+      return values_.data() + row_offsets_[i];
+    }
+
+    // The predictors for observation i, as a dense vector.
+    Vector x(int i) const;
+
+    // Returns x(i).dot(beta), touching only the nonzero elements.
+    double predict(int i, const Vector &beta) const;
+
+    // Sets eta[i] = predict(first + i, beta) for each element of eta.
+    void predict(const Vector &beta, int first, VectorView eta) const;
+
+    // Adds the weighted cross products of all the rows:
+    //   xtwx += sum_i weight(i) * x_i * x_i^T
+    //   xtwy += sum_i weight(i) * y(i) * x_i
+    void add_cross_products(SparseCrossProductMatrix &xtwx,
+                            Vector &xtwy) const;
+
+    friend void intrusive_ptr_add_ref(SparseRegressionData *d) {
+      d->up_count();
+    }
+    friend void intrusive_ptr_release(SparseRegressionData *d) {
+      if (d->down_count() == 0) delete d;
+    }
+
+   private:
+    // Checks that the CSR arrays are consistent with one another.
+    void check_storage() const;
+
+    int xdim_;
+    std::vector<std::size_t> row_offsets_;
+    std::vector<int> column_indices_;
+    Vector values_;
+    Vector y_;
+    Vector weights_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_SPARSE_REGRESSION_DATA_HPP_
@@ -21,6 +21,7 @@
 
 #include <Models/Glm/RegressionModel.hpp>
 #include <Models/Glm/Glm.hpp>
+#include <LinAlg/OuterProductBuffer.hpp>
 
 namespace BOOM{
 
@@ -36,8 +37,12 @@ namespace BOOM{
     double yt_w_y_;
     double sumlogw_;
     mutable bool sym_;
+    // Observations added one at a time are collected here and added
+    // to the upper triangle of xtwx_ in blocks.
+    mutable OuterProductBuffer xtwx_buffer_;
     void setup_mat(uint p);
     void make_symmetric()const;
+    void flush_buffer()const;
   public:
     typedef WeightedRegressionData data_type;
     typedef std::vector<Ptr<WeightedRegressionData> > dataset_type;
@@ -59,7 +64,19 @@ namespace BOOM{
 
     //    virtual void Update(const RegressionData &);
     void Update(const WeightedRegressionData &) override;
+    // Observations with zero weight are ignored, and do not count
+    // towards n().
     void add_data(const Vector &x, double y, double w);
+
+    // Adds a block of rows from 'data', starting with row 'first'.
+    // Row first + i contributes as if by add_data(x, y[i], w[i]), so
+    // rows with zero weight are skipped.  The predictors
+    // come from 'data', but the responses and weights are supplied
+    // by the caller (typically imputed latent data).
+    void add_columnar_data(const ColumnarRegressionData &data,
+                           int first,
+                           const ConstVectorView &y,
+                           const ConstVectorView &w);
     void clear() override;
     virtual uint size()const;  // dimension of beta
     virtual double yty()const;              // Y^t W Y
@@ -10,6 +10,7 @@
 #include <Models/PosteriorSamplers/MarkovConjSampler.hpp>
 #include <Models/PosteriorSamplers/MarkovConjShrinkageSampler.hpp>
 #include <distributions/rng.hpp>
+#include <cpputil/ThreadTools.hpp>
 
 #include <Models/HMM/Clickstream/Stream.hpp>
 
@@ -27,6 +28,9 @@ namespace BOOM {
 
     NestedHmm(const std::vector<Ptr<Stream> > & streams, int S2, int S1);
     NestedHmm(int S2, int S1, int S0);
+    // The copy gets its own copies of the component models.  If rhs
+    // uses threads, the copy gets its own workers and thread pool.
+    NestedHmm(const NestedHmm &rhs);
     NestedHmm * clone() const override;
 
     // The mixture component for state H, h.
@@ -75,7 +79,10 @@ namespace BOOM {
 
     ostream & write_suf(ostream &)const;
 
-    // Sets the number of threads to use for data imputation.
+    // Sets the number of threads to use for data imputation.  The
+    // streams are divided among n worker models, each of which runs
+    // in its own thread from a pool that persists across calls to
+    // impute_latent_data() and fwd_bkwd().
     void set_threads(int n);
 
     double impute_latent_data();
@@ -168,6 +175,7 @@ namespace BOOM {
     RNG rng_;
 
     std::vector<Ptr<NestedHmm> > workers_;
+    ThreadWorkerPool pool_;
     void setup();
     void pass_params_to_workers();
     void fill_logd(Ptr<Event>)const;
@@ -25,6 +25,7 @@
 #include <Models/TimeSeries/TimeSeriesDataPolicy.hpp>
 #include <Models/Policies/PriorPolicy.hpp>
 #include <Models/DataTypes.hpp>
+#include <cpputil/ThreadTools.hpp>
 
 namespace BOOM{
 
@@ -55,7 +56,11 @@ class HiddenMarkovModel :
 
   uint state_space_size() const;
   virtual void initialize_params();
-  void set_nthreads(uint);
+  // Impute latent data using n worker threads.  Each worker gets its
+  // own random number stream, split from seeding_rng, and every n'th
+  // data series.  The threads are created here, and reused by each
+  // call to impute_latent_data().
+  void set_nthreads(uint n, RNG &seeding_rng = GlobalRng::rng);
 
   double pdf(dPtr dp, bool logscale) const;
   void clear_client_data();
@@ -63,14 +68,18 @@ class HiddenMarkovModel :
   std::vector<Ptr<MixtureComponent> > mixture_components();
   Ptr<MixtureComponent> mixture_component(uint s);
 
-  // returns loglike as a side effect
+  // returns loglike as a side effect.  The version without an RNG
+  // argument uses GlobalRng::rng.  Posterior samplers should pass
+  // their own rng() so that chains run in parallel stay independent.
   double impute_latent_data();
+  double impute_latent_data(RNG &rng);
   uint nthreads()const;
 
   Ptr<MarkovModel> mark();
   double loglike()const;
   double saved_loglike()const;
   void randomly_assign_data();
+  void randomly_assign_data(RNG &rng);
 
   // For managing the distribution of hidden states.
   void save_state_probs();
@@ -103,6 +112,7 @@ class HiddenMarkovModel :
   Ptr<UnivParams> loglike_;
   Ptr<UnivParams> logpost_;
   std::vector<Ptr<HmmDataImputer> > workers_;
+  ThreadWorkerPool pool_;
 
   double impute_latent_data_with_threads();
 };
@@ -95,7 +95,9 @@ namespace BOOM{
     std::vector<Ptr<MixtureComponent> > mixture_components();
     Ptr<MixtureComponent> mixture_component(uint s);
 
+    // The version without an RNG argument uses GlobalRng::rng.
     double impute_latent_data();
+    double impute_latent_data(RNG &rng);
     Ptr<MarkovModel> mark(int treatment);
    private:
     // Add mix_ and mark_ to the list of models managed by the
@@ -105,7 +107,7 @@ namespace BOOM{
     double initialize_fwd(Ptr<HealthStateData>)const;
     double fwd(const TimeSeries<HealthStateData> &series);
     double compute_loglike(const TimeSeries<HealthStateData> &series)const;
-    void bkwd(const TimeSeries<HealthStateData> &series);
+    void bkwd(const TimeSeries<HealthStateData> &series, RNG &rng);
 
     // Fill logp_[0..state_space_size()-1] with the conditional
     // probability density of the given data point under each mixture
@@ -118,7 +120,8 @@ namespace BOOM{
 
     int sample_treatment(Ptr<HealthStateData>,
                          uint previous_state,
-                         uint current_state);
+                         uint current_state,
+                         RNG &rng);
 
     std::vector<Ptr<MixtureComponent> > mix_;
     std::vector<Ptr<MarkovModel> > mark_;
@@ -29,7 +29,9 @@ class HmmDataImputer
 {
   // HmmDataImputer
  public:
-  HmmDataImputer(HiddenMarkovModel *hmm, uint id, uint nworkers);
+  // The imputer draws from its own stream, split from seeding_rng.
+  HmmDataImputer(HiddenMarkovModel *hmm, uint id, uint nworkers,
+                 RNG &seeding_rng = GlobalRng::rng);
   void operator()();
 
   Ptr<MarkovModel> mark();
@@ -41,7 +43,7 @@ class HmmDataImputer
 
   friend void intrusive_ptr_add_ref(HmmDataImputer *d){d->up_count();}
   friend void intrusive_ptr_release(HmmDataImputer *d){
-    d->down_count(); if(d->ref_count()==0) delete d;}
+    if(d->down_count() == 0) delete d;}
  private:
   uint id_;
   uint nworkers_;
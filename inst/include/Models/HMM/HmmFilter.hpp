@@ -33,18 +33,32 @@ class Data;
 class EmMixtureComponent;
 class HiddenMarkovModel;
 
+// The forward-filter backward-sampler for hidden Markov models.
+//
+// The forward pass stores only the filtered state marginals
+// p(h[t] | y[0..t]) and the emission log densities, which is O(n * S)
+// storage for a series of length n with S states.  The joint
+// distribution of adjacent states needed by the backward pass is
+// recomputed on the fly from the filtered marginals and the
+// transition matrix, rather than storing an S x S matrix per time
+// step.
+//
+// The emission log densities for a whole series are computed one
+// state at a time using MixtureComponent::batch_logp.  The forward
+// recursion works with scaled probabilities, and the transition
+// probabilities are stored by row so that the prediction step is a
+// sequence of contiguous axpy operations.
 class HmmFilter
     : private RefCounted{
  public:
   friend void intrusive_ptr_add_ref(HmmFilter *d){d->up_count();}
   friend void intrusive_ptr_release(HmmFilter *d){
-      d->down_count(); if(d->ref_count()==0) delete d;}
+      if(d->down_count() == 0) delete d;}
 
   HmmFilter(std::vector<Ptr<MixtureComponent> >, Ptr<MarkovModel> );
   ~HmmFilter() override{}
   uint state_space_size()const;
 
-  double initialize(const Data *);
   double loglike(const std::vector<Ptr<Data> > & );
   double fwd(const std::vector<Ptr<Data> > & );
   void bkwd_sampling(const std::vector<Ptr<Data> > &);
@@ -53,10 +67,41 @@ class HmmFilter
   virtual void allocate(Ptr<Data>, uint);
   virtual Vector state_probs(Ptr<Data>)const;
  protected:
+  // Fill logd_ with the log density of each observation under each
+  // state, and transition_ with the current transition probabilities.
+  void compute_log_densities(const std::vector<Ptr<Data> > &dv);
+
+  // One step of the forward recursion.
+  // Args:
+  //   t:  The time step being filtered.
+  //   previous: p(h[t-1] | y[0..t-1]), or the initial distribution
+  //     if t == 0.
+  //   next: On output, p(h[t] | y[0..t]).
+  // Returns:
+  //   log p(y[t] | y[0..t-1]).
+  double filter_step(uint t, const ConstVectorView &previous, VectorView next);
+
+  // Sets ans[r] = p(h[t-1] = r, h[t] = s | y[0..t]), which is column s
+  // of the joint distribution of (h[t-1], h[t]).  Requires t > 0 and
+  // a previous call to fwd().
+  void transition_column(uint t, uint s, Vector &ans) const;
+
   std::vector<Ptr<MixtureComponent> > models_;
-  std::vector<Mat> P;
-  Vector pi, logp, logpi, one;
-  Matrix logQ;
+
+  // filtered_(s, t) = p(h[t] = s | y[0..t]).  Column t is contiguous.
+  Matrix filtered_;
+
+  // logd_(t, s) = log p(y[t] | h[t] = s).  Column s is contiguous, so
+  // each state's densities can be filled by one batch call.
+  Matrix logd_;
+
+  // transition_(s, r) = Q(r, s), so that column r of transition_ is
+  // row r of the transition matrix Q.
+  Matrix transition_;
+
+  Vector pi, one;
+  // Workspace for the prediction step.
+  Vector predicted_;
   Ptr<MarkovModel> markov_;
 
 };
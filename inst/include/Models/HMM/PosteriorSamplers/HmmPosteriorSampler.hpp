@@ -22,19 +22,11 @@
 #include <Models/HMM/HMM2.hpp>
 #include <Models/PosteriorSamplers/PosteriorSampler.hpp>
 #include <distributions/rng.hpp>
+#include <cpputil/ThreadTools.hpp>
+#include <functional>
 
 namespace BOOM{
 
-class MixtureComponentSampler{
- public:
-  MixtureComponentSampler(Model *m) : m_(m){}
-  void operator()(){m_->sample_posterior();}
-  // m_ must have been assigned a thread safe PosteriorSampler, or this
-  // will result in a race condition on the random seed of the RNG
- private:
-  Model *m_;
-};
-
 class HmmPosteriorSampler
     : public PosteriorSampler{
  public:
@@ -42,14 +34,19 @@ class HmmPosteriorSampler
                       RNG &seeding_rng = GlobalRng::rng);
   void draw() override;
   double logpri() const override;
+
+  // If yn is true then the mixture components are sampled in
+  // parallel, one thread per component.  Each component's samplers
+  // are given their own random number streams, so the components'
+  // posterior samplers must not share any other state.
   void use_threads(bool yn = true);
   void draw_mixture_components();
  private:
   HiddenMarkovModel *hmm_;
-  std::vector<boost::shared_ptr<MixtureComponentSampler> > workers_;
-#ifndef NO_BOOST_THREADS
   bool use_threads_;
-#endif
+  // tasks_[s] samples the parameters of mixture component s.
+  std::vector<std::function<void()> > tasks_;
+  ThreadWorkerPool pool_;
 };
 
 
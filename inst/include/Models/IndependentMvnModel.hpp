@@ -104,6 +104,9 @@ namespace BOOM{
 
     double pdf(const Data * dp, bool logscale) const override;
    private:
+    // Sized on first use by Sigma() or siginv(), so that models of
+    // high dimension that never need the full matrix don't pay for
+    // it.
     mutable SpdMatrix sigma_scratch_;
     mutable Vector g_;
     mutable Matrix h_;
@@ -176,6 +176,11 @@ namespace BOOM {
     // workspace for evaluating class member probabilities.
     mutable Vector wsp_;
 
+    // The data points modeled by the mixture components, laid out so
+    // that each component can evaluate them with a single call to
+    // batch_logp.
+    std::vector<Ptr<Data> > component_data_;
+
     // A number_of_observations X number_of_mixture_components matrix,
     // giving the class membership probabilities for each observation
     // as of the last call to impute_latent_data.
@@ -23,6 +23,7 @@
 #include <Models/PosteriorSamplers/PosteriorSampler.hpp>
 #include <Models/MvnGivenSigma.hpp>
 #include <Models/WishartModel.hpp>
+#include <vector>
 
 namespace BOOM {
 
@@ -63,6 +64,9 @@ namespace BOOM {
     // in the model object to different clusters.
     void draw_cluster_membership_indicators();
 
+    // The cluster to which each observation is assigned, numbered as
+    // in model->cluster().  The indicators are current between calls
+    // to draw_cluster_membership_indicators().
     const std::vector<int> &cluster_indicators() const {
       return cluster_indicators_;
     }
@@ -73,21 +77,25 @@ namespace BOOM {
     // Compute the discrete probability distribution of cluster
     // membership for observation y, which is currently unassigned,
     // conditional on the cluster membership of the other data points.
+    // Element k of the result corresponds to model->cluster(k), and
+    // the final element to a new cluster.
     Vector cluster_membership_probability(const Vector &y);
 
     // Returns the log marginal density of y given a cluster of other
     // observations summarized by suf.  The marginal density of y is
     // the integral of p(y | theta) * p(theta | suf) with respect to
-    // theta.  For the math, see Murphy (Machine Learning: A
-    // probabilistic perspective) page 161 (eq: 5.29).
+    // theta, which is a multivariate T distribution.  For the math,
+    // see Murphy (Machine Learning: A probabilistic perspective) page
+    // 161 (eq: 5.29).
     double log_marginal_density(const Vector &y, const MvnSuf &suf) const;
 
     // Assign the (currently unassigned) observation to the given
     // cluster, recording the assignment in both the held model as
-    // well as the set of cluster indicators.
+    // well as the cached cluster posteriors.
     // Args:
     //   y:  The data to be assigned.
-    //   cluster:  The cluster indicator.
+    //   cluster: The index of the cluster in the model.  If cluster
+    //     == model->number_of_clusters() a new cluster is created.
     void assign_data_to_cluster(const Vector &y, int cluster);
 
     // Remove the observation y from the specified cluster.  It is the
@@ -96,13 +104,75 @@ namespace BOOM {
     void remove_data_from_cluster(const Vector &y, int cluster);
 
    private:
+    // The normal inverse Wishart posterior for the parameters of one
+    // cluster, with the posterior sum of squares matrix stored as its
+    // lower Cholesky factor.  Moving an observation in or out of the
+    // cluster is a rank one update or downdate of the factor, and the
+    // predictive density of a new observation costs O(dim^2).
+    struct ClusterPosterior {
+      Vector mean;
+      double mean_sample_size;
+      double variance_sample_size;
+      Matrix sum_of_squares_cholesky;
+      double sum_of_squares_logdet;
+    };
+
+    // Calls refresh_cluster_posteriors() if the cached posteriors do
+    // not match the clusters in the model.
+    void ensure_cluster_posteriors();
+
+    // Rebuild the prior and all cluster posteriors from the model's
+    // sufficient statistics, which removes rounding error accumulated
+    // by the rank one updates.  Clusters are placed in slots matching
+    // their position in the model.
+    void refresh_cluster_posteriors();
+
+    // Set *posterior to the posterior distribution given the data in
+    // suf, or to the prior if suf is empty.
+    void compute_cluster_posterior(const MvnSuf &suf,
+                                   ClusterPosterior *posterior) const;
+
+    // The log predictive density (up to a constant shared by all
+    // clusters) of y given the data already in a cluster.
+    double log_predictive_density(const Vector &y,
+                                  const ClusterPosterior &posterior) const;
+
+    void add_to_posterior(const Vector &y, ClusterPosterior *posterior);
+
+    // Returns false if the rank one downdate failed, in which case the
+    // contents of *posterior are unusable.
+    bool remove_from_posterior(const Vector &y, ClusterPosterior *posterior);
+
+    // Renumber the slots so that slot k holds model->cluster(k), and
+    // translate cluster_indicators_ from slots to model clusters.
+    void compact_slots();
+
     DirichletProcessMvnModel *model_;
     Ptr<MvnGivenSigma> mean_base_measure_;
     Ptr<WishartModel> precision_base_measure_;
 
     // cluster_indicators_[i] == -1 means observation i is unassigned.
+    // During a call to draw_cluster_membership_indicators()
+    // cluster_indicators_ holds slot numbers rather than model
+    // clusters, so that removing an empty cluster does not require
+    // renumbering every observation.
     std::vector<int> cluster_indicators_;
-    MvnSuf empty_suf_;
+
+    // Cluster posteriors are kept in stable slots.  A slot is freed
+    // when its cluster becomes empty, and reused for the next new
+    // cluster.  cluster_slots_[k] is the slot holding model->cluster(k),
+    // and slot_positions_[s] is the model cluster held in slot s (or
+    // -1 if the slot is free).
+    std::vector<ClusterPosterior> slots_;
+    std::vector<int> free_slots_;
+    std::vector<int> cluster_slots_;
+    std::vector<int> slot_positions_;
+
+    // The posterior of an empty cluster.
+    ClusterPosterior prior_;
+
+    // Workspace for the predictive density.
+    mutable Vector wsp_;
   };
 
 }  // namespace BOOM
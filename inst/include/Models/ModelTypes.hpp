@@ -24,6 +24,7 @@
 #include <distributions/rng.hpp>
 #include <LinAlg/Vector.hpp>
 #include <LinAlg/Matrix.hpp>
+#include <LinAlg/VectorView.hpp>
 
 namespace BOOM {
 
@@ -44,7 +45,7 @@ namespace BOOM {
    public:
     friend void intrusive_ptr_add_ref(Model *d){d->up_count();}
     friend void intrusive_ptr_release(Model *d){
-      d->down_count(); if(d->ref_count()==0) delete d;}
+      if(d->down_count() == 0) delete d;}
 
     //------ constructors, destructors, operator=/== -----------
     Model();
@@ -88,6 +89,12 @@ namespace BOOM {
     virtual void set_method(Ptr<PosteriorSampler>) = 0;
     virtual int number_of_sampling_methods() const = 0;
 
+    // Give each of the posterior samplers assigned to this model its
+    // own stream, split from seeding_rng using split_rng().  This is
+    // how models that run in parallel (e.g. different chains) are
+    // given independent random number streams.
+    void seed_samplers(RNG &seeding_rng);
+
    protected:
     virtual PosteriorSampler * sampler(int i) = 0;
     virtual PosteriorSampler const *const sampler(int i) const = 0;
@@ -211,6 +218,24 @@ namespace BOOM {
    public:
     virtual double pdf(const Data *, bool logscale)const = 0;
     MixtureComponent * clone() const override = 0;
+
+    // Evaluate the log density of each element of 'data', placing
+    // the result for data[i] in ans[i].  Missing data points have log
+    // density 0.
+    void batch_logp(const std::vector<Ptr<Data> > &data,
+                    VectorView ans) const;
+
+    // Evaluate the log density of data[begin], ..., data[end - 1],
+    // placing the result for data[begin + i] in ans[i], which must
+    // have size end - begin.  Missing data points have log density 0.
+    // The default implementation calls pdf() once per observation.
+    // Models that can hoist parameter lookups and constants out of
+    // the loop should override it, since callers (e.g. HMM filters
+    // and mixture models) evaluate whole blocks of data at once.
+    virtual void batch_logp(const std::vector<Ptr<Data> > &data,
+                            int begin,
+                            int end,
+                            VectorView ans) const;
   };
 
 }  // namespace BOOM
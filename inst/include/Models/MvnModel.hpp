@@ -78,6 +78,13 @@ namespace BOOM{
     double pdf(const Data *, bool logscale)const override;
     double pdf(const Vector &x, bool logscale)const;
 
+    // Evaluates the log density of data[begin, end) by factoring
+    // siginv once and forming the quadratic forms for a block of
+    // observations with a single matrix multiplication.
+    using MixtureComponent::batch_logp;
+    void batch_logp(const std::vector<Ptr<Data> > &data,
+                    int begin, int end, VectorView ans) const override;
+
     void set_conjugate_prior(Ptr<MvnGivenSigma>, Ptr<WishartModel>);
     void set_conjugate_prior(Ptr<MvnConjSampler>);
 
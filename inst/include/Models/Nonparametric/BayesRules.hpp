@@ -49,8 +49,7 @@ namespace BOOM {
   {
     friend void intrusive_ptr_add_ref(BaseRule *r) { r->up_count(); }
     friend void intrusive_ptr_release(BaseRule *r) {
-      r->down_count();
-      if (r->ref_count()==0) {
+      if (r->down_count() == 0) {
         delete r; }
     }
 
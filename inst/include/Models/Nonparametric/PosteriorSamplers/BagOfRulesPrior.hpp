@@ -71,8 +71,7 @@ namespace BOOM {
   class BagOfRulesPrior : private RefCounted {
     friend void intrusive_ptr_add_ref(BagOfRulesPrior * r) {r->up_count();}
     friend void intrusive_ptr_release(BagOfRulesPrior * r) {
-      r->down_count();
-      if(r->ref_count()==0) delete r;
+      if(r->down_count() == 0) delete r;
     }
 
    public:
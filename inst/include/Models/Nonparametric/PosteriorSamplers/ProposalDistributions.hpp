@@ -42,8 +42,7 @@ namespace BOOM {
     friend void intrusive_ptr_add_ref(ModifyRuleProposalBase * r) {
       r->up_count();}
     friend void intrusive_ptr_release(ModifyRuleProposalBase * r) {
-      r->down_count();
-      if (r->ref_count()==0) { delete r; }
+      if (r->down_count() == 0) { delete r; }
     }
 
    public:
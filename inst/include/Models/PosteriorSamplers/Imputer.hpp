@@ -21,17 +21,11 @@
 
 #include <memory>
 #include <cstddef>
-
-#ifndef _WIN32
-// Support for async/future is not yet available on the version of
-// MinGW used by CRAN.
-// TODO(stevescott): Remove the ugly conditional macros once CRAN can
-// support this part of C++11.
-#include <future>
-#endif
+#include <functional>
 
 #include <Models/ModelTypes.hpp>
 #include <Models/PosteriorSamplers/PosteriorSampler.hpp>
+#include <cpputil/ThreadTools.hpp>
 #include <cpputil/report_error.hpp>
 
 namespace BOOM {
@@ -84,7 +78,7 @@ namespace BOOM {
       if (sampler) {
         rng_ = &(sampler->rng());
       } else {
-        rng_storage_.reset(new RNG(seed_rng(seeding_rng)));
+        rng_storage_.reset(new RNG(split_rng(seeding_rng)));
         rng_ = rng_storage_.get();
       }
     }
@@ -132,25 +126,19 @@ namespace BOOM {
 
     // Imputes the latent data for the observed data that have been
     // assigned through set_data.
-    //
-    // TODO(stevescott): Note, the return value from this function is
-    // not used.  It was set to bool after compiler errors related to
-    // std::future<void> on CRAN's winbuilder platform.  Replace with
-    // void in the future when possible.
-    bool impute() {
+    void impute() {
       suf_.clear();
 
       // If there are more workers than data points then some workers
       // may not have data assigned.
       if (!observed_data_) {
-        return true;
+        return;
       }
       // Some syntactic sugar to prevent excessive *'s and ('s.
       const auto &data(*observed_data_);
       for (int i = first_data_point_; i < one_past_end_; ++i) {
         imputer_->impute_latent_data(*data[i], &suf_, rng());
       }
-      return true;
     }
 
     const SUFFICIENT_STATISTICS &suf() const {
@@ -207,6 +195,11 @@ namespace BOOM {
   // }
   // imputer.assign_data();
   // Sufstat = imputer.impute();
+  //
+  // Each worker is run in its own thread from a ThreadWorkerPool that
+  // lives as long as the ParallelLatentDataImputer, so threads are
+  // created once when the workers are added rather than once per
+  // call to impute().
   template <class OBSERVED_DATA,
             class SUFFICIENT_STATISTICS,
             class MODEL>
@@ -226,7 +219,9 @@ namespace BOOM {
                               MODEL *model)
         : suf_(suf),
           model_(model),
-          first_pass_(true){}
+          first_pass_(true),
+          assigned_data_(nullptr),
+          assigned_data_size_(0) {}
 
     // Add a worker to the worker pool.  The intent is for each worker
     // to run in its own thread, though if there is only one worker no
@@ -239,6 +234,10 @@ namespace BOOM {
     //     the ParallelLatentDataImputer is destroyed.
     void add_worker(Imputer *imputer, RNG &seeding_rng = GlobalRng::rng) {
       workers_.emplace_back(new Worker(imputer, suf_, seeding_rng));
+      Worker *worker = workers_.back().get();
+      tasks_.push_back([worker]() {worker->impute();});
+      pool_.set_number_of_threads(workers_.size() > 1 ? workers_.size() : 0);
+      invalidate_data_assignment();
     }
 
     int number_of_workers() const {
@@ -246,7 +245,10 @@ namespace BOOM {
     }
 
     void clear_workers() {
+      pool_.set_number_of_threads(0);
+      tasks_.clear();
       workers_.clear();
+      invalidate_data_assignment();
     }
 
     // Impute the latent data (in parallel) and return the imputed
@@ -256,10 +258,11 @@ namespace BOOM {
       if (workers_.empty()) {
         report_error("No workers have been assigned.");
       }
-      // The data must be assigned each iteration for this to work
-      // with mixtures, because each mixture component will have a
-      // different number of observations each iteration.
-      assign_data();
+      // Mixture components will have a different number of
+      // observations each iteration, so the data assignment must be
+      // checked each time.  The data are only reassigned if they have
+      // changed.
+      assign_data_if_changed();
 #ifdef _WIN32
       first_pass_ = true;
 #endif
@@ -268,26 +271,16 @@ namespace BOOM {
         // run to initialize shared data, one pass is done without
         // threading before multiple threads are invoked.  Also, if
         // there is only one worker, take this path to avoid the
-        // overhead of async/future.
+        // overhead of thread synchronization.
         for (int i = 0; i < workers_.size(); ++i) {
           workers_[i]->impute();
-          suf_.combine(workers_[i]->suf());
         }
         first_pass_ = false;
       } else {
-#ifndef _WIN32
-        std::vector<std::future<bool> > results;
-        for (int i = 0; i < workers_.size(); ++i) {
-          results.emplace_back(
-              async(std::launch::async,
-                    &Worker::impute,
-                    workers_[i].get()));
-        }
-        for (int i = 0; i < workers_.size(); ++i) {
-          results[i].get();
-          suf_.combine(workers_[i]->suf());
-        }
-#endif
+        pool_.run(tasks_);
+      }
+      for (int i = 0; i < workers_.size(); ++i) {
+        suf_.combine(workers_[i]->suf());
       }
       return suf_;
     }
@@ -310,13 +303,40 @@ namespace BOOM {
         workers_[i]->assign_data(&observed_data, b, e);
         b = e;
       }
+      assigned_data_ = &observed_data;
+      assigned_data_size_ = sample_size;
     }
 
    private:
+    // Workers refer to the model's data by its address and a range of
+    // positions, so the assignment is only stale if the model's data
+    // vector has moved or changed size.
+    void assign_data_if_changed() {
+      const std::vector<Ptr<OBSERVED_DATA>> &observed_data(model_->dat());
+      if (&observed_data != assigned_data_
+          || observed_data.size() != assigned_data_size_) {
+        assign_data();
+      }
+    }
+
+    void invalidate_data_assignment() {
+      assigned_data_ = nullptr;
+      assigned_data_size_ = 0;
+    }
+
     SUFFICIENT_STATISTICS suf_;
     MODEL *model_;
     std::vector<std::unique_ptr<Worker> > workers_;
+
+    // tasks_[i] runs workers_[i]->impute().
+    std::vector<std::function<void()>> tasks_;
+    ThreadWorkerPool pool_;
     bool first_pass_;
+
+    // The data vector most recently handed to the workers, and its
+    // size at the time.
+    const std::vector<Ptr<OBSERVED_DATA>> *assigned_data_;
+    std::size_t assigned_data_size_;
   };
 
 }  // namespace BOOM
@@ -0,0 +1,124 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_MULTI_CHAIN_RUNNER_HPP_
+#define BOOM_MULTI_CHAIN_RUNNER_HPP_
+
+#include <functional>
+#include <vector>
+
+#include <Models/ModelTypes.hpp>
+#include <LinAlg/Matrix.hpp>
+#include <cpputil/Ptr.hpp>
+#include <cpputil/ThreadTools.hpp>
+#include <distributions/rng.hpp>
+
+namespace BOOM {
+
+  // Runs several independent MCMC chains for the same model, each on
+  // its own thread.
+  //
+  // Each chain is a clone of a prototype model.  Because clone() does
+  // not copy data or posterior samplers, the caller supplies a
+  // ChainSetup function that assigns both to each clone.  The setup
+  // function is handed a seeding RNG that is unique to the chain, and
+  // it should pass that RNG to the constructors of any posterior
+  // samplers it creates (including those for sub-models), so that
+  // every sampler in every chain draws from its own stream.  After
+  // setup, the runner also reseeds the top level samplers of each
+  // chain from the same seeding RNG.
+  //
+  // All of the seeds are generated up front, in chain order, from a
+  // single master seed, so a run is reproducible regardless of how
+  // the threads are scheduled.
+  //
+  // Chains only run safely in parallel if their samplers draw all of
+  // their random numbers from their own rng().  Code that still uses
+  // GlobalRng::rng (e.g. the no-RNG forms of rnorm() and runif()) is
+  // not safe to run this way.
+  //
+  // Typical use:
+  //   MultiChainRunner runner(model, 4, 8675309, [&](Model *m, RNG &rng) {
+  //       RegressionModel *reg = dynamic_cast<RegressionModel *>(m);
+  //       reg->set_data(data);
+  //       NEW(BregVsSampler, sampler)(reg, ..., rng);
+  //       reg->set_method(sampler);
+  //     });
+  //   runner.run(10000);
+  //   const Matrix &draws = runner.draws(0);
+  class MultiChainRunner {
+   public:
+    typedef std::function<void(Model *chain_model, RNG &seeding_rng)>
+        ChainSetup;
+
+    struct ChainReport {
+      int iterations;
+      double seconds;
+      double iterations_per_second() const {
+        return seconds > 0 ? iterations / seconds : 0;
+      }
+    };
+
+    // Args:
+    //   prototype: The model to be cloned once per chain.  The
+    //     prototype itself is not modified.
+    //   number_of_chains: The number of chains to run.
+    //   seed: The master seed from which each chain's seeding RNG is
+    //     generated.
+    //   setup: Assigns data and posterior samplers to each clone.
+    //     Setup is run serially, in chain order, from the calling
+    //     thread.
+    //   number_of_threads: The number of threads to use.  A negative
+    //     number means one thread per chain.
+    MultiChainRunner(const Ptr<Model> &prototype,
+                     int number_of_chains,
+                     unsigned long seed,
+                     const ChainSetup &setup,
+                     int number_of_threads = -1);
+
+    // Runs 'niter' iterations of sample_posterior() on each chain in
+    // parallel, and blocks until all chains have finished.  Each
+    // call to run() replaces the draws and reports from the previous
+    // call.  The chains continue from where the previous call left
+    // off.
+    void run(int niter);
+
+    int number_of_chains() const {return chains_.size();}
+    Ptr<Model> chain(int i) {return chains_[i];}
+
+    // Row j of draws(i) is chain i's vectorize_params(false) after
+    // iteration j of the most recent call to run().  The non-minimal
+    // form is used so that models with variable selection produce
+    // rows of constant length.
+    const Matrix &draws(int chain) const {return draws_[chain];}
+
+    // Timing for each chain from the most recent call to run().
+    const ChainReport &report(int chain) const {return reports_[chain];}
+
+   private:
+    void run_chain(int chain, int niter);
+
+    std::vector<Ptr<Model> > chains_;
+    std::vector<Matrix> draws_;
+    std::vector<ChainReport> reports_;
+    ThreadWorkerPool pool_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_MULTI_CHAIN_RUNNER_HPP_
@@ -319,12 +319,26 @@ namespace BOOM{
 
     SparseVector observation_matrix(int t) const override;
 
+    // The accumulator's observation matrix depends on the fine data,
+    // which can change as data are added.
+    bool observation_matrices_are_fixed() const override {
+      return false;
+    }
+
     const AccumulatorStateVarianceMatrix *
     state_variance_matrix(int t) const override;
 
-    void simulate_initial_state(VectorView v) const override;
+    // The accumulator matrices depend on the position of t within
+    // the coarse time period.
+    bool model_matrices_are_time_invariant() const override {
+      return false;
+    }
+
+    void simulate_initial_state(RNG &rng, VectorView v) const override;
     Vector simulate_initial_state() const override;
-    Vector simulate_state_error(int t) const override;
+    using StateSpaceModelBase::simulate_initial_state;
+    void simulate_state_error(RNG &rng, VectorView eta, int t) const override;
+    using StateSpaceModelBase::simulate_state_error;
 
     Vector initial_state_mean() const override;
     SpdMatrix initial_state_variance() const override;
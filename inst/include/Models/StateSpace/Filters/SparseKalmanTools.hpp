@@ -19,12 +19,30 @@
 #ifndef BOOM_SPARSE_KALMAN_TOOLS_HPP
 #define BOOM_SPARSE_KALMAN_TOOLS_HPP
 
+#include <vector>
 #include <LinAlg/SpdMatrix.hpp>
 
+#include <Models/StateSpace/Filters/ScalarKalmanStorage.hpp>
 #include <Models/StateSpace/Filters/SparseVector.hpp>
 #include <Models/StateSpace/Filters/SparseMatrix.hpp>
 
 namespace BOOM{
+  // Scratch space for the sparse Kalman recursions.  An object that
+  // runs the Kalman filter repeatedly can hold on to one of these so
+  // that the recursions do not allocate once the workspace has been
+  // sized.
+  struct SparseKalmanWorkspace {
+    // Resizes all elements to state_dimension, if they are not
+    // already that size.
+    void resize(int state_dimension);
+
+    Vector PZ;
+    Vector TPZ;
+    // General purpose temporaries the size of the state vector.
+    Vector state;
+    Vector state2;
+  };
+
   // Returns the likelihood contribution of y given previous y's.
   // Uses notation from Durbin and Koopman (2001):
   //
@@ -90,6 +108,89 @@ namespace BOOM{
       const SparseKalmanMatrix &T,
       const SparseKalmanMatrix &RQR);   // state transition error variance
 
+  // As above, but with the temporaries held in 'workspace', which is
+  // resized if needed.
+  double sparse_scalar_kalman_update(
+      double y,
+      Vector &a,
+      SpdMatrix &P,
+      Vector &kalman_gain,
+      double &forecast_error_variance,
+      double &forecast_error,
+      bool missing,
+      const SparseVector &Z,
+      double observation_variance,
+      const SparseKalmanMatrix &T,
+      const SparseKalmanMatrix &RQR,
+      SparseKalmanWorkspace &workspace);
+
+  // For models with time-invariant T, RQR, and Z, the Kalman gain K
+  // and forecast variance F converge to fixed values after a few
+  // dozen time steps (the solution to the discrete algebraic Riccati
+  // equation).  Once that happens the update for P is wasted work,
+  // and the only thing left to do is to update a.
+  //
+  // A SteadyStateKalmanFilter runs sparse_scalar_kalman_update until
+  // F and K have been stable (to within a relative tolerance) for a
+  // few consecutive steps.  After that it freezes P, K, and F and runs
+  // only the O(state_dimension) mean recursion.  It falls back to the
+  // full update, and starts watching for convergence again, whenever
+  // an observation is missing or the observation variance changes.
+  //
+  // One object should be used per pass through the data.  The caller
+  // is responsible for only enabling the steady state when the model
+  // matrices really are time invariant.
+  class SteadyStateKalmanFilter {
+   public:
+    // Args:
+    //   tolerance: The largest relative change in F and the elements
+    //     of K between consecutive steps that counts as 'converged'.
+    //   stable_steps_required: The number of consecutive converged
+    //     steps needed before P is frozen.
+    explicit SteadyStateKalmanFilter(double tolerance = 1e-10,
+                                     int stable_steps_required = 3);
+
+    // Prepare for a new pass through the data.  If 'enabled' is false
+    // then update() is identical to sparse_scalar_kalman_update.
+    void reset(bool enabled);
+
+    // Arguments and return value are the same as
+    // sparse_scalar_kalman_update.  Once the filter has reached its
+    // steady state, P is left unchanged, and K and F are set to their
+    // steady state values.
+    double update(double y,
+                  Vector &a,
+                  SpdMatrix &P,
+                  Vector &kalman_gain,
+                  double &forecast_error_variance,
+                  double &forecast_error,
+                  bool missing,
+                  const SparseVector &Z,
+                  double observation_variance,
+                  const SparseKalmanMatrix &T,
+                  const SparseKalmanMatrix &RQR,
+                  SparseKalmanWorkspace &workspace);
+
+    bool converged() const {return converged_;}
+
+   private:
+    // Returns true if K and F are within tolerance_ of the values
+    // from the previous step, and stores them for the next
+    // comparison.
+    bool check_convergence(const Vector &K, double F);
+
+    double tolerance_;
+    int stable_steps_required_;
+    bool enabled_;
+    bool converged_;
+    int stable_steps_;
+
+    double previous_F_;
+    double previous_H_;
+    Vector previous_K_;
+    double steady_state_sd_;
+  };
+
   // Updates a[t] and P[t] to condition on all Y, and sets up r and N
   // for use in the next recursion.
   void sparse_scalar_kalman_smoother_update(
@@ -151,5 +252,83 @@ namespace BOOM{
       double forecast_variance,
       double forecast_error);
 
+  // A Kalman filter update for a vector valued observation y[t] with
+  // diagonal observation variance H[t], using the "univariate
+  // treatment" from Section 6.4 of Durbin and Koopman (2001).  The
+  // elements of y[t] are absorbed one at a time, with a scalar update
+  // for each, and then the state is advanced to time t+1.  This
+  // avoids inverting the (potentially large) forecast variance matrix
+  // of y[t].
+  //
+  // Args:
+  //   y:  The observation at time t.  Missing elements are ignored.
+  //   a: On input this is a[t], the expected value of the state at
+  //     time t given data to time t-1.  On output it is a[t+1].
+  //   P: On input this is P[t], the variance of the state at time t
+  //     given data to time t-1.  On output it is P[t+1].
+  //   storage: Output.  Element j is filled with the forecast error
+  //     v, forecast variance F, and gain K for y[t][j] given
+  //     y[t][0..j-1] and data to time t-1.  Note that K is
+  //     P[t, j] * Z[j] / F (the gain of the contemporaneous update),
+  //     rather than the predictive gain T * P * Z / F stored by
+  //     sparse_scalar_kalman_update.  If y[t][j] is missing then K
+  //     and v are set to zero, and F to 1.
+  //   missing: missing[j] is true if y[t][j] is missing.
+  //   Z: Z[j] is the row of the observation matrix for y[t][j].
+  //   H: The diagonal elements of the observation variance.
+  //   T: The state transition matrix at time t.
+  //   RQR: The state variance matrix at time t.
+  //
+  // Returns:
+  //   The contribution of y[t] to the log likelihood.
+  double sparse_sequential_kalman_update(
+      const Vector &y,
+      Vector &a,
+      SpdMatrix &P,
+      std::vector<LightKalmanStorage> &storage,
+      const std::vector<bool> &missing,
+      const std::vector<SparseVector> &Z,
+      const Vector &H,
+      const SparseKalmanMatrix &T,
+      const SparseKalmanMatrix &RQR);
+
+  // As above, but with the temporaries held in 'workspace', which is
+  // resized if needed.
+  double sparse_sequential_kalman_update(
+      const Vector &y,
+      Vector &a,
+      SpdMatrix &P,
+      std::vector<LightKalmanStorage> &storage,
+      const std::vector<bool> &missing,
+      const std::vector<SparseVector> &Z,
+      const Vector &H,
+      const SparseKalmanMatrix &T,
+      const SparseKalmanMatrix &RQR,
+      SparseKalmanWorkspace &workspace);
+
+  // The disturbance smoother recursion matching
+  // sparse_sequential_kalman_update.
+  // Args:
+  //   r: On input this is r[t], the scaled state residual for the
+  //     transition from time t to t+1.  On output it is r[t-1].
+  //   storage: The output of sparse_sequential_kalman_update at time
+  //     t.
+  //   Z: The observation matrix rows at time t.
+  //   T: The state transition matrix at time t.
+  void sparse_sequential_disturbance_smoother_update(
+      Vector &r,
+      const std::vector<LightKalmanStorage> &storage,
+      const std::vector<SparseVector> &Z,
+      const SparseKalmanMatrix &T);
+
+  // As above, but with the temporaries held in 'workspace', which is
+  // resized if needed.
+  void sparse_sequential_disturbance_smoother_update(
+      Vector &r,
+      const std::vector<LightKalmanStorage> &storage,
+      const std::vector<SparseVector> &Z,
+      const SparseKalmanMatrix &T,
+      SparseKalmanWorkspace &workspace);
+
 }  // namespace BOOM
 #endif// BOOM_SPARSE_KALMAN_TOOLS_HPP
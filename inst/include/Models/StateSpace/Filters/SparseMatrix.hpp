@@ -76,8 +76,7 @@ namespace BOOM{
    private:
     friend void intrusive_ptr_add_ref(SparseMatrixBlock *m){m->up_count();}
     friend void intrusive_ptr_release(SparseMatrixBlock *m){
-      m->down_count();
-      if(m->ref_count() == 0) delete m;}
+      if(m->down_count() == 0) delete m;}
   };
 
   //======================================================================
@@ -112,10 +111,8 @@ namespace BOOM{
     DenseMatrix * clone() const override {return new DenseMatrix(*this);}
     int nrow() const override {return m_.nrow();}
     int ncol() const override {return m_.ncol();}
-    void multiply(VectorView lhs, const ConstVectorView &rhs) const override {
-      lhs = m_ * rhs; }
-    void Tmult(VectorView lhs, const ConstVectorView &rhs) const override {
-      lhs = m_.Tmult(rhs); }
+    void multiply(VectorView lhs, const ConstVectorView &rhs) const override;
+    void Tmult(VectorView lhs, const ConstVectorView &rhs) const override;
     void multiply_inplace(VectorView x) const override { x = m_ * x;}
     void add_to(SubMatrix block) const override { block += m_; }
     Matrix dense() const override { return m_; }
@@ -133,10 +130,9 @@ namespace BOOM{
     void set_matrix(const SpdMatrix &m){m_ = m;}
     int nrow() const override {return m_.nrow();}
     int ncol() const override {return m_.ncol();}
-    void multiply(VectorView lhs, const ConstVectorView &rhs) const override {
-      lhs = m_ * rhs; }
+    void multiply(VectorView lhs, const ConstVectorView &rhs) const override;
     void Tmult(VectorView lhs, const ConstVectorView &rhs) const override {
-      lhs = m_ * rhs; }
+      multiply(lhs, rhs); }
     void multiply_inplace(VectorView x) const override { x = m_ * x;}
     void add_to(SubMatrix block) const override { block += m_; }
    private:
@@ -352,8 +348,9 @@ namespace BOOM{
     void multiply(VectorView lhs, const ConstVectorView &rhs) const override {
       conforms_to_cols(rhs.size());
       conforms_to_rows(lhs.size());
-      lhs = rhs * 0;
-      lhs[0] = rhs[0] * value_;
+      double tmp = rhs[0];
+      lhs = 0;
+      lhs[0] = tmp * value_;
     }
     void Tmult(VectorView lhs, const ConstVectorView &rhs) const override {
       // An upper left corner matrix is symmetric, so Tmult is the
@@ -633,6 +630,17 @@ namespace BOOM{
 
     virtual Vector Tmult(const Vector &v) const = 0;
 
+    // The following two functions write their output into a
+    // preallocated view, so they can be used in the Kalman recursions
+    // without allocating.  lhs must not overlap rhs.  The default
+    // implementations call the allocating versions above, so child
+    // classes should override them where possible.
+    //
+    // lhs = this * rhs
+    virtual void multiply(VectorView lhs, const ConstVectorView &rhs) const;
+    // lhs = this->transpose() * rhs
+    virtual void Tmult(VectorView lhs, const ConstVectorView &rhs) const;
+
     // Replace the argument P with
     //   this * P * this.transpose()
     // This only works with square matrices.  Non-square matrices will throw.
@@ -688,6 +696,9 @@ namespace BOOM{
     Vector operator*(const ConstVectorView &v) const override;
 
     Vector Tmult(const Vector &r) const override;
+    void multiply(VectorView lhs, const ConstVectorView &rhs) const override;
+    void Tmult(VectorView lhs, const ConstVectorView &rhs) const override;
+
     // P -> this * P * this.transpose()
     void sandwich_inplace(SpdMatrix &P) const override;
     void sandwich_inplace_submatrix(SubMatrix P) const override;
@@ -19,7 +19,8 @@
 #ifndef BOOM_SPARSE_VECTOR_HPP_
 #define BOOM_SPARSE_VECTOR_HPP_
 
-#include <map>
+#include <utility>
+#include <vector>
 #include <boost/shared_ptr.hpp>
 
 #include <LinAlg/Vector.hpp>
@@ -82,14 +83,25 @@ namespace BOOM{
     Vector dense()const;
 
    private:
-    std::map<int, double> elements_;
+    // The nonzero elements, stored contiguously as (position, value)
+    // pairs sorted by position.  Elements are nearly always added in
+    // increasing order (by concatenate() or by filling a new vector
+    // front to back), so a sorted array is cheaper to build than a
+    // tree, and much cheaper to traverse in the Kalman filter.
+    std::vector<std::pair<int, double> > elements_;
     int size_;
     void check_index(int n)const;
+
+    // Sets element n to value, inserting it if necessary.
+    void set_element(int n, double value);
     friend class SparseVectorReturnProxy;
   };
 
   Vector operator*(const SpdMatrix &P, const SparseVector &v);
   Vector operator*(const SubMatrix P, const SparseVector &v);
+
+  // Sets ans = P * v, writing into preallocated space.
+  void multiply(VectorView ans, const SpdMatrix &P, const SparseVector &v);
   ostream & operator<<(ostream &, const SparseVector &v);
 
 }  // namespace BOOM
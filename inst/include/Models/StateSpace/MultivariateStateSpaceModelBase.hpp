@@ -0,0 +1,165 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_MULTIVARIATE_STATE_SPACE_MODEL_BASE_HPP_
+#define BOOM_MULTIVARIATE_STATE_SPACE_MODEL_BASE_HPP_
+
+#include <vector>
+#include <Models/StateSpace/StateSpaceModelBase.hpp>
+#include <Models/StateSpace/Filters/ScalarKalmanStorage.hpp>
+#include <Models/StateSpace/Filters/SparseKalmanTools.hpp>
+#include <Models/StateSpace/Filters/SparseVector.hpp>
+#include <LinAlg/Matrix.hpp>
+#include <LinAlg/Vector.hpp>
+
+namespace BOOM {
+
+  // A state space model describing a panel of time series observed at
+  // the same time points, and sharing a common state vector.  The
+  // observation equation is
+  //
+  //   y[t][j] = Z[t, j].dot(alpha[t]) + epsilon[t][j],
+  //
+  // where j indexes the series, and the epsilon[t][j] are independent
+  // N(0, H[t][j]).  The transition equation is the same as in
+  // StateSpaceModelBase, and is built from the state models passed to
+  // add_state.
+  //
+  // By default every state model contributes to every series, with
+  // coefficient observation_coefficient(series, s).  A state model
+  // that only describes series j should report a coefficient of zero
+  // for the other series.  Models needing a more general observation
+  // matrix can override observation_matrix(t, series).
+  //
+  // Because H[t] is diagonal, the Kalman filter and simulation
+  // smoother process the elements of y[t] one at a time (the
+  // "univariate treatment" of Durbin and Koopman (2001), Section 6.4),
+  // so the cost of a time step is linear in the number of series,
+  // and no matrix of dimension nseries() is ever inverted.  The whole
+  // panel is filtered and smoothed in a single pass by impute_state().
+  //
+  // The scalar filtering functions inherited from StateSpaceModelBase
+  // (filter(), one_step_prediction_errors()) do not apply to
+  // multivariate observations.  Use log_likelihood() instead.
+  class MultivariateStateSpaceModelBase : public StateSpaceModelBase {
+   public:
+    MultivariateStateSpaceModelBase();
+    MultivariateStateSpaceModelBase(
+        const MultivariateStateSpaceModelBase &rhs);
+    MultivariateStateSpaceModelBase * clone() const override = 0;
+
+    // The number of series in the panel.
+    virtual int nseries() const = 0;
+
+    // The variance of y[t][series] given the state at time t.
+    virtual double observation_variance(int t, int series) const = 0;
+
+    // The observed value of y[t][series], after adjusting for any
+    // regression effects not included in the state.  Only called if
+    // is_missing_observation(t, series) is false.
+    virtual double adjusted_observation(int t, int series) const = 0;
+
+    virtual bool is_missing_observation(int t, int series) const = 0;
+
+    // The coefficient multiplying the contribution of state model s
+    // to the mean of 'series'.  The default is 1.0.
+    virtual double observation_coefficient(int series, int s) const;
+
+    // The row of Z[t] describing 'series'.
+    virtual SparseVector observation_matrix(int t, int series) const;
+    using StateSpaceModelBase::observation_matrix;
+
+    // The scalar observation variance and adjusted observation are
+    // not defined for multivariate models.  Calling these functions
+    // is an error.
+    double observation_variance(int t) const override;
+    double adjusted_observation(int t) const override;
+
+    // Returns true if all the series are missing at time t.
+    bool is_missing_observation(int t) const override;
+
+    // Durbin and Koopman's simulation smoother, applied to the full
+    // panel.
+    void impute_state(RNG &rng) override;
+    using StateSpaceModelBase::impute_state;
+
+    double log_likelihood() const override;
+
+   protected:
+    // Returns observation_matrix(t, series) from the cache filled by
+    // impute_state(), so it does not need to be reassembled.  Only
+    // valid for t in the training data while the cache is current,
+    // i.e. during or just after impute_state().  This replaces
+    // StateSpaceModelBase::cached_observation_matrix(t), which is not
+    // filled for multivariate models.
+    const SparseVector &cached_observation_matrix(int t, int series) const {
+      return observation_matrices_[t][series];
+    }
+
+   private:
+    // Fill Z, y, H, and missing with the observation equation at time
+    // t.  Missing elements of y are set to zero.
+    void observation_equation(int t,
+                              std::vector<SparseVector> &Z,
+                              Vector &y,
+                              Vector &H,
+                              std::vector<bool> &missing) const;
+
+    // Steps needed to implement impute_state().
+    void check_kalman_storage(
+        std::vector<std::vector<LightKalmanStorage> > &kalman_storage);
+    void simulate_forward(RNG &rng);
+    void smooth_disturbances();
+    void propagate_disturbances();
+
+    // Filter output for the simulated data (kalman_storage_) and the
+    // observed data (supplemental_kalman_storage_).  Indexed by time,
+    // then by series.
+    std::vector<std::vector<LightKalmanStorage> > kalman_storage_;
+    std::vector<std::vector<LightKalmanStorage> >
+    supplemental_kalman_storage_;
+
+    // Column t is the difference between the smoothed disturbances
+    // r[t] for the observed and simulated data.
+    Matrix disturbance_difference_;
+    Vector initial_disturbance_difference_;
+
+    // Workspace for impute_state.  Once sized, the filter and
+    // smoother recursions do not allocate per time period or series.
+    Vector a_;
+    SpdMatrix P_;
+    Vector supplemental_a_;
+    SpdMatrix supplemental_P_;
+    // observation_matrices_[t][j] is the row of Z[t] for series j,
+    // assembled once per time period by simulate_forward() and reused
+    // by smooth_disturbances().
+    std::vector<std::vector<SparseVector> > observation_matrices_;
+    Vector observed_y_;
+    Vector simulated_y_;
+    Vector observation_variances_;
+    std::vector<bool> missing_;
+    Vector r_sim_;
+    Vector r_obs_;
+    Vector mean_difference_;
+    Vector variance_term_;
+    SparseKalmanWorkspace kalman_workspace_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_MULTIVARIATE_STATE_SPACE_MODEL_BASE_HPP_
@@ -0,0 +1,48 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_STATE_SPACE_PANEL_POSTERIOR_SAMPLER_HPP_
+#define BOOM_STATE_SPACE_PANEL_POSTERIOR_SAMPLER_HPP_
+
+#include <Models/StateSpace/StateSpacePanel.hpp>
+#include <Models/PosteriorSamplers/PosteriorSampler.hpp>
+
+namespace BOOM {
+
+  // Posterior sampler for a StateSpacePanel.  Each draw samples the
+  // observation model of every series and each of the shared state
+  // models using the samplers assigned to them, and then imputes the
+  // state of every series given the new parameters.
+  class StateSpacePanelPosteriorSampler : public PosteriorSampler {
+   public:
+    StateSpacePanelPosteriorSampler(StateSpacePanel *model,
+                                    RNG &seeding_rng = GlobalRng::rng);
+    void draw() override;
+
+    // The sum of the log prior densities of the shared state models
+    // and of the observation model for each series.
+    double logpri() const override;
+
+   private:
+    StateSpacePanel *m_;
+    bool latent_data_initialized_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_STATE_SPACE_PANEL_POSTERIOR_SAMPLER_HPP_
@@ -71,7 +71,10 @@ namespace BOOM{
         const ConstVectorView &error_mean,
         const ConstSubMatrix &error_variance) override;
 
-    void simulate_state_error(VectorView eta, int t) const override;
+    void simulate_state_error(RNG &rng, VectorView eta, int t) const override;
+    void simulate_state_error(VectorView eta, int t) const override {
+      simulate_state_error(GlobalRng::rng, eta, t);
+    }
 
     Ptr<SparseMatrixBlock> state_transition_matrix(int t) const override;
     Ptr<SparseMatrixBlock> state_variance_matrix(int t) const override;
@@ -79,6 +82,8 @@ namespace BOOM{
     Ptr<SparseMatrixBlock> state_error_variance(int t) const override;
 
     SparseVector observation_matrix(int t) const override;
+    bool is_time_invariant() const override {return true;}
+    bool observation_matrix_is_fixed() const override {return true;}
 
     Vector initial_state_mean() const override;
     SpdMatrix initial_state_variance() const override;
@@ -86,7 +86,10 @@ namespace BOOM{
         const ConstVectorView &state_error_mean,
         const ConstSubMatrix &state_error_variance) override;
 
-    void simulate_state_error(VectorView eta, int t) const override;
+    void simulate_state_error(RNG &rng, VectorView eta, int t) const override;
+    void simulate_state_error(VectorView eta, int t) const override {
+      simulate_state_error(GlobalRng::rng, eta, t);
+    }
 
     Ptr<SparseMatrixBlock> state_transition_matrix(int t) const override;
     Ptr<SparseMatrixBlock> state_variance_matrix(int t) const override;
@@ -95,6 +98,7 @@ namespace BOOM{
 
     // The observation matrix is row t of the desing matrix.
     SparseVector observation_matrix(int t) const override;
+    bool observation_matrix_is_fixed() const override {return true;}
 
     // The initial state is the value of the regression coefficients
     // at time 0.  Zero with a big variance is a good guess.
@@ -37,8 +37,11 @@ namespace BOOM{
 
     uint state_dimension() const override;
     uint state_error_dimension() const override {return 1;}
-    void simulate_state_error(VectorView eta, int t)const override;
-    void simulate_initial_state(VectorView eta)const override;
+    void simulate_state_error(RNG &rng, VectorView eta, int t) const override;
+    void simulate_state_error(VectorView eta, int t) const override {
+      simulate_state_error(GlobalRng::rng, eta, t);
+    }
+    void simulate_initial_state(RNG &rng, VectorView eta) const override;
 
     Ptr<SparseMatrixBlock> state_transition_matrix(int t) const override;
     Ptr<SparseMatrixBlock> state_variance_matrix(int t) const override;
@@ -46,6 +49,8 @@ namespace BOOM{
     Ptr<SparseMatrixBlock> state_error_variance(int t) const override;
 
     SparseVector observation_matrix(int t)const override;
+    bool is_time_invariant() const override {return true;}
+    bool observation_matrix_is_fixed() const override {return true;}
 
     Vector initial_state_mean()const override;
     SpdMatrix initial_state_variance()const override;
@@ -55,8 +60,6 @@ namespace BOOM{
     void set_initial_state_variance(const SpdMatrix &v);
     void set_initial_state_variance(double v);
 
-    void set_sigsq(double sigsq) override;
-
     void update_complete_data_sufficient_statistics(
         int t,
         const ConstVectorView &state_error_mean,
@@ -67,6 +70,10 @@ namespace BOOM{
     Ptr<ConstantMatrix> state_variance_matrix_;
     Vector initial_state_mean_;
     SpdMatrix initial_state_variance_;
+
+    // Keeps state_variance_matrix_ in sync with sigsq(), however the
+    // parameter is set.
+    void observe_sigsq() {state_variance_matrix_->set_value(sigsq());}
   };
 
 }
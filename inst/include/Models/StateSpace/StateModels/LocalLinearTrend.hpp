@@ -41,7 +41,10 @@ namespace BOOM{
     uint state_dimension() const override {return 2;}
     uint state_error_dimension() const override {return 2;}
 
-    void simulate_state_error(VectorView eta, int t) const override;
+    void simulate_state_error(RNG &rng, VectorView eta, int t) const override;
+    void simulate_state_error(VectorView eta, int t) const override {
+      simulate_state_error(GlobalRng::rng, eta, t);
+    }
 
     Ptr<SparseMatrixBlock> state_transition_matrix(int t) const override;
     Ptr<SparseMatrixBlock> state_variance_matrix(int t) const override;
@@ -49,13 +52,14 @@ namespace BOOM{
     Ptr<SparseMatrixBlock> state_error_variance(int t) const override;
 
     SparseVector observation_matrix(int t) const override;
+    bool is_time_invariant() const override {return true;}
+    bool observation_matrix_is_fixed() const override {return true;}
 
     Vector initial_state_mean() const override;
     void set_initial_state_mean(const Vector &v);
     SpdMatrix initial_state_variance() const override;
     void set_initial_state_variance(const SpdMatrix &V);
 
-    void set_Sigma(const SpdMatrix &sigma) override;
     void update_complete_data_sufficient_statistics(
         int t,
         const ConstVectorView &state_error_mean,
@@ -64,12 +68,25 @@ namespace BOOM{
    private:
     void check_dim(const ConstVectorView &)const;
 
+    // Keeps state_variance_matrix_ and state_error_cholesky_ in sync
+    // with Sigma(), however it is changed (set_Sigma, set_siginv, or
+    // unvectorize_params).
+    void observe_Sigma();
+
     SparseVector observation_matrix_;
     Ptr<LocalLinearTrendMatrix> state_transition_matrix_;
     Ptr<DenseSpd> state_variance_matrix_;
     Ptr<IdentityMatrix> state_error_expander_;
     Vector initial_state_mean_;
     SpdMatrix initial_state_variance_;
+
+    // The lower Cholesky triangle of Sigma(), used to simulate the
+    // state error without allocating.  Empty if Sigma() is not
+    // positive definite.
+    Matrix state_error_cholesky_;
+
+    // Workspace for observe_state.
+    Vector state_error_;
   };
 
 
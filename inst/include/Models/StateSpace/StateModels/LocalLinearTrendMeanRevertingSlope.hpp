@@ -97,13 +97,18 @@ namespace BOOM{
         const ConstVectorView &state_error_mean,
         const ConstSubMatrix &state_error_variance) override;
 
-    void simulate_state_error(VectorView eta, int t) const override;
+    void simulate_state_error(RNG &rng, VectorView eta, int t) const override;
+    void simulate_state_error(VectorView eta, int t) const override {
+      simulate_state_error(GlobalRng::rng, eta, t);
+    }
     Ptr<SparseMatrixBlock> state_transition_matrix(int t) const override;
     Ptr<SparseMatrixBlock> state_variance_matrix(int t) const override;
     Ptr<SparseMatrixBlock> state_error_expander(int t) const override;
     Ptr<SparseMatrixBlock> state_error_variance(int t) const override;
 
     SparseVector observation_matrix(int t) const override;
+    bool is_time_invariant() const override {return true;}
+    bool observation_matrix_is_fixed() const override {return true;}
     Vector initial_state_mean() const override;
     SpdMatrix initial_state_variance() const override;
 
@@ -112,7 +117,7 @@ namespace BOOM{
     void set_initial_slope_mean(double slope_mean);
     void set_initial_slope_sd(double slope_sd);
 
-    void simulate_initial_state(VectorView state)const override;
+    void simulate_initial_state(RNG &rng, VectorView state) const override;
 
    private:
     void check_dim(const ConstVectorView &) const;
@@ -59,6 +59,7 @@ namespace BOOM {
     //   time_zero: The date at t = 0, where t is an integer number of
     //     days.
     RandomWalkHolidayStateModel(Holiday *holiday, const Date &time_zero);
+    RandomWalkHolidayStateModel(const RandomWalkHolidayStateModel &rhs);
     RandomWalkHolidayStateModel * clone() const override;
     void observe_state(const ConstVectorView then,
                        const ConstVectorView now,
@@ -68,7 +69,10 @@ namespace BOOM {
     uint state_error_dimension() const override {
       return 1;
     }
-    void simulate_state_error(VectorView eta, int t) const override;
+    void simulate_state_error(RNG &rng, VectorView eta, int t) const override;
+    void simulate_state_error(VectorView eta, int t) const override {
+      simulate_state_error(GlobalRng::rng, eta, t);
+    }
 
     Ptr<SparseMatrixBlock> state_transition_matrix(int t) const override;
     Ptr<SparseMatrixBlock> state_variance_matrix(int t) const override;
@@ -83,8 +87,6 @@ namespace BOOM {
         const ConstVectorView &state_error_mean,
         const ConstSubMatrix &state_error_variance) override;
 
-    void set_sigsq(double sigsq) override;
-
     void set_initial_state_mean(const Vector &v);
     void set_initial_state_variance(const SpdMatrix &Sigma);
     void set_time_zero(const Date &time_zero);
@@ -100,6 +102,9 @@ namespace BOOM {
 
     std::vector<Ptr<SingleSparseDiagonalElementMatrix> >
     active_state_variance_matrix_;
+
+    // Keeps active_state_variance_matrix_ in sync with sigsq().
+    void observe_sigsq();
   };
 
 }  // namespace BOOM
@@ -51,7 +51,10 @@ namespace BOOM{
                        int t) override;
     uint state_dimension() const override;
     uint state_error_dimension() const override {return 1;}
-    void simulate_state_error(VectorView eta, int t) const override;
+    void simulate_state_error(RNG &rng, VectorView eta, int t) const override;
+    void simulate_state_error(VectorView eta, int t) const override {
+      simulate_state_error(GlobalRng::rng, eta, t);
+    }
 
     Ptr<SparseMatrixBlock> state_transition_matrix(int t) const override;
     Ptr<SparseMatrixBlock> state_variance_matrix(int t) const override;
@@ -59,7 +62,10 @@ namespace BOOM{
     Ptr<SparseMatrixBlock> state_error_variance(int t) const override;
     SparseVector observation_matrix(int t) const override;
 
-    void set_sigsq(double sigsq) override; // also resets model matrices
+    // Seasons lasting more than one time period alternate between the
+    // 'new season' and 'season interior' model matrices.
+    bool is_time_invariant() const override {return duration_ == 1;}
+    bool observation_matrix_is_fixed() const override {return true;}
 
     // If the time series does not start at t0 then you establish the
     // time of the first observation with this function.
@@ -107,6 +113,10 @@ namespace BOOM{
     SpdMatrix initial_state_variance_;
     // state is (s[t], s[t-1], ... s[t-nseasons_])  ...
     // contribution to y[t] is s[t] (i.e. Z = (1,0,0,0,...)  )
+
+    // Resets the model matrices that depend on sigsq().  Called
+    // whenever the variance parameter changes.
+    void observe_sigsq();
   };
 
 }
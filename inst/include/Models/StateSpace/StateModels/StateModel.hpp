@@ -19,6 +19,7 @@
 */
 
 #include <Models/ModelTypes.hpp>
+#include <distributions/rng.hpp>
 #include <LinAlg/VectorView.hpp>
 #include <Models/StateSpace/Filters/SparseVector.hpp>
 #include <Models/StateSpace/Filters/SparseMatrix.hpp>
@@ -89,6 +90,24 @@ namespace BOOM{
     virtual void simulate_state_error(VectorView eta, int t) const = 0;
     virtual void simulate_initial_state(VectorView eta) const;
 
+    // Versions of the simulate_ functions that draw random numbers
+    // from 'rng', so that several state space models can be simulated
+    // at once on different threads.  The state space model classes
+    // call these versions.
+    //
+    // By default simulate_state_error ignores 'rng' and calls the
+    // version above, so subclasses that only implement that version
+    // still work (using the global RNG).  Subclasses that are safe to
+    // simulate on several threads override this version, and
+    // implement the one above by passing it GlobalRng::rng.
+    //
+    // simulate_initial_state draws from initial_state_mean() and
+    // initial_state_variance() by default.  The version above calls
+    // this one with GlobalRng::rng, so subclasses with a special
+    // initial state distribution should override this version.
+    virtual void simulate_state_error(RNG &rng, VectorView eta, int t) const;
+    virtual void simulate_initial_state(RNG &rng, VectorView eta) const;
+
     virtual Ptr<SparseMatrixBlock> state_transition_matrix(int t) const = 0;
 
     // The state_variance_matrix has state_dimension rows and columns.
@@ -110,6 +129,21 @@ namespace BOOM{
     //  a different API for that case anyway.
     virtual SparseVector observation_matrix(int t) const = 0;
 
+    // Returns true if state_transition_matrix(t),
+    // state_variance_matrix(t), and observation_matrix(t) do not
+    // depend on t.  The Kalman filter uses this to decide whether it
+    // may stop updating P once the Kalman gain has converged.  The
+    // default is the conservative 'false', so models with
+    // time-varying structure need not override it.
+    virtual bool is_time_invariant() const {return false;}
+
+    // Returns true if observation_matrix(t) is a fixed function of t,
+    // unaffected by the model parameters or by later calls to
+    // add_data.  The state space model uses this to decide whether
+    // it may assemble observation matrices once and cache them.
+    // The default is the conservative 'false'.
+    virtual bool observation_matrix_is_fixed() const {return false;}
+
     virtual Vector initial_state_mean()const = 0;
     virtual SpdMatrix initial_state_variance()const = 0;
 
@@ -80,9 +80,14 @@ namespace BOOM{
     // The state error simulation is conditional on the value of the
     // latent variance weights.  It needs to be that way so that
     // latent data imputation can work properly.
-    void simulate_state_error(VectorView eta, int t) const override;
-    void simulate_marginal_state_error(VectorView eta, int t) const;
-    void simulate_conditional_state_error(VectorView eta, int t) const;
+    void simulate_state_error(RNG &rng, VectorView eta, int t) const override;
+    void simulate_state_error(VectorView eta, int t) const override {
+      simulate_state_error(GlobalRng::rng, eta, t);
+    }
+    void simulate_marginal_state_error(
+        RNG &rng, VectorView eta, int t) const;
+    void simulate_conditional_state_error(
+        RNG &rng, VectorView eta, int t) const;
 
     Ptr<SparseMatrixBlock> state_transition_matrix(int t) const override;
     Ptr<SparseMatrixBlock> state_variance_matrix(int t) const override;
@@ -93,6 +98,7 @@ namespace BOOM{
     Ptr<SparseMatrixBlock> state_error_variance(int t) const override;
 
     SparseVector observation_matrix(int t) const override;
+    bool observation_matrix_is_fixed() const override {return true;}
 
     Vector initial_state_mean() const override;
     void set_initial_state_mean(const Vector &v);
@@ -141,6 +147,9 @@ namespace BOOM{
     const Vector & latent_level_weights() const;
     const Vector & latent_slope_weights() const;
 
+    // Seeds the generator used to draw the latent weights.
+    void set_seed(unsigned long seed) {rng_.seed(seed);}
+
    private:
     void check_dim(const ConstVectorView &) const;
 
@@ -162,6 +171,12 @@ namespace BOOM{
     GammaSuf slope_weight_sufficient_statistics_;
 
     StateModel::Behavior behavior_;
+
+    // The latent weights are drawn in observe_state(), which has no
+    // RNG argument.  Each copy of the model has its own generator, so
+    // that the copies owned by different series in a StateSpacePanel
+    // can impute their state on different threads.
+    RNG rng_;
   };
 
 }  // namespace BOOM
@@ -61,7 +61,10 @@ namespace BOOM {
         const ConstVectorView &state_error_mean,
         const ConstSubMatrix &state_error_variance) override;
 
-    void simulate_state_error(VectorView eta, int t) const override;
+    void simulate_state_error(RNG &rng, VectorView eta, int t) const override;
+    void simulate_state_error(VectorView eta, int t) const override {
+      simulate_state_error(GlobalRng::rng, eta, t);
+    }
 
     Ptr<SparseMatrixBlock> state_transition_matrix(int t) const override {
       return state_transition_matrix_;
@@ -81,6 +84,7 @@ namespace BOOM {
     }
 
     SparseVector observation_matrix(int t)const override;
+    bool observation_matrix_is_fixed() const override {return true;}
 
     Vector initial_state_mean()const override;
     void set_initial_state_mean(const Vector &v);
@@ -107,6 +111,9 @@ namespace BOOM {
 
     Vector initial_state_mean_;
     SpdMatrix initial_state_variance_;
+
+    // Workspace for observe_state.
+    Vector state_error_;
   };
 
 }  // namespace BOOM
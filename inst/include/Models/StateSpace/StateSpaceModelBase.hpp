@@ -21,6 +21,7 @@
 #include <Models/StateSpace/Filters/SparseVector.hpp>
 #include <Models/StateSpace/Filters/SparseMatrix.hpp>
 #include <Models/StateSpace/Filters/ScalarKalmanStorage.hpp>
+#include <Models/StateSpace/Filters/SparseKalmanTools.hpp>
 #include <Models/StateSpace/PosteriorSamplers/SufstatManager.hpp>
 #include <Models/Policies/CompositeParamPolicy.hpp>
 #include <LinAlg/Matrix.hpp>
@@ -73,7 +74,14 @@ namespace BOOM{
     // vector from the model.  (2) Subtract the expected value of the
     // state given the simulated y and add the expected value of the
     // state given the observed y.
-    virtual void impute_state();
+    //
+    // The simulation draws from 'rng'.  Separate models with
+    // separate RNG's may impute their state concurrently, provided
+    // they do not share state models.  (Latent variables drawn by a
+    // state model in observe_state() come from the state model's own
+    // generator.)
+    virtual void impute_state(RNG &rng);
+    void impute_state() {impute_state(GlobalRng::rng);}
 
     // The 'observe_state' functions compute the contribution to the
     // complete data sufficient statistics (for the observation and
@@ -115,13 +123,41 @@ namespace BOOM{
     // less than full rank.
     virtual const SparseKalmanMatrix * state_variance_matrix(int t) const;
 
-    double log_likelihood() const;
+    // Returns true if T[t], RQR[t], and Z[t] do not depend on t, in
+    // which case the Kalman filter can stop updating P once it
+    // reaches its steady state.  The default implementation checks
+    // is_time_invariant() on each state model.  Subclasses that
+    // override the model matrices should override this as well.
+    virtual bool model_matrices_are_time_invariant() const;
+
+    // Returns true if observation_matrix(t) is a fixed function of t,
+    // in which case the observation matrices for the training data
+    // are assembled once and reused by every subsequent call to
+    // impute_state() and filter().  The default implementation
+    // checks observation_matrix_is_fixed() on each state model.
+    // Subclasses that override observation_matrix() should override
+    // this as well.
+    virtual bool observation_matrices_are_fixed() const;
+
+    // Discards the cached observation matrices, so they will be
+    // rebuilt on next use.  The cache notices changes in the state
+    // models and in time_dimension() on its own.  This is for callers
+    // that modify the inputs to a state model's observation_matrix()
+    // in some other way.
+    void invalidate_observation_matrices() {
+      observation_matrices_are_current_ = false;
+    }
+
+    virtual double log_likelihood() const;
 
     // filter() evaluates log likelihood and computes the final values
     // a[t+1] and P[t+1] needed for future forecasting.
     const ScalarKalmanStorage & filter() const;
 
-    virtual void simulate_initial_state(VectorView v) const;
+    virtual void simulate_initial_state(RNG &rng, VectorView v) const;
+    virtual void simulate_initial_state(VectorView v) const {
+      simulate_initial_state(GlobalRng::rng, v);
+    }
     virtual Vector simulate_initial_state() const;
 
     // Simulates the value of the state vector for the current time
@@ -131,18 +167,29 @@ namespace BOOM{
     //   last:  Value of state at time t-1.
     //   next:  VectorView to be filled with state at time t.
     //   t:  The time index of 'next'.
-    void simulate_next_state(const ConstVectorView last,
+    void simulate_next_state(RNG &rng,
+                             const ConstVectorView last,
                              VectorView next,
                              int t) const;
+    void simulate_next_state(const ConstVectorView last,
+                             VectorView next,
+                             int t) const {
+      simulate_next_state(GlobalRng::rng, last, next, t);
+    }
     Vector simulate_next_state(const Vector &current_state, int t) const;
 
     // Simulates the error for the state at time t+1.  (Using the
     // notation of Durbin and Koopman, this uses the model matrices
     // indexed as t.)
     //
-    // Returns a vector of size state_dimension().  If the model
-    // matrices are not full rank then some elements of this vector
-    // will be deterministic functions of other elements.
+    // The simulated error is written to 'eta', which must have size
+    // state_dimension().  If the model matrices are not full rank
+    // then some elements of eta will be deterministic functions of
+    // other elements.
+    virtual void simulate_state_error(RNG &rng, VectorView eta, int t) const;
+    void simulate_state_error(VectorView eta, int t) const {
+      simulate_state_error(GlobalRng::rng, eta, t);
+    }
     virtual Vector simulate_state_error(int t) const;
 
     // Parameters of initial state distribution, specified in the
@@ -223,6 +270,27 @@ namespace BOOM{
     // implementation for observe_data_given_state.
     void signal_complete_data_change(int t);
 
+    // Ensure that the state matrix is large enough to hold the
+    // results of impute_state().
+    void resize_state();
+
+    // Subclasses that provide their own version of impute_state()
+    // write the imputed state here.
+    Matrix &mutable_state() {return state_;}
+
+    // Returns observation_matrix(t) from the cache used by the Kalman
+    // filter, so it does not need to be reassembled.  This is intended
+    // for observe_data_given_state(), and is only valid for t in the
+    // training data while the cache is current, i.e. during
+    // impute_state() or observe_fixed_state().
+    //
+    // Not valid for MultivariateStateSpaceModelBase, whose
+    // impute_state() does not fill this cache.  Multivariate models
+    // use cached_observation_matrix(t, series) instead.
+    const SparseVector &cached_observation_matrix(int t) const {
+      return observation_matrices_[t];
+    }
+
    private:
     void check_kalman_storage(std::vector<LightKalmanStorage> &);
     void initialize_final_kalman_storage() const;
@@ -236,10 +304,10 @@ namespace BOOM{
     void signal_complete_data_reset();
 
     // These are the steps needed to implement impute_state().
-    void resize_state();
-    void simulate_forward();
-    double simulate_adjusted_observation(int t);
-    Vector smooth_disturbances(std::vector<LightKalmanStorage> &);
+    void simulate_forward(RNG &rng);
+    double simulate_adjusted_observation(RNG &rng, int t);
+    void smooth_disturbances(std::vector<LightKalmanStorage> &kalman_storage,
+                             Vector &r0);
     void propagate_disturbances(const Vector &r0_plus,
                                 const Vector &r0_hat,
                                 bool observe = true);
@@ -276,6 +344,34 @@ namespace BOOM{
     SpdMatrix supplemental_P_;
     std::vector<LightKalmanStorage> supplemental_kalman_storage_;
 
+    // Ensures observation_matrices_[t] == observation_matrix(t) for
+    // each t in the training data.  If observation_matrices_are_fixed()
+    // the matrices are only rebuilt when the cache has been
+    // invalidated, otherwise they are rebuilt on every call.
+    void update_observation_matrices() const;
+
+    // observation_matrices_[t] holds observation_matrix(t), so it is
+    // only assembled once per time period per call to impute_state()
+    // or filter().  If the observation matrices are fixed it is
+    // assembled once per time period, period.
+    mutable std::vector<SparseVector> observation_matrices_;
+    mutable bool observation_matrices_are_current_;
+
+    // Scratch space for the Kalman recursions and the simulation
+    // smoother.  Sized on first use, after which impute_state() and
+    // filter() do not allocate on a per-time-period basis.
+    mutable SparseKalmanWorkspace kalman_workspace_;
+
+    // Detect and exploit steady state Kalman gains.  The supplemental
+    // filter in impute_state() needs its own copy, because it
+    // converges along with, but separately from, the main filter.
+    mutable SteadyStateKalmanFilter steady_state_filter_;
+    SteadyStateKalmanFilter supplemental_steady_state_filter_;
+    Vector r0_sim_;
+    Vector r0_obs_;
+    Vector state_mean_difference_;
+    mutable Vector state_error_workspace_;
+
     // final_kalman_storage_ holds the output of the Kalman filter.
     // It is for situations where we don't need to store the whole
     // filter, so the name 'final' refers to the fact that it is the
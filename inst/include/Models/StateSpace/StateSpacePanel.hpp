@@ -0,0 +1,136 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_STATE_SPACE_PANEL_HPP_
+#define BOOM_STATE_SPACE_PANEL_HPP_
+
+#include <functional>
+#include <vector>
+#include <Models/StateSpace/StateSpaceModelBase.hpp>
+#include <Models/StateSpace/StateModels/StateModel.hpp>
+#include <Models/Policies/CompositeParamPolicy.hpp>
+#include <Models/Policies/NullDataPolicy.hpp>
+#include <Models/Policies/PriorPolicy.hpp>
+#include <cpputil/ThreadTools.hpp>
+#include <distributions/rng.hpp>
+
+namespace BOOM {
+
+  // A collection of independent time series, each described by its
+  // own state space model, whose state models share a common set of
+  // parameters.  Each series keeps its own data and its own
+  // observation model.  State model s of every series is a copy of
+  // shared_state_model(s): it has the same structure, and its
+  // parameters are overwritten with those of the shared model by
+  // distribute_shared_parameters().
+  //
+  // impute_state() runs the simulation smoother on each series,
+  // concurrently if set_nthreads() has been called, and then has the
+  // shared state models observe the imputed state of every series.
+  // The shared state models therefore hold the complete data
+  // sufficient statistics for the whole panel, and can be sampled
+  // (using whatever posterior samplers the caller has assigned to
+  // them) exactly as if they belonged to a single series.  The
+  // StateSpacePanelPosteriorSampler puts these steps together.
+  //
+  // Each series is imputed on a worker thread using that worker's
+  // RNG, and the observation models are sampled using their own
+  // samplers' RNG's, so the series must not share state with one
+  // another, and their state models must not draw from GlobalRng
+  // while observing the state (StudentLocalLinearTrendStateModel
+  // does).
+  class StateSpacePanel
+      : public CompositeParamPolicy,
+        public NullDataPolicy,
+        public PriorPolicy {
+   public:
+    StateSpacePanel();
+
+    // Shared state models and series are cloned.  Threads are not
+    // copied.
+    StateSpacePanel(const StateSpacePanel &rhs);
+    StateSpacePanel * clone() const override;
+
+    // Add the model for the next component of state.  Shared state
+    // models must all be added before any series is added.  The
+    // posterior sampler for the shared model sees the complete data
+    // from every series.
+    void add_shared_state(Ptr<StateModel> state_model);
+    int nstate() const {return shared_state_models_.size();}
+    Ptr<StateModel> shared_state_model(int s) {
+      return shared_state_models_[s];}
+    const Ptr<StateModel> shared_state_model(int s) const {
+      return shared_state_models_[s];}
+
+    // Add a series to the panel.  The series must have one state
+    // model for each shared state model, of the same type and
+    // dimension, in the same order.  The parameters of its state
+    // models are set to those of the shared state models.  The
+    // observation model of the series must have its own posterior
+    // sampler.
+    void add_series(Ptr<StateSpaceModelBase> series);
+    int number_of_series() const {return series_.size();}
+    Ptr<StateSpaceModelBase> series(int i) {return series_[i];}
+    const Ptr<StateSpaceModelBase> series(int i) const {return series_[i];}
+
+    // Process the series using n worker threads.  Each worker gets an
+    // RNG split from 'seeding_rng', so for a given number of threads
+    // the results do not depend on thread scheduling.  With n <= 1
+    // the series are processed serially in the calling thread.
+    void set_nthreads(int n, RNG &seeding_rng = GlobalRng::rng);
+    int nthreads() const {return worker_rngs_.size();}
+
+    // Copy the parameters of the shared state models to the
+    // corresponding state models of each series.
+    void distribute_shared_parameters();
+
+    // Impute the state of every series given the current parameters,
+    // and accumulate the complete data sufficient statistics for the
+    // shared state models.  When running serially all random numbers
+    // come from 'rng'.  Threaded runs use the worker RNG's instead.
+    void impute_state(RNG &rng);
+
+    // Draw the parameters of each series' observation model given its
+    // complete data.
+    void sample_observation_posteriors();
+
+    // The sum of the log likelihoods of the series.
+    double log_likelihood() const;
+
+   private:
+    void check_series(const Ptr<StateSpaceModelBase> &series) const;
+
+    // Calls f(i, worker) for each series i, where 'worker' indexes
+    // the worker thread that handles series i.  Worker w handles
+    // every nthreads()'th series, starting with w, which keeps the
+    // load balanced when long and short series are mixed.
+    void for_each_series(const std::function<void(int, int)> &f) const;
+
+    // Have the shared state models observe the imputed state of each
+    // series.
+    void observe_shared_state();
+
+    std::vector<Ptr<StateModel> > shared_state_models_;
+    std::vector<Ptr<StateSpaceModelBase> > series_;
+    std::vector<RNG> worker_rngs_;
+    mutable ThreadWorkerPool pool_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_STATE_SPACE_PANEL_HPP_
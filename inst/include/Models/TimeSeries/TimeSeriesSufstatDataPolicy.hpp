@@ -52,6 +52,7 @@ namespace BOOM{
     virtual void add_data_point(Ptr<DataPointType> d);
     virtual void add_data(Ptr<Data> d);
     virtual void clear_data();
+    virtual void combine_data(const Model &m, bool just_suf=true);
 
     using Base::dat;
 
@@ -72,6 +73,14 @@ namespace BOOM{
     for(uint i=0; i<d.size(); ++i) suf_->update(d[i]);
   }
 
+  template<class D, class TS, class S>
+  void TimeSeriesSufstatDataPolicy<D,TS,S>::combine_data(const Model &m,
+                                                         bool just_suf){
+    const DataPolicy & other(dynamic_cast<const DataPolicy &>(m));
+    suf_->combine(other.suf_);
+    if(!just_suf) Base::combine_data(m, just_suf);
+  }
+
   template<class D, class TS, class S>
   TimeSeriesSufstatDataPolicy<D,TS,S>::TimeSeriesSufstatDataPolicy(const TimeSeriesSufstatDataPolicy &rhs)
     : Model(rhs),
@@ -36,7 +36,7 @@ namespace BOOM{
 
     friend void intrusive_ptr_add_ref(MH_Proposal *s) {s->up_count();}
     friend void intrusive_ptr_release(MH_Proposal *s) {
-      s->down_count(); if(s->ref_count() == 0) delete s;}
+      if(s->down_count() == 0) delete s;}
 
   };
   // ======================================================================
@@ -110,7 +110,7 @@ namespace BOOM{
 
     friend void intrusive_ptr_add_ref(MH_ScalarProposal *s) {s->up_count();}
     friend void intrusive_ptr_release(MH_ScalarProposal *s) {
-      s->down_count(); if(s->ref_count() == 0) delete s;}
+      if(s->down_count() == 0) delete s;}
   };
   // ----------------------------------------------------------------------
   class TScalarMhProposal : public MH_ScalarProposal{
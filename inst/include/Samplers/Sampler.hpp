@@ -43,7 +43,7 @@ namespace BOOM {
     RNG & rng()const;
     friend void intrusive_ptr_add_ref(SamplerBase *s){s->up_count();}
     friend void intrusive_ptr_release(SamplerBase *s){
-      s->down_count(); if(s->ref_count()==0) delete s;}
+      if(s->down_count() == 0) delete s;}
     void set_rng(RNG *r, bool owns_rng=true);
    private:
     mutable RNG *rng_;
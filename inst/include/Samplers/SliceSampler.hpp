@@ -28,7 +28,7 @@ namespace BOOM{
 
   class SliceSampler : public Sampler{
   public:
-    SliceSampler(Func F, bool unimodal=false);
+    SliceSampler(Func F, bool unimodal=false, RNG *rng = 0);
     Vector draw(const Vector &x) override;
 
   private:
@@ -0,0 +1,253 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_CPPUTIL_DRAW_FILE_HPP_
+#define BOOM_CPPUTIL_DRAW_FILE_HPP_
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <Models/ParamTypes.hpp>
+
+namespace BOOM {
+
+  // Binary files holding MCMC draws of a collection of parameters.
+  //
+  // The file begins with a header describing the parameters (a name
+  // and a dimension for each), followed by the draws.  The draws are
+  // grouped into chunks of a fixed number of iterations.  Within a
+  // chunk, the draws of each parameter are stored contiguously, one
+  // parameter after another, with each draw occupying 'dimension'
+  // consecutive values.  Every chunk but the last is full, so the
+  // location of any (iteration, parameter) pair can be computed
+  // directly from the header.  Values are stored as either double or
+  // float, in the byte order of the machine that wrote the file.
+  //
+  // Parameters are stored in their non-minimal vectorized form
+  // (Params::vectorize(false)), which has a fixed size.
+  namespace DrawFileIO {
+
+    enum ValueType {DOUBLE_VALUES = 0, FLOAT_VALUES = 1};
+
+    // The header of a draw file, and the arithmetic for finding
+    // values in the body.
+    class Layout {
+     public:
+      Layout();
+      Layout(ValueType value_type, int iterations_per_chunk, int thin);
+
+      // Add a parameter with the given name and dimension.
+      void add_parameter(const std::string &name, int dimension);
+
+      // The header is written in full when writing starts, which fixes
+      // header_size().  Later calls to write_number_of_draws()
+      // overwrite the draw count in place.
+      void write(std::ostream &out);
+      void write_number_of_draws(std::ostream &out) const;
+
+      // Parse a header written by write().  Reports an error if the
+      // input is not a draw file.
+      void read(std::istream &in);
+
+      ValueType value_type() const {return value_type_;}
+      int value_size() const;
+      int iterations_per_chunk() const {return iterations_per_chunk_;}
+      int thin() const {return thin_;}
+
+      std::int64_t number_of_draws() const {return number_of_draws_;}
+      void set_number_of_draws(std::int64_t n) {number_of_draws_ = n;}
+
+      int number_of_parameters() const {return names_.size();}
+      const std::string &name(int parameter) const {return names_[parameter];}
+      int dimension(int parameter) const {return dimensions_[parameter];}
+
+      // The position of the named parameter, or -1 if there is no
+      // parameter with that name.
+      int parameter_index(const std::string &name) const;
+
+      // The number of bytes in the header, including the padding that
+      // aligns the body to a multiple of 64 bytes.
+      std::int64_t header_size() const {return header_size_;}
+
+      // The byte offset (from the start of the file) of the first
+      // value of the given chunk.
+      std::int64_t chunk_offset(std::int64_t chunk) const;
+
+      // The number of draws stored in the given chunk.
+      int chunk_size(std::int64_t chunk) const;
+
+      // The byte offset of the first value of 'parameter' in the draw
+      // at position 'iteration'.
+      std::int64_t value_offset(std::int64_t iteration, int parameter) const;
+
+      // The byte offset of the first value of 'parameter' in the
+      // given chunk, when that chunk holds 'draws_in_chunk' draws.
+      std::int64_t block_offset(std::int64_t chunk, int parameter,
+                                int draws_in_chunk) const;
+
+     private:
+      ValueType value_type_;
+      int iterations_per_chunk_;
+      int thin_;
+      std::int64_t number_of_draws_;
+      std::vector<std::string> names_;
+      std::vector<int> dimensions_;
+
+      // values_before_[p] is the total dimension of parameters
+      // 0..p-1.  The last element is the total dimension of all
+      // parameters.
+      std::vector<std::int64_t> values_before_;
+      std::int64_t header_size_;
+    };
+
+  }  // namespace DrawFileIO
+
+  // Streams MCMC draws to a draw file as the sampler runs.  Only one
+  // chunk of draws is held in memory, so memory use is bounded by
+  // iterations_per_chunk * (total parameter dimension) values no
+  // matter how long the chain is.
+  //
+  // The idiom for using this class is
+  //   DrawFileWriter writer("draws.bin");
+  //   writer.add_parameter(model->coef_prm(), "beta");
+  //   writer.add_parameter(model->Sigsq_prm(), "sigsq");
+  //   for (int i = 0; i < niter; ++i) {
+  //     model->sample_posterior();
+  //     writer.write();
+  //   }
+  //   writer.close();   // Or let the destructor do it.
+  class DrawFileWriter {
+   public:
+    // Args:
+    //   filename: The name of the file to create.  An existing file
+    //     with the same name is overwritten.
+    //   iterations_per_chunk: The number of draws to buffer before
+    //     writing to disk.
+    //   thin: Only every thin'th call to write() records a draw.
+    //   value_type: FLOAT_VALUES halves the size of the file (and of
+    //     the buffer), at the cost of storing the draws in single
+    //     precision.
+    explicit DrawFileWriter(
+        const std::string &filename,
+        int iterations_per_chunk = 100,
+        int thin = 1,
+        DrawFileIO::ValueType value_type = DrawFileIO::DOUBLE_VALUES);
+
+    // Flushes and closes the file.
+    ~DrawFileWriter();
+
+    DrawFileWriter(const DrawFileWriter &rhs) = delete;
+    DrawFileWriter & operator=(const DrawFileWriter &rhs) = delete;
+
+    // Add a parameter to the set of parameters being written.  All
+    // parameters must be added before the first call to write().
+    void add_parameter(const Ptr<Params> &parameter, const std::string &name);
+
+    // Record the current values of the parameters, subject to
+    // thinning.
+    void write();
+
+    // Write buffered draws to disk, and update the draw count in the
+    // header, so that a reader opened now will see every draw
+    // recorded so far.  The buffer is kept, so a partially filled
+    // chunk is rewritten in full once it fills up.
+    void flush();
+
+    // Flush, and close the file.  No further writing is possible.
+    void close();
+
+    // The number of draws recorded (i.e. after thinning) so far.
+    std::int64_t number_of_draws() const {return layout_.number_of_draws();}
+
+   private:
+    void start_writing();
+    void write_buffer();
+
+    std::string filename_;
+    DrawFileIO::Layout layout_;
+    std::vector<Ptr<Params> > parameters_;
+
+    // buffers_[p] holds the buffered draws of parameter p, one after
+    // another.
+    std::vector<std::vector<double> > buffers_;
+    std::vector<float> float_workspace_;
+
+    // The number of draws in the buffer, and the number of calls to
+    // write() since the last recorded draw.
+    int buffered_draws_;
+    int calls_since_last_draw_;
+
+    std::ofstream output_;
+    bool started_;
+    bool closed_;
+  };
+
+  // Replays the draws in a draw file, one at a time, into a set of
+  // parameters.  Only the chunk containing the current draw is held
+  // in memory, and only for the parameters that have been added to
+  // the reader.
+  //
+  //   DrawFileReader reader("draws.bin");
+  //   reader.add_parameter(model->coef_prm(), "beta");
+  //   for (int i = 0; i < reader.number_of_draws(); ++i) {
+  //     reader.stream();
+  //     ... use model ...
+  //   }
+  class DrawFileReader {
+   public:
+    explicit DrawFileReader(const std::string &filename);
+
+    // Replay the draws of the named parameter in the file into
+    // 'parameter'.  It is an error if no parameter of that name
+    // exists in the file, or if its dimension does not match.
+    void add_parameter(const Ptr<Params> &parameter, const std::string &name);
+
+    const DrawFileIO::Layout &layout() const {return layout_;}
+    std::int64_t number_of_draws() const {return layout_.number_of_draws();}
+
+    // Reset the reader so that the next call to stream() reads the
+    // first draw.
+    void rewind();
+
+    // Set the values of the parameters to the next draw in the file.
+    void stream();
+
+    // Set the values of the parameters to the draw at the given
+    // position.
+    void seek(std::int64_t iteration);
+
+   private:
+    void read_chunk(std::int64_t chunk);
+
+    DrawFileIO::Layout layout_;
+    std::ifstream input_;
+    std::vector<Ptr<Params> > parameters_;
+    std::vector<int> file_positions_;
+
+    // The values of each added parameter in the current chunk.
+    std::vector<std::vector<double> > buffers_;
+    std::vector<float> float_workspace_;
+    Vector workspace_;
+    std::int64_t current_chunk_;
+    std::int64_t next_iteration_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_CPPUTIL_DRAW_FILE_HPP_
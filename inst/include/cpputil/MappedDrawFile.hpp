@@ -0,0 +1,134 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_CPPUTIL_MAPPED_DRAW_FILE_HPP_
+#define BOOM_CPPUTIL_MAPPED_DRAW_FILE_HPP_
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include <LinAlg/Vector.hpp>
+#include <LinAlg/VectorView.hpp>
+#include <Models/ParamTypes.hpp>
+#include <cpputil/DrawFile.hpp>
+
+namespace BOOM {
+
+  // Read-only, random access to a draw file written by
+  // DrawFileWriter.  The file is mapped into memory rather than read,
+  // so opening it is cheap no matter how many draws it holds, pages
+  // are loaded by the operating system only when they are touched,
+  // and they are shared by every thread reading the file.
+  //
+  // A MappedDrawFile is safe to read from many threads at once.  To
+  // replay draws into a model, each thread creates its own
+  // MappedDrawFile::Cursor bound to its own copy of the model's
+  // parameters, and works on its own range of iterations:
+  //
+  //   MappedDrawFile draws("draws.bin");
+  //   std::vector<std::pair<std::int64_t, std::int64_t>> ranges =
+  //       draws.iteration_ranges(number_of_threads);
+  //   std::vector<std::function<void()>> tasks;
+  //   for (int i = 0; i < ranges.size(); ++i) {
+  //     Ptr<Model> model = models[i];  // One clone per thread.
+  //     std::pair<std::int64_t, std::int64_t> range = ranges[i];
+  //     tasks.push_back([&draws, model, range]() {
+  //         MappedDrawFile::Cursor cursor(draws);
+  //         cursor.add_parameter(model->..., "beta");
+  //         for (std::int64_t it = range.first; it < range.second; ++it) {
+  //           cursor.read(it);
+  //           ... forecast using model ...
+  //         }
+  //       });
+  //   }
+  //   pool.run(tasks);
+  //
+  // Files are mapped with mmap where it is available.  On Windows
+  // the file is read into memory instead.
+  class MappedDrawFile {
+   public:
+    explicit MappedDrawFile(const std::string &filename);
+    ~MappedDrawFile();
+
+    MappedDrawFile(const MappedDrawFile &rhs) = delete;
+    MappedDrawFile & operator=(const MappedDrawFile &rhs) = delete;
+
+    const DrawFileIO::Layout &layout() const {return layout_;}
+    std::int64_t number_of_draws() const {return layout_.number_of_draws();}
+
+    // The position of the named parameter in the file.  Reports an
+    // error if there is no such parameter.
+    int parameter_index(const std::string &name) const;
+
+    // A view of the stored values of 'parameter' at the given
+    // iteration, pointing directly into the mapped file.  Only
+    // available for files storing doubles.
+    ConstVectorView values(std::int64_t iteration, int parameter) const;
+
+    // Copy the values of 'parameter' at the given iteration into
+    // 'ans', converting from float if needed.  'ans' must have the
+    // dimension of the parameter.
+    void copy_values(std::int64_t iteration, int parameter,
+                     VectorView ans) const;
+
+    // Split the iterations [begin, end) into 'number_of_ranges'
+    // contiguous ranges of nearly equal size.  An 'end' of -1 means
+    // number_of_draws().  Empty ranges are omitted.
+    std::vector<std::pair<std::int64_t, std::int64_t> > iteration_ranges(
+        int number_of_ranges, std::int64_t begin = 0,
+        std::int64_t end = -1) const;
+
+    // Replays draws from a MappedDrawFile into a set of parameters.
+    // Cursors are cheap, and are not shared between threads.
+    class Cursor {
+     public:
+      explicit Cursor(const MappedDrawFile &file);
+
+      // Draws of the named parameter will be written to 'parameter'.
+      void add_parameter(const Ptr<Params> &parameter,
+                         const std::string &name);
+
+      // Set each added parameter to its value at the given iteration.
+      void read(std::int64_t iteration);
+
+     private:
+      const MappedDrawFile *file_;
+      std::vector<Ptr<Params> > parameters_;
+      std::vector<int> file_positions_;
+      Vector workspace_;
+    };
+
+   private:
+    const char *value_address(std::int64_t iteration, int parameter) const;
+    void check_iteration(std::int64_t iteration) const;
+
+    DrawFileIO::Layout layout_;
+
+    // The start of the file contents, and its size in bytes.
+    const char *data_;
+    std::size_t size_;
+
+#ifdef _WIN32
+    std::vector<char> contents_;
+#endif
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_CPPUTIL_MAPPED_DRAW_FILE_HPP_
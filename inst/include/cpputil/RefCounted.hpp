@@ -19,49 +19,53 @@
 #ifndef BOOM_REF_COUNTED_HPP
 #define BOOM_REF_COUNTED_HPP
 
-#ifndef NO_BOOST_THREADS
-#include <boost/thread/mutex.hpp>
-#include <boost/thread/locks.hpp>
-#endif
+#include <atomic>
 
 namespace BOOM{
 
-#ifdef NO_BOOST_THREADS
-#define BOOM_LOCK(MUTEX)
-#else
-#define BOOM_LOCK(MUTEX) boost::lock_guard<boost::mutex> lock(MUTEX)
-#endif
-
+  // An intrusive reference count for use with Ptr.  The count is an
+  // atomic integer, so copies of a Ptr can be made and destroyed in
+  // different threads without a lock.
+  //
+  // The idiom for using this class is
+  //   friend void intrusive_ptr_add_ref(Thing *t){t->up_count();}
+  //   friend void intrusive_ptr_release(Thing *t){
+  //     if(t->down_count() == 0) delete t;}
+  //
+  // Testing ref_count() after a separate call to down_count() is not
+  // safe, because another thread could release its reference in
+  // between.
   class RefCounted{
-    unsigned int cnt_;
-#ifndef NO_BOOST_THREADS
-    boost::mutex ref_count_mutex_;
-#endif
+    std::atomic<unsigned int> cnt_;
   public:
     RefCounted(): cnt_(0){}
-    RefCounted(const RefCounted &)
-  : cnt_(0)
-#ifndef NO_BOOST_THREADS
-  , ref_count_mutex_()
-#endif
-    {}
+    RefCounted(const RefCounted &) : cnt_(0) {}
 
     // If this object is assigned a new value, nothing is done to the
     // reference count, so assignment is a no-op.
     RefCounted & operator=(const RefCounted &rhs) { return *this; }
 
     virtual ~RefCounted(){}
+
+    // Acquiring a reference imposes no ordering constraints, because
+    // a thread can only copy a pointer it already holds.
     void up_count(){
-      BOOM_LOCK(ref_count_mutex_);
-      ++cnt_;
+      cnt_.fetch_add(1, std::memory_order_relaxed);
     }
-    void down_count(){
-      BOOM_LOCK(ref_count_mutex_);
-      --cnt_;
+
+    // Returns the reference count after the decrement.  The release
+    // half of the ordering makes this thread's writes to the object
+    // visible before the count drops, and the acquire half makes all
+    // such writes visible to the thread that sees zero and deletes
+    // the object.
+    unsigned int down_count(){
+      return cnt_.fetch_sub(1, std::memory_order_acq_rel) - 1;
+    }
+
+    unsigned int ref_count()const{
+      return cnt_.load(std::memory_order_relaxed);
     }
-    unsigned int ref_count()const{return cnt_;}
   };
 
-#undef BOOM_LOCK
 }
 #endif // BOOM_REF_COUNTED_HPP
@@ -0,0 +1,108 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_CPPUTIL_THREAD_TOOLS_HPP_
+#define BOOM_CPPUTIL_THREAD_TOOLS_HPP_
+
+#include <deque>
+#include <exception>
+#include <functional>
+#include <vector>
+
+#ifndef _WIN32
+// Support for std::thread is not yet available on the version of
+// MinGW used by CRAN.  On that platform the pool runs all of its
+// tasks in the calling thread.
+// TODO(stevescott): Remove the ugly conditional macros once CRAN can
+// support this part of C++11.
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace BOOM {
+
+  // A pool of long-lived worker threads.  Threads are created when
+  // the size of the pool is set, and then park on a condition
+  // variable until work is submitted.  This avoids the cost of
+  // creating and destroying threads each time a parallel job is run,
+  // which matters when the job is one step of an MCMC iteration that
+  // will be repeated many thousands of times.
+  //
+  // The idiom for using this class is
+  //   ThreadWorkerPool pool(number_of_threads);
+  //   std::vector<std::function<void()>> tasks;
+  //   ... fill tasks ...
+  //   pool.run(tasks);  // Blocks until all the tasks have finished.
+  //
+  // A pool with zero threads is legal.  It runs its tasks serially in
+  // the calling thread.
+  class ThreadWorkerPool {
+   public:
+    explicit ThreadWorkerPool(int number_of_threads = 0);
+    ~ThreadWorkerPool();
+
+    // The pool owns threads, so copying does not make sense.
+    ThreadWorkerPool(const ThreadWorkerPool &rhs) = delete;
+    ThreadWorkerPool & operator=(const ThreadWorkerPool &rhs) = delete;
+
+    // Set the number of threads in the pool to n.  If n is smaller
+    // than the current number then the existing threads are shut
+    // down once they finish their current task.  This function must
+    // not be called while a job is being run.
+    void set_number_of_threads(int n);
+    int number_of_threads() const;
+
+    // Distribute the tasks across the threads in the pool, and block
+    // until all tasks have finished.  If there is at most one task,
+    // or the pool is empty, the tasks are run in the calling thread.
+    //
+    // If one or more tasks throws an exception, the first exception
+    // to be thrown is rethrown here after all the tasks have
+    // finished.
+    void run(const std::vector<std::function<void()>> &tasks);
+
+   private:
+    // The loop executed by each thread in the pool.  Threads wait for
+    // tasks to appear in the queue, run them, and then wait again.
+    void worker_loop();
+    void shut_down();
+
+    // Record the exception currently being handled, if it is the
+    // first one seen by the current job.
+    void record_exception();
+
+#ifndef _WIN32
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable work_available_;
+    std::condition_variable work_finished_;
+#endif
+
+    // Tasks that have been submitted but not yet started.
+    std::deque<const std::function<void()> *> queue_;
+
+    // The number of tasks in the current job that have not finished.
+    int pending_;
+    bool shutting_down_;
+    std::exception_ptr first_exception_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_CPPUTIL_THREAD_TOOLS_HPP_
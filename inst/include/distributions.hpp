@@ -22,6 +22,7 @@
 #include <LinAlg/Vector.hpp>
 #include <LinAlg/Matrix.hpp>
 #include <LinAlg/SpdMatrix.hpp>
+#include <LinAlg/Cholesky.hpp>
 
 #include <distributions/Rmath_dist.hpp>
 #include <distributions/rng.hpp>
@@ -162,6 +163,16 @@ namespace BOOM {
   int random_int(int lo, int hi);
   int random_int_mt(RNG & rng, int lo, int hi);
 
+  // Batched draws.  Each fills every element of 'out' with an
+  // independent draw, computing any per-distribution constants once
+  // for the whole batch.  Normal and exponential draws use the
+  // Ziggurat method.  The gamma draws have unit scale (rate 1), so
+  // divide by the rate if another is needed.
+  void rnorm_mt(RNG &rng, VectorView out);
+  void runif_mt(RNG &rng, VectorView out);
+  void rexp_mt(RNG &rng, VectorView out);
+  void rgamma_mt(RNG &rng, double shape, VectorView out);
+
 
   // basic rmvn checks the cholesky decomposition, if there is a
   // problem it calls rmvn_robust
@@ -180,6 +191,10 @@ namespace BOOM {
 
   Vector rmvn_robust_mt(RNG & rng, const Vector &Mu, const SpdMatrix &Sigma);
   Vector rmvn_L_mt(RNG & rng, const Vector &mu, const Matrix &L);
+  // Fills 'out' with a draw from the zero-mean multivariate normal
+  // with variance L * L^T, where L is lower triangular.  The draw is
+  // made in place, without allocating.
+  void rmvn_L_mt(RNG &rng, const Matrix &L, VectorView out);
   Vector rmvn_ivar_mt(RNG & rng, const Vector &Mu,
                       const SpdMatrix &Sigma_Inverse);
   Vector rmvn_ivar_L_mt(RNG & rng, const Vector &Mu, const Matrix &Ivar_chol);
@@ -187,6 +202,12 @@ namespace BOOM {
                         const Matrix &Ivar_chol_transpose);
   Vector rmvn_suf_mt(RNG & rng, const SpdMatrix & Ivar, const Vector & IvarMu);
 
+  // Versions of rmvn_ivar_mt and rmvn_suf_mt that take the Cholesky
+  // decomposition of the inverse variance matrix, so that a caller
+  // needing both the posterior mean and a draw (or several draws)
+  // only factors the precision matrix once.
+  Vector rmvn_ivar_mt(RNG & rng, const Vector &Mu, const Chol &Ivar_chol);
+  Vector rmvn_suf_mt(RNG & rng, const Chol & Ivar_chol, const Vector & IvarMu);
 
   double dmvn(const Vector &y, const Vector &mu, const SpdMatrix &Siginv,
               double ldsi, bool logscale);
@@ -194,6 +215,12 @@ namespace BOOM {
                         double ldsi, bool logscale);
   double dmvn(const Vector &y, const Vector &mu, const SpdMatrix &Siginv,
               bool logscale);
+  // Evaluates the density using the Cholesky decomposition of Siginv,
+  // which supplies both the log determinant and the Mahalanobis
+  // distance.  Returns negative infinity (or zero) if Siginv was not
+  // positive definite.
+  double dmvn(const Vector &y, const Vector &mu, const Chol &Siginv_chol,
+              bool logscale);
 
   // Y~ matrix_normal(Mu, Siginv, Ominv) if
   // Vector(Y) ~ N(Vector(Mu), (Siginv \otimes Ominv)^{-1})
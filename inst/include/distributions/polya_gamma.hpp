@@ -0,0 +1,58 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_DISTRIBUTIONS_POLYA_GAMMA_HPP_
+#define BOOM_DISTRIBUTIONS_POLYA_GAMMA_HPP_
+
+#include <distributions/rng.hpp>
+
+namespace BOOM {
+
+  // The Polya-Gamma distribution PG(b, z) of Polson, Scott and Windle
+  // (2013, JASA), which is the distribution of
+  //
+  //   (1 / (2 pi^2)) * sum_k g_k / ((k - 1/2)^2 + z^2 / (4 pi^2)),
+  //
+  // where the g_k are independent Gamma(b, 1) variables.  If omega ~
+  // PG(n, x'beta) then, conditional on omega, the logistic regression
+  // likelihood for y successes in n trials is proportional to a
+  // Gaussian likelihood for (y - n/2) / omega with mean x'beta and
+  // precision omega.
+
+  // The mean and variance of PG(b, z).
+  double polya_gamma_mean(double b, double z);
+  double polya_gamma_variance(double b, double z);
+
+  // A random draw from PG(b, z), for b > 0.  The integer part of b is
+  // handled exactly, by summing draws from PG(1, z) using Devroye's
+  // alternating series method, whose acceptance probability is above
+  // 0.9992 for every z.  Any fractional part of b is drawn from the
+  // sum of gammas representation, truncated after 200 terms, with the
+  // mean of the remaining terms added back.  The cost is linear in b,
+  // so callers with large b should consider
+  // rpolya_gamma_normal_approximation_mt instead.
+  double rpolya_gamma_mt(RNG &rng, double b, double z);
+
+  // A draw from the normal distribution with the mean and variance of
+  // PG(b, z), truncated to be positive.  This is accurate when b is
+  // large, and its cost does not depend on b.
+  double rpolya_gamma_normal_approximation_mt(RNG &rng, double b, double z);
+
+}  // namespace BOOM
+
+#endif  // BOOM_DISTRIBUTIONS_POLYA_GAMMA_HPP_
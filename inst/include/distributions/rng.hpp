@@ -19,10 +19,73 @@
 #ifndef BOOM_DISTRIBUTIONS_RNG_HPP
 #define BOOM_DISTRIBUTIONS_RNG_HPP
 
+#include <cstdint>
 #include <boost/random/ranlux.hpp>
 
 namespace BOOM{
+
+// The xoshiro256++ generator of Blackman and Vigna (2019).  It is
+// several times faster per draw than ranlux64_base_01, has a period
+// of 2^256 - 1, and supports jumping ahead 2^128 steps in constant
+// time.
+//
+// Like ranlux64_base_01, operator() returns a double.  Draws are
+// strictly inside (0, 1), so callers can safely take logs.
+class Xoshiro256PlusPlus {
+ public:
+  typedef double result_type;
+
+  explicit Xoshiro256PlusPlus(unsigned long seed = 8675309) {
+    this->seed(seed);
+  }
+
+  // Fill the state from 'seed' using splitmix64, as recommended by
+  // the authors of xoshiro.
+  void seed(unsigned long seed);
+
+  double operator()() {
+    return ((next() >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+  }
+
+  // Returns the next 64 random bits.
+  uint64_t next() {
+    const uint64_t result = rotl(state_[0] + state_[3], 23) + state_[0];
+    const uint64_t t = state_[1] << 17;
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = rotl(state_[3], 45);
+    return result;
+  }
+
+  // Set the state from 256 bits taken from another generator.  Each
+  // word is scrambled with the splitmix64 finalizer, so the new
+  // state is unrelated to the position the bits were drawn from.
+  void seed(const uint64_t (&bits)[4]);
+
+  // Advance the generator by 2^128 draws.
+  void jump();
+
+  static constexpr double min() {return 0.0;}
+  static constexpr double max() {return 1.0;}
+
+ private:
+  static uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+  uint64_t state_[4];
+};
+
+// The generator used throughout BOOM.  Compiling with
+// -DBOOM_RNG_RANLUX restores the old ranlux64_base_01 generator,
+// e.g. to reproduce results from earlier versions.
+#ifdef BOOM_RNG_RANLUX
 typedef boost::random::ranlux64_base_01 RNG;
+#else
+typedef Xoshiro256PlusPlus RNG;
+#endif
 
 struct GlobalRng{
  public:
@@ -33,6 +96,30 @@ struct GlobalRng{
 unsigned long seed_rng();  // generates a random seed from the global RNG
                            // used to seed other RNG's
 unsigned long seed_rng(RNG &);
+
+// Returns a generator for a worker (e.g. another thread or chain)
+// whose stream will not overlap the stream used by 'parent'.  With
+// xoshiro the child's 256 bit state is a hash of the next four
+// outputs of 'parent' (which advances by four draws), so the child
+// starts at an effectively random point in the 2^256 period.  Unlike
+// handing the child parent's position and jumping the parent ahead,
+// this stays safe when splits are nested (chains, then samplers,
+// then workers).  With ranlux the child is seeded from parent using
+// seed_rng.
+RNG split_rng(RNG &parent);
+
+// Returns 64 random bits from 'rng'.  Samplers that need both a
+// uniform and a small integer (e.g. the Ziggurat layer index) can
+// take both from a single call.
+inline uint64_t random_bits(RNG &rng) {
+#ifdef BOOM_RNG_RANLUX
+  uint64_t high = static_cast<uint64_t>(rng() * 4294967296.0);
+  uint64_t low = static_cast<uint64_t>(rng() * 4294967296.0);
+  return (high << 32) | low;
+#else
+  return rng.next();
+#endif
+}
 }
 
 #endif// BOOM_DISTRIBUTIONS_RNG_HPP
@@ -190,6 +190,16 @@ namespace Rmath{
   double        unif_rand(BOOM::RNG &);
   double        exp_rand(BOOM::RNG &);
 
+  /* Ziggurat samplers (see ziggurat.cpp).  The *_fill forms write n
+     draws to x[0], x[stride], ..., x[(n-1)*stride]. */
+  double        norm_rand_ziggurat(BOOM::RNG &);
+  double        exp_rand_ziggurat(BOOM::RNG &);
+  void          norm_rand_fill(BOOM::RNG &, double *x, int n, int stride);
+  void          exp_rand_fill(BOOM::RNG &, double *x, int n, int stride);
+  void          unif_rand_fill(BOOM::RNG &, double *x, int n, int stride);
+  void          rgamma_fill(BOOM::RNG &, double shape, double *x, int n,
+                            int stride);
+
   /* Normal Distribution */
 
 // #define pnorm pnorm5
@@ -56,7 +56,8 @@ typedef enum {
     BOX_MULLER,
     USER_NORM,
     INVERSION,
-    KINDERMAN_RAMAGE
+    KINDERMAN_RAMAGE,
+    ZIGGURAT
 } N01type;
 
 
@@ -56,7 +56,7 @@ namespace Rmath{
 
 static PLATFORM_THREAD_LOCAL double BM_norm_keep = 0.0;
 
-N01type N01_kind = KINDERMAN_RAMAGE;
+N01type N01_kind = ZIGGURAT;
 
 #ifndef MATHLIB_STANDALONE
 typedef void * (*DL_FUNC)();
@@ -77,7 +77,7 @@ extern DL_FUNC  User_norm_fun; /* declared and set in ../main/RNG.c */
 double norm_rand(BOOM::RNG & rng)
 {
 
-    const double a[32] =
+    static const double a[32] =
     {
         0.0000000, 0.03917609, 0.07841241, 0.1177699,
         0.1573107, 0.19709910, 0.23720210, 0.2776904,
@@ -89,7 +89,7 @@ double norm_rand(BOOM::RNG & rng)
         1.5341210, 1.67594000, 1.86273200, 2.1538750
     };
 
-    const double d[31] =
+    static const double d[31] =
     {
         0.0000000, 0.0000000, 0.0000000, 0.0000000,
         0.0000000, 0.2636843, 0.2425085, 0.2255674,
@@ -101,7 +101,7 @@ double norm_rand(BOOM::RNG & rng)
         0.1134023, 0.1114027, 0.1095039
     };
 
-    const double t[31] =
+    static const double t[31] =
     {
         7.673828e-4, 0.002306870, 0.003860618, 0.005438454,
         0.007050699, 0.008708396, 0.010423570, 0.012209530,
@@ -113,7 +113,7 @@ double norm_rand(BOOM::RNG & rng)
         0.227624100, 0.330498000, 0.584703100
     };
 
-    const double h[31] =
+    static const double h[31] =
     {
         0.03920617, 0.03932705, 0.03950999, 0.03975703,
         0.04007093, 0.04045533, 0.04091481, 0.04145507,
@@ -138,7 +138,7 @@ double norm_rand(BOOM::RNG & rng)
 #define C2              0.180025191068563
 #define g(x)            (C1*exp(-x*x/2.0)-C2*(A-x))
 
-    const double A =  2.216035867166471;
+    static const double A =  2.216035867166471;
 
     double s, u1, w, y, u2, u3, aa, tt, theta, R;
     int i;
@@ -283,6 +283,8 @@ double norm_rand(BOOM::RNG & rng)
         u1 = rng();
         u1 = (int)(BIG*u1) + rng();
         return qnorm(u1/BIG, 0.0, 1.0, 1, 0);
+    case ZIGGURAT: /* see ziggurat.cpp */
+        return norm_rand_ziggurat(rng);
     case KINDERMAN_RAMAGE: /* see Reference above */
         /* corrected version from Josef Leydold
          * */
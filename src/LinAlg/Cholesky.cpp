@@ -19,6 +19,7 @@
 #include <cpputil/report_error.hpp>
 #include <sstream>
 #include <LinAlg/Vector.hpp>
+#include <LinAlg/blas.hpp>
 
 extern "C"{
   /*  DPOTRF computes the Cholesky factorization of a real symmetric
@@ -129,6 +130,24 @@ namespace BOOM{
       return ans;
     }
 
+    Vector Chol::LTsolve(const Vector &z)const{
+      check();
+      Vector ans(z);
+      int n = dcmp.nrow();
+      blas::dtrsv(blas::Lower, blas::Trans, blas::NonUnit, n,
+                  dcmp.data(), n, ans.data(), 1);
+      return ans;
+    }
+
+    double Chol::quadratic_form(const Vector &x)const{
+      check();
+      Vector ltx(x);
+      int n = dcmp.nrow();
+      blas::dtrmv(blas::Lower, blas::Trans, blas::NonUnit, n,
+                  dcmp.data(), n, ltx.data(), 1);
+      return ltx.normsq();
+    }
+
     // returns the log of the determinant of A
     double Chol::logdet()const{
       ConstVectorView d(diag(dcmp));
@@ -168,4 +187,37 @@ namespace BOOM{
       ans *= a;
       return ans;
     }
+
+    void cholesky_rank_one_update(SubMatrix L, VectorView x){
+      int n = L.nrow();
+      for(int j = 0; j < n; ++j){
+        double Ljj = L(j, j);
+        double r = std::sqrt(Ljj * Ljj + x[j] * x[j]);
+        double c = r / Ljj;
+        double s = x[j] / Ljj;
+        L(j, j) = r;
+        for(int i = j + 1; i < n; ++i){
+          L(i, j) = (L(i, j) + s * x[i]) / c;
+          x[i] = c * x[i] - s * L(i, j);
+        }
+      }
+    }
+
+    bool cholesky_rank_one_downdate(SubMatrix L, VectorView x){
+      int n = L.nrow();
+      for(int j = 0; j < n; ++j){
+        double Ljj = L(j, j);
+        double rsq = (Ljj - x[j]) * (Ljj + x[j]);
+        if(!(rsq > 0)) return false;
+        double r = std::sqrt(rsq);
+        double c = r / Ljj;
+        double s = x[j] / Ljj;
+        L(j, j) = r;
+        for(int i = j + 1; i < n; ++i){
+          L(i, j) = (L(i, j) - s * x[i]) / c;
+          x[i] = c * x[i] - s * L(i, j);
+        }
+      }
+      return true;
+    }
 }
@@ -182,10 +182,7 @@ namespace BOOM{
     std::swap(V, rhs.V); }
 
   Matrix & Matrix::randomize() {
-    uint n = nr_ * nc_;
-    for (uint i=0; i<n; ++i) {
-      V[i] = runif (0,1);
-    }
+    runif_mt(GlobalRng::rng, VectorView(V));
     return *this;
   }
 
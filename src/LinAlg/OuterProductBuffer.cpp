@@ -0,0 +1,67 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include <LinAlg/OuterProductBuffer.hpp>
+#include <LinAlg/blas.hpp>
+#include <cpputil/report_error.hpp>
+#include <cmath>
+
+namespace BOOM {
+
+  OuterProductBuffer::OuterProductBuffer(int capacity)
+      : capacity_(capacity),
+        size_(0)
+  {
+    if (capacity_ < 1) {
+      report_error("OuterProductBuffer capacity must be positive.");
+    }
+  }
+
+  void OuterProductBuffer::add(const ConstVectorView &x, double w,
+                               SpdMatrix &target) {
+    if (w < 0) {
+      target.add_outer(x, w, false);
+      return;
+    }
+    const int dim = x.size();
+    if (w == 0 || dim == 0) return;
+    if (columns_.nrow() != dim) {
+      flush(target);
+      columns_ = Matrix(dim, capacity_);
+    }
+    const double scale = std::sqrt(w);
+    double *column = columns_.data() + size_ * dim;
+    const double *data = x.data();
+    const int stride = x.stride();
+    for (int i = 0; i < dim; ++i) column[i] = scale * data[i * stride];
+    if (++size_ == capacity_) flush(target);
+  }
+
+  void OuterProductBuffer::flush(SpdMatrix &target) {
+    if (size_ == 0) return;
+    const int dim = columns_.nrow();
+    if (target.nrow() != dim) {
+      report_error("OuterProductBuffer::flush was passed a target of "
+                   "the wrong size.");
+    }
+    blas::dsyrk(blas::Upper, blas::NoTrans, dim, size_, 1.0,
+                columns_.data(), dim, 1.0, target.data(), dim);
+    size_ = 0;
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,219 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include <LinAlg/SparseCrossProductMatrix.hpp>
+#include <algorithm>
+#include <cpputil/report_error.hpp>
+
+namespace BOOM {
+
+  namespace {
+    typedef SparseCrossProductMatrix SCPM;
+  }  // namespace
+
+  SCPM::SparseCrossProductMatrix(int dim, int buffer_capacity)
+      : dim_(dim),
+        buffer_capacity_(buffer_capacity)
+  {
+    if (dim < 0 || buffer_capacity < 1) {
+      report_error("SparseCrossProductMatrix needs a non-negative "
+                   "dimension and a positive buffer capacity.");
+    }
+  }
+
+  std::size_t SCPM::nonzeros() const {
+    flush();
+    return keys_.size();
+  }
+
+  void SCPM::clear() {
+    keys_.clear();
+    values_.clear();
+    pending_.clear();
+  }
+
+  void SCPM::push(int i, int j, double value) {
+    pending_.push_back(std::make_pair(key(i, j), value));
+    if (pending_.size() >= buffer_capacity_) flush();
+  }
+
+  void SCPM::add_outer(const int *index, const double *values, int nnz,
+                       double w) {
+    for (int a = 0; a < nnz; ++a) {
+      if (index[a] < 0 || index[a] >= dim_) {
+        report_error("Index out of range in "
+                     "SparseCrossProductMatrix::add_outer.");
+      }
+      double wx = w * values[a];
+      for (int b = 0; b <= a; ++b) {
+        push(index[a], index[b], wx * values[b]);
+      }
+    }
+  }
+
+  void SCPM::add_outer(const ConstVectorView &x, double w) {
+    if (x.size() != dim_) {
+      report_error("Wrong size vector passed to "
+                   "SparseCrossProductMatrix::add_outer.");
+    }
+    std::vector<int> index;
+    std::vector<double> values;
+    for (int i = 0; i < x.size(); ++i) {
+      if (x[i] != 0.0) {
+        index.push_back(i);
+        values.push_back(x[i]);
+      }
+    }
+    add_outer(index.data(), values.data(), index.size(), w);
+  }
+
+  void SCPM::add(const SparseCrossProductMatrix &rhs) {
+    if (rhs.dim_ != dim_) {
+      report_error("SparseCrossProductMatrix dimensions do not match.");
+    }
+    rhs.flush();
+    pending_.reserve(pending_.size() + rhs.keys_.size());
+    for (std::size_t k = 0; k < rhs.keys_.size(); ++k) {
+      pending_.push_back(std::make_pair(rhs.keys_[k], rhs.values_[k]));
+    }
+    flush();
+  }
+
+  double SCPM::operator()(int i, int j) const {
+    flush();
+    std::uint64_t k = key(i, j);
+    std::vector<std::uint64_t>::const_iterator it =
+        std::lower_bound(keys_.begin(), keys_.end(), k);
+    if (it == keys_.end() || *it != k) return 0.0;
+    return values_[it - keys_.begin()];
+  }
+
+  Vector SCPM::diag() const {
+    flush();
+    Vector ans(dim_, 0.0);
+    for (std::size_t k = 0; k < keys_.size(); ++k) {
+      int j = keys_[k] / dim_;
+      if (keys_[k] - std::uint64_t(j) * dim_ == j) {
+        ans[j] = values_[k];
+      }
+    }
+    return ans;
+  }
+
+  SpdMatrix SCPM::select(const Selector &inc) const {
+    if (inc.nvars_possible() != dim_) {
+      report_error("Selector has the wrong size in "
+                   "SparseCrossProductMatrix::select.");
+    }
+    flush();
+    int q = inc.nvars();
+    SpdMatrix ans(q, 0.0);
+    for (int c = 0; c < q; ++c) {
+      int j = inc.indx(c);
+      std::uint64_t column_start = std::uint64_t(j) * dim_;
+      std::size_t k = std::lower_bound(keys_.begin(), keys_.end(),
+                                       column_start) - keys_.begin();
+      // Elements of column j have keys column_start + i, for i <= j.
+      for (; k < keys_.size() && keys_[k] <= column_start + j; ++k) {
+        int i = keys_[k] - column_start;
+        if (inc[i]) {
+          int r = inc.INDX(i);
+          ans(r, c) = values_[k];
+          ans(c, r) = values_[k];
+        }
+      }
+    }
+    return ans;
+  }
+
+  SpdMatrix SCPM::dense() const {
+    flush();
+    SpdMatrix ans(dim_, 0.0);
+    for (std::size_t k = 0; k < keys_.size(); ++k) {
+      int j = keys_[k] / dim_;
+      int i = keys_[k] - std::uint64_t(j) * dim_;
+      ans(i, j) = values_[k];
+      ans(j, i) = values_[k];
+    }
+    return ans;
+  }
+
+  Vector SCPM::vectorize() const {
+    flush();
+    Vector ans;
+    ans.reserve(1 + 2 * keys_.size());
+    ans.push_back(keys_.size());
+    for (std::size_t k = 0; k < keys_.size(); ++k) {
+      ans.push_back(keys_[k]);
+      ans.push_back(values_[k]);
+    }
+    return ans;
+  }
+
+  Vector::const_iterator SCPM::unvectorize(Vector::const_iterator &v) {
+    clear();
+    std::size_t nonzeros = std::size_t(*v);
+    ++v;
+    keys_.reserve(nonzeros);
+    values_.reserve(nonzeros);
+    for (std::size_t k = 0; k < nonzeros; ++k) {
+      keys_.push_back(std::uint64_t(*v));
+      ++v;
+      values_.push_back(*v);
+      ++v;
+    }
+    return v;
+  }
+
+  // Sorts the pending elements, sums any with the same key, and merges
+  // them with the stored elements.  The merge costs
+  // O(nonzeros() + pending), so the buffer should be large relative to
+  // the typical number of elements added between reads.
+  void SCPM::flush() const {
+    if (pending_.empty()) return;
+    std::sort(pending_.begin(), pending_.end());
+    std::vector<std::uint64_t> keys;
+    std::vector<double> values;
+    keys.reserve(keys_.size() + pending_.size());
+    values.reserve(keys_.size() + pending_.size());
+    std::size_t old = 0;
+    std::size_t k = 0;
+    while (old < keys_.size() || k < pending_.size()) {
+      std::uint64_t next;
+      if (k == pending_.size()
+          || (old < keys_.size() && keys_[old] <= pending_[k].first)) {
+        next = keys_[old];
+      } else {
+        next = pending_[k].first;
+      }
+      double value = 0;
+      if (old < keys_.size() && keys_[old] == next) {
+        value += values_[old++];
+      }
+      while (k < pending_.size() && pending_[k].first == next) {
+        value += pending_[k++].second;
+      }
+      keys.push_back(next);
+      values.push_back(value);
+    }
+    keys_.swap(keys);
+    values_.swap(values);
+    pending_.clear();
+  }
+
+}  // namespace BOOM
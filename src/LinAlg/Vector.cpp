@@ -153,20 +153,15 @@ namespace BOOM{
   Vector Vector::one()const{ return Vector(size(), 1.0);}
 
   Vector & Vector::randomize(){
-    uint n = size();
-    double *d(data());
-    for(uint i=0; i<n; ++i) d[i] = runif(0,1);
+    runif_mt(GlobalRng::rng, VectorView(*this));
     return *this;
   }
 
   Vector & Vector::randomize_with_intercept(){
     uint n = size();
     if (n > 0) {
-      double *d(data());
-      d[0] = 1.0;
-      for (uint i = 1; i < n; ++i) {
-        d[i] = runif(0,1);
-      }
+      runif_mt(GlobalRng::rng, VectorView(*this, 1));
+      (*this)[0] = 1.0;
     }
     return *this;
   }
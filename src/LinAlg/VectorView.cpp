@@ -131,9 +131,7 @@ namespace BOOM{
   }
 
   void VV::randomize(){
-    uint n = size();
-    double *d = data();
-    for(uint i=0; i<n; ++i) d[i] = runif(0,1);
+    runif_mt(GlobalRng::rng, *this);
   }
 
   VV & VV::operator+=(const double & x){
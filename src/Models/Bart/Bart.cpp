@@ -20,8 +20,10 @@
 #include <iterator>
 #include <cmath>
 #include <cstdlib>
+#include <limits>
 
 #include <Models/Bart/Bart.hpp>
+#include <Models/Bart/FlatForest.hpp>
 #include <Models/Bart/ResidualRegressionData.hpp>
 #include <cpputil/math_utils.hpp>
 #include <cpputil/report_error.hpp>
@@ -67,6 +69,20 @@ namespace BOOM {
       return *it;
     }
 
+    // Returns the empirical quantiles of sorted_values at
+    // probabilities 1/k, 2/k, ..., 1.  The last element is the
+    // largest value.
+    Vector empirical_quantiles(const Vector &sorted_values, int k) {
+      int n = sorted_values.size();
+      Vector ans(k);
+      for (int i = 1; i <= k; ++i) {
+        int position = std::min<int>(
+            n - 1, std::max<int>(0, ceil(double(i) * n / k) - 1));
+        ans[i - 1] = sorted_values[position];
+      }
+      return ans;
+    }
+
     }  // namespace
 
     //----------------------------------------------------------------------
@@ -95,8 +111,16 @@ namespace BOOM {
     //----------------------------------------------------------------------
     void VariableSummary::finalize(
         int discrete_distribution_cutoff,
-        ContinuousCutpointStrategy strategy) {
+        ContinuousCutpointStrategy strategy,
+        int number_of_quantiles) {
       observed_values_.sort();
+      Vector quantiles;
+      if (strategy == DISCRETE_QUANTILES && !observed_values_.empty()) {
+        if (number_of_quantiles < 2) {
+          report_error("DISCRETE_QUANTILES needs at least 2 quantiles.");
+        }
+        quantiles = empirical_quantiles(observed_values_, number_of_quantiles);
+      }
       Vector::iterator end =
           std::unique(observed_values_.begin(), observed_values_.end());
 
@@ -120,6 +144,12 @@ namespace BOOM {
             impl_.reset(new DiscreteVariableSummary(variable_number_,
                                                     observed_values_));
             break;
+          case DISCRETE_QUANTILES:
+            // The largest quantile is the largest observed value,
+            // which DiscreteVariableSummary drops from the cutpoints.
+            impl_.reset(new DiscreteVariableSummary(variable_number_,
+                                                    quantiles));
+            break;
           default:
             report_error("Unknown enum value passed to "
                          "VariableSummary::finalize");
@@ -195,6 +225,22 @@ namespace BOOM {
       return impl_->is_legal_configuration(node);
     }
 
+    //----------------------------------------------------------------------
+    const Vector &VariableSummary::cutpoints() const {
+      check_finalized("cutpoints");
+      const DiscreteVariableSummary *discrete =
+          dynamic_cast<const DiscreteVariableSummary *>(impl_.get());
+      if (!discrete) {
+        ostringstream err;
+        err << "Variable " << variable_number_ << " is continuous.  "
+            << "Only discrete variables have a fixed set of cutpoints.  "
+            << "Use the UNIFORM_DISCRETE or DISCRETE_QUANTILES strategy "
+            << "when finalizing the data.";
+        report_error(err.str());
+      }
+      return discrete->cutpoint_values();
+    }
+
     //----------------------------------------------------------------------
     void VariableSummary::check_finalized(const char *msg) const {
       if (!impl_) {
@@ -462,6 +508,210 @@ namespace BOOM {
       return ans;
     }
 
+    //======================================================================
+    void ResidualTable::add_data(ResidualRegressionData *data_point) {
+      const Vector &x(data_point->x());
+      if (data_.empty()) {
+        predictors_.resize(x.size());
+      } else if (x.size() != predictors_.size()) {
+        report_error("All observations in a ResidualTable must have the "
+                     "same number of predictors.");
+      }
+      data_.push_back(data_point);
+      for (int j = 0; j < x.size(); ++j) {
+        predictors_[j].push_back(x[j]);
+      }
+    }
+
+    //----------------------------------------------------------------------
+    void ResidualTable::set_thread_pool(ThreadWorkerPool *pool,
+                                        int minimum_shard_size) {
+      pool_ = pool;
+      minimum_shard_size_ = std::max<int>(1, minimum_shard_size);
+    }
+
+    //----------------------------------------------------------------------
+    int ResidualTable::number_of_shards(int size) const {
+      if (!pool_ || pool_->number_of_threads() <= 1) {
+        return 1;
+      }
+      return std::max<int>(1, std::min<int>(pool_->number_of_threads(),
+                                            size / minimum_shard_size_));
+    }
+
+    //----------------------------------------------------------------------
+    void ResidualTable::run_sharded(
+        int begin, int end,
+        const std::function<void(int, int, int)> &f) const {
+      int number_of_shards = this->number_of_shards(end - begin);
+      if (number_of_shards <= 1) {
+        f(0, begin, end);
+        return;
+      }
+      int shard_size = (end - begin + number_of_shards - 1) / number_of_shards;
+      std::vector<std::function<void()>> tasks;
+      for (int shard = 0; shard < number_of_shards; ++shard) {
+        int shard_begin = begin + shard * shard_size;
+        int shard_end = std::min(end, shard_begin + shard_size);
+        tasks.push_back([&f, shard, shard_begin, shard_end]() {
+            f(shard, shard_begin, shard_end);
+          });
+      }
+      pool_->run(tasks);
+    }
+
+    //======================================================================
+    BinnedPredictors::BinnedPredictors(const std::vector<Vector> &cutpoints,
+                                       const ResidualTable &data)
+        : number_of_observations_(data.size()),
+          cutpoints_(cutpoints),
+          codes_(cutpoints.size() * data.size())
+    {
+      for (int j = 0; j < cutpoints_.size(); ++j) {
+        const Vector &cuts(cutpoints_[j]);
+        if (cuts.size() >= std::numeric_limits<BinCode>::max()) {
+          ostringstream err;
+          err << "Variable " << j << " has " << cuts.size()
+              << " cutpoints, which is too many to be binned.";
+          report_error(err.str());
+        }
+        BinCode *column = codes_.data() + j * number_of_observations_;
+        const double *x = data.predictor(j);
+        for (int i = 0; i < number_of_observations_; ++i) {
+          column[i] = std::lower_bound(cuts.begin(), cuts.end(), x[i])
+              - cuts.begin();
+        }
+      }
+    }
+
+    //----------------------------------------------------------------------
+    int BinnedPredictors::bin(int variable, double cutpoint) const {
+      const Vector &cuts(cutpoints_[variable]);
+      return std::upper_bound(cuts.begin(), cuts.end(), cutpoint)
+          - cuts.begin() - 1;
+    }
+
+    //======================================================================
+    DataPartition::DataPartition(const boost::shared_ptr<ResidualTable> &data)
+        : data_(data),
+          index_(data->size()),
+          data_points_(data->size()),
+          index_workspace_(data->size()),
+          data_workspace_(data->size()),
+          side_workspace_(data->size())
+    {
+      for (int i = 0; i < index_.size(); ++i) {
+        index_[i] = i;
+        data_points_[i] = (*data_)[i];
+      }
+    }
+
+    //----------------------------------------------------------------------
+    // The partition is stable: observations keep their relative order
+    // within each child, so a node's residuals are visited in the
+    // order they were allocated.  That is much friendlier to the cache
+    // than the scrambled order produced by std::partition.
+    template <class GOES_LEFT>
+    int DataPartition::stable_partition(int begin, int end,
+                                        const GOES_LEFT &goes_left) {
+      const ResidualTable &table(*data_);
+      int number_of_shards = table.number_of_shards(end - begin);
+      if (number_of_shards > 1) {
+        return parallel_stable_partition(begin, end, number_of_shards,
+                                         goes_left);
+      }
+      int left = begin;
+      int right = 0;
+      for (int i = begin; i < end; ++i) {
+        int observation = index_[i];
+        ResidualRegressionData *data_point = data_points_[i];
+        if (goes_left(observation)) {
+          index_[left] = observation;
+          data_points_[left] = data_point;
+          ++left;
+        } else {
+          index_workspace_[right] = observation;
+          data_workspace_[right] = data_point;
+          ++right;
+        }
+      }
+      std::copy(index_workspace_.begin(), index_workspace_.begin() + right,
+                index_.begin() + left);
+      std::copy(data_workspace_.begin(), data_workspace_.begin() + right,
+                data_points_.begin() + left);
+      return left;
+    }
+
+    //----------------------------------------------------------------------
+    // Each shard first marks and counts its observations that go
+    // left.  The counts determine where each shard's left and right
+    // observations belong in the partitioned range, so the shards can
+    // then scatter their observations into the workspace
+    // independently, before the workspace is copied back.
+    template <class GOES_LEFT>
+    int DataPartition::parallel_stable_partition(
+        int begin, int end, int number_of_shards, const GOES_LEFT &goes_left) {
+      const ResidualTable &table(*data_);
+      std::vector<int> left_count(number_of_shards, 0);
+      std::vector<int> shard_size(number_of_shards, 0);
+      table.run_sharded(begin, end, [&](int shard, int b, int e) {
+          int count = 0;
+          for (int i = b; i < e; ++i) {
+            bool left = goes_left(index_[i]);
+            side_workspace_[i] = left;
+            count += left;
+          }
+          left_count[shard] = count;
+          shard_size[shard] = e - b;
+        });
+
+      std::vector<int> left_start(number_of_shards);
+      std::vector<int> right_start(number_of_shards);
+      int boundary = begin;
+      for (int shard = 0; shard < number_of_shards; ++shard) {
+        left_start[shard] = boundary;
+        boundary += left_count[shard];
+      }
+      int right = boundary;
+      for (int shard = 0; shard < number_of_shards; ++shard) {
+        right_start[shard] = right;
+        right += shard_size[shard] - left_count[shard];
+      }
+
+      table.run_sharded(begin, end, [&](int shard, int b, int e) {
+          int left = left_start[shard];
+          int right = right_start[shard];
+          for (int i = b; i < e; ++i) {
+            int position = side_workspace_[i] ? left++ : right++;
+            index_workspace_[position] = index_[i];
+            data_workspace_[position] = data_points_[i];
+          }
+        });
+      table.run_sharded(begin, end, [&](int, int b, int e) {
+          std::copy(index_workspace_.begin() + b, index_workspace_.begin() + e,
+                    index_.begin() + b);
+          std::copy(data_workspace_.begin() + b, data_workspace_.begin() + e,
+                    data_points_.begin() + b);
+        });
+      return boundary;
+    }
+
+    //----------------------------------------------------------------------
+    int DataPartition::partition(int begin, int end, int variable,
+                                 double cutpoint) {
+      const BinnedPredictors *bins = data_->binned_predictors();
+      if (bins) {
+        const BinnedPredictors::BinCode *codes = bins->codes(variable);
+        int bin = bins->bin(variable, cutpoint);
+        return stable_partition(
+            begin, end, [codes, bin](int i) {return codes[i] <= bin;});
+      } else {
+        const double *x = data_->predictor(variable);
+        return stable_partition(
+            begin, end, [x, cutpoint](int i) {return x[i] <= cutpoint;});
+      }
+    }
+
     //======================================================================
 
     TreeNode::TreeNode(double mean_value, TreeNode *parent)
@@ -470,6 +720,9 @@ namespace BOOM {
           right_child_(NULL),
           depth_(parent_ ? 1 + parent_->depth() : 0),
           mean_(mean_value),
+          partition_(NULL),
+          data_begin_(0),
+          data_end_(0),
           which_variable_(-1),             // needs to be set
           cutpoint_(BOOM::infinity())      // needs to be set
     {}
@@ -712,7 +965,8 @@ namespace BOOM {
 
     //----------------------------------------------------------------------
     void TreeNode::clear_data_and_delete_suf(bool recursive) {
-      data_.clear();
+      partition_ = NULL;
+      data_begin_ = data_end_ = 0;
       if (!!suf_) {
         suf_.reset();
       }
@@ -728,7 +982,8 @@ namespace BOOM {
 
     //----------------------------------------------------------------------
     void TreeNode::clear_data_and_suf(bool recursive) {
-      data_.clear();
+      partition_ = NULL;
+      data_begin_ = data_end_ = 0;
       if (!!suf_) {
         suf_->clear();
       }
@@ -754,21 +1009,11 @@ namespace BOOM {
     }
 
     //----------------------------------------------------------------------
-    void TreeNode::populate_data(ResidualRegressionData *dp, bool recursive) {
-      data_.push_back(dp);
-      if (recursive && !is_leaf()) {
-        drop_data_to_subtree(dp);
-      }
-    }
-
-    //----------------------------------------------------------------------
-    void TreeNode::drop_data_to_subtree(ResidualRegressionData *dp) {
-      const Vector &x(dp->x());
-      if (x[which_variable_] <= cutpoint_) {
-        left_child_->populate_data(dp, true);
-      } else {
-        right_child_->populate_data(dp, true);
-      }
+    void TreeNode::populate_data(DataPartition *partition, int begin, int end) {
+      partition_ = partition;
+      data_begin_ = begin;
+      data_end_ = end;
+      refresh_subtree_data();
     }
 
     //----------------------------------------------------------------------
@@ -776,11 +1021,15 @@ namespace BOOM {
       if (is_leaf()) {
         return;
       }
-      left_child_->clear_data_and_suf(true);
-      right_child_->clear_data_and_suf(true);
-      for (int i = 0; i < data_.size(); ++i) {
-        drop_data_to_subtree(data_[i]);
+      if (!partition_) {
+        left_child_->clear_data_and_suf(true);
+        right_child_->clear_data_and_suf(true);
+        return;
       }
+      int boundary = partition_->partition(
+          data_begin_, data_end_, which_variable_, cutpoint_);
+      left_child_->populate_data(partition_, data_begin_, boundary);
+      right_child_->populate_data(partition_, boundary, data_end_);
     }
 
     //----------------------------------------------------------------------
@@ -796,29 +1045,69 @@ namespace BOOM {
       } else {
         report_error("Sufficient statistics object was never allocated.");
       }
-      for (int i = 0; i < data_.size(); ++i) {
-        suf_->update(*(data_[i]));
+      if (!partition_) {
+        return *suf_;
+      }
+      const ResidualTable &table(partition_->table());
+      // If this node owns all the data then the original order of the
+      // table is kinder to the cache than the order left behind by
+      // splitting the node's descendants.  The two orderings cover
+      // the same positions.
+      ResidualRegressionData *const *data =
+          sample_size() == partition_->size() ? table.data_points()
+                                              : partition_->data_points();
+      int number_of_shards = table.number_of_shards(sample_size());
+      if (number_of_shards <= 1) {
+        for (int i = data_begin_; i < data_end_; ++i) {
+          suf_->update(*data[i]);
+        }
+      } else {
+        // Each shard accumulates its own partial sufficient
+        // statistics, which are combined once the shards finish.
+        std::vector<boost::shared_ptr<SufficientStatisticsBase>> partial(
+            number_of_shards);
+        for (int shard = 0; shard < number_of_shards; ++shard) {
+          partial[shard].reset(suf_->create());
+          partial[shard]->clear();
+        }
+        table.run_sharded(data_begin_, data_end_,
+                          [&partial, data](int shard, int begin, int end) {
+            SufficientStatisticsBase &suf(*partial[shard]);
+            for (int i = begin; i < end; ++i) {
+              suf.update(*data[i]);
+            }
+          });
+        for (int shard = 0; shard < number_of_shards; ++shard) {
+          suf_->combine(*partial[shard]);
+        }
       }
       return *suf_;
     }
 
-    //----------------------------------------------------------------------
-    const std::vector<ResidualRegressionData *> & TreeNode::data() const {
-      return data_;
-    }
-
     //----------------------------------------------------------------------
     void TreeNode::remove_mean_effect() {
-      for (int i = 0; i < data_.size(); ++i) {
-        data_[i]->add_to_residual(mean_);
-      }
+      if (!partition_) return;
+      ResidualRegressionData *const *data = partition_->data_points();
+      double mean = mean_;
+      partition_->table().run_sharded(
+          data_begin_, data_end_, [data, mean](int, int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+              data[i]->add_to_residual(mean);
+            }
+          });
     }
 
     //----------------------------------------------------------------------
     void TreeNode::replace_mean_effect() {
-      for (int i = 0; i < data_.size(); ++i) {
-        data_[i]->subtract_from_residual(mean_);
-      }
+      if (!partition_) return;
+      ResidualRegressionData *const *data = partition_->data_points();
+      double mean = mean_;
+      partition_->table().run_sharded(
+          data_begin_, data_end_, [data, mean](int, int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+              data[i]->subtract_from_residual(mean);
+            }
+          });
     }
 
     //----------------------------------------------------------------------
@@ -907,6 +1196,10 @@ namespace BOOM {
       if (&rhs != this) {
         root_.reset(rhs.root_->recursive_clone(NULL));
         number_of_nodes_ = rhs.number_of_nodes_;
+        leaves_.clear();
+        parents_of_leaves_.clear();
+        interior_nodes_.clear();
+        partition_.reset();
         register_special_nodes(root_.get());
       }
       return *this;
@@ -919,6 +1212,7 @@ namespace BOOM {
       leaves_.swap(rhs.leaves_);
       parents_of_leaves_.swap(rhs.parents_of_leaves_);
       interior_nodes_.swap(rhs.interior_nodes_);
+      partition_.swap(rhs.partition_);
     }
 
     //----------------------------------------------------------------------
@@ -1103,13 +1397,15 @@ namespace BOOM {
     }
 
     //----------------------------------------------------------------------
-    void Tree::populate_data(ResidualRegressionData *data) {
-      root_->populate_data(data, true);
+    void Tree::populate_data(const boost::shared_ptr<ResidualTable> &data) {
+      partition_.reset(new DataPartition(data));
+      root_->populate_data(partition_.get(), 0, partition_->size());
     }
 
     //----------------------------------------------------------------------
     void Tree::clear_data_and_delete_suf() {
       root_->clear_data_and_delete_suf(true);
+      partition_.reset();
     }
 
     //----------------------------------------------------------------------
@@ -1144,6 +1440,7 @@ namespace BOOM {
       leaves_.clear();
       parents_of_leaves_.clear();
       interior_nodes_.clear();
+      partition_.reset();
       std::vector<TreeNode *> nodes(number_of_nodes_);
       for (int id = 0; id < number_of_nodes_; ++id) {
         const ConstVectorView node_info(tree_matrix.row(id));
@@ -1221,6 +1518,14 @@ namespace BOOM {
     return ans;
   }
 
+  //----------------------------------------------------------------------
+  void BartModelBase::predict(const Matrix &X, VectorView out,
+                              int number_of_threads) const {
+    Bart::FlatForest forest(*this);
+    forest.set_number_of_threads(number_of_threads);
+    forest.predict(X, out);
+  }
+
   //----------------------------------------------------------------------
   int BartModelBase::number_of_variables() const {
     return variable_summaries_.size();
@@ -1263,10 +1568,12 @@ namespace BOOM {
   //----------------------------------------------------------------------
   void BartModelBase::finalize_data(
         int discrete_distribution_cutoff,
-        Bart::ContinuousCutpointStrategy strategy) {
+        Bart::ContinuousCutpointStrategy strategy,
+        int number_of_quantiles) {
     for (int i = 0; i < number_of_variables(); ++i) {
       variable_summaries_[i].finalize(discrete_distribution_cutoff,
-                                      strategy);
+                                      strategy,
+                                      number_of_quantiles);
     }
   }
 
@@ -0,0 +1,207 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include <Models/Bart/FlatForest.hpp>
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <cpputil/math_utils.hpp>
+#include <cpputil/report_error.hpp>
+
+namespace BOOM {
+  namespace Bart {
+
+    namespace {
+      // The number of rows passed through each tree at a time.  The
+      // node positions for a block live on the stack, and the block's
+      // predictors (one column at a time) should stay in L1 cache.
+      const int kBlockSize = 128;
+    }  // namespace
+
+    FlatForest::FlatForest()
+        : number_of_variables_(0)
+    {}
+
+    //----------------------------------------------------------------------
+    FlatForest::FlatForest(const BartModelBase &model)
+        : number_of_variables_(0)
+    {
+      add_trees(model);
+    }
+
+    //----------------------------------------------------------------------
+    void FlatForest::add_tree(const Tree &tree, double scale) {
+      roots_.push_back(variable_.size());
+      depths_.push_back(add_nodes(tree.root(), scale));
+    }
+
+    //----------------------------------------------------------------------
+    void FlatForest::add_trees(const BartModelBase &model, double scale) {
+      for (int i = 0; i < model.number_of_trees(); ++i) {
+        add_tree(*model.tree(i), scale);
+      }
+    }
+
+    //----------------------------------------------------------------------
+    void FlatForest::clear() {
+      variable_.clear();
+      cutpoint_.clear();
+      children_.clear();
+      value_.clear();
+      roots_.clear();
+      depths_.clear();
+      number_of_variables_ = 0;
+    }
+
+    //----------------------------------------------------------------------
+    void FlatForest::set_number_of_threads(int n) {
+      pool_.set_number_of_threads(n);
+    }
+
+    //----------------------------------------------------------------------
+    int FlatForest::add_nodes(const TreeNode *root, double scale) {
+      const int first = variable_.size();
+      int max_depth = 0;
+      // Nodes are assigned positions in the order they enter the
+      // queue, which is breadth-first order.  The two children of a
+      // node enter the queue together, so they are adjacent.
+      std::vector<const TreeNode *> queue(1, root);
+      for (int k = 0; k < queue.size(); ++k) {
+        const TreeNode *node = queue[k];
+        const int position = first + k;
+        if (node->is_leaf()) {
+          variable_.push_back(0);
+          cutpoint_.push_back(infinity());
+          children_.push_back(position);
+          children_.push_back(position);
+          value_.push_back(scale * node->mean());
+          max_depth = std::max(max_depth, node->depth() - root->depth());
+        } else {
+          const int left = first + queue.size();
+          queue.push_back(node->left_child());
+          queue.push_back(node->right_child());
+          variable_.push_back(node->variable_index());
+          cutpoint_.push_back(node->cutpoint());
+          children_.push_back(left);
+          children_.push_back(left + 1);
+          value_.push_back(0.0);
+          number_of_variables_ = std::max(number_of_variables_,
+                                          node->variable_index() + 1);
+        }
+      }
+      return max_depth;
+    }
+
+    //----------------------------------------------------------------------
+    double FlatForest::predict(const ConstVectorView &x) const {
+      if (x.size() < number_of_variables_) {
+        report_error("Predictor vector is too short in FlatForest::predict.");
+      }
+      double ans = 0;
+      for (int t = 0; t < roots_.size(); ++t) {
+        int node = roots_[t];
+        for (int d = 0; d < depths_[t]; ++d) {
+          node = children_[2 * node + !(x[variable_[node]] <= cutpoint_[node])];
+        }
+        ans += value_[node];
+      }
+      return ans;
+    }
+
+    //----------------------------------------------------------------------
+    void FlatForest::predict(const Matrix &X, VectorView out) const {
+      const int nobs = X.nrow();
+      if (out.size() != nobs) {
+        std::ostringstream err;
+        err << "The output vector has length " << out.size()
+            << " but the predictor matrix has " << nobs << " rows.";
+        report_error(err.str());
+      }
+      if (X.ncol() < number_of_variables_) {
+        std::ostringstream err;
+        err << "The forest splits on " << number_of_variables_
+            << " variables, but the predictor matrix has only "
+            << X.ncol() << " columns.";
+        report_error(err.str());
+      }
+      Vector ans(nobs, 0.0);
+      const int number_of_threads = pool_.number_of_threads();
+      if (number_of_threads <= 1 || nobs <= kBlockSize) {
+        predict_rows(X, 0, nobs, ans.data());
+      } else {
+        // Give each thread a contiguous range of whole blocks.
+        int number_of_blocks = (nobs + kBlockSize - 1) / kBlockSize;
+        int blocks_per_task =
+            (number_of_blocks + number_of_threads - 1) / number_of_threads;
+        int rows_per_task = blocks_per_task * kBlockSize;
+        std::vector<std::function<void()>> tasks;
+        for (int begin = 0; begin < nobs; begin += rows_per_task) {
+          int end = std::min(nobs, begin + rows_per_task);
+          double *result = ans.data();
+          tasks.push_back([this, &X, begin, end, result]() {
+              predict_rows(X, begin, end, result);
+            });
+        }
+        pool_.run(tasks);
+      }
+      out = ans;
+    }
+
+    //----------------------------------------------------------------------
+    Vector FlatForest::predict(const Matrix &X) const {
+      Vector ans(X.nrow());
+      predict(X, VectorView(ans));
+      return ans;
+    }
+
+    //----------------------------------------------------------------------
+    // Each block of rows descends one level at a time through a tree,
+    // so the loads for different rows are independent of one another
+    // and can overlap, rather than each row walking root-to-leaf
+    // before the next row starts.
+    void FlatForest::predict_rows(const Matrix &X, int begin, int end,
+                                  double *out) const {
+      const std::size_t stride = X.nrow();
+      const int *variable = variable_.data();
+      const double *cutpoint = cutpoint_.data();
+      const int *children = children_.data();
+      const double *value = value_.data();
+      int nodes[kBlockSize];
+      for (int block_begin = begin; block_begin < end;
+           block_begin += kBlockSize) {
+        const int block_size = std::min(kBlockSize, end - block_begin);
+        const double *x = X.data() + block_begin;
+        double *result = out + block_begin;
+        for (int t = 0; t < roots_.size(); ++t) {
+          std::fill(nodes, nodes + block_size, roots_[t]);
+          for (int d = 0; d < depths_[t]; ++d) {
+            for (int i = 0; i < block_size; ++i) {
+              const int node = nodes[i];
+              const double xi = x[variable[node] * stride + i];
+              nodes[i] = children[2 * node + !(xi <= cutpoint[node])];
+            }
+          }
+          for (int i = 0; i < block_size; ++i) {
+            result[i] += value[nodes[i]];
+          }
+        }
+      }
+    }
+
+  }  // namespace Bart
+}  // namespace BOOM
@@ -153,7 +153,9 @@ namespace BOOM {
         prior_tree_depth_alpha_(prior_tree_depth_alpha),
         prior_tree_depth_beta_(prior_tree_depth_beta),
         total_prediction_variance_(square(total_prediction_sd)),
-        log_prior_number_of_trees_(log_prior_number_of_trees)
+        log_prior_number_of_trees_(log_prior_number_of_trees),
+        use_binned_predictors_(false),
+        minimum_shard_size_(10000)
       {
         if (prior_tree_depth_alpha <= 0
             || prior_tree_depth_alpha >= 1) {
@@ -233,25 +235,51 @@ namespace BOOM {
   //----------------------------------------------------------------------
   // It should only be necessary to call check_residuals once.
   void BartPosteriorSamplerBase::check_residuals() {
-    if (residual_size() != model_->sample_size()) {
+    if (residual_size() != model_->sample_size() || !residual_table_) {
       clear_residuals();
       clear_data_from_trees();
+      residual_table_.reset(new Bart::ResidualTable);
       for (int i = 0; i < model_->sample_size(); ++i) {
-        Bart::ResidualRegressionData *data = create_and_store_residual(i);
-        for (int j = 0; j < model_->number_of_trees(); ++j) {
-          model_->tree(j)->populate_data(data);
+        residual_table_->add_data(create_and_store_residual(i));
+      }
+      if (use_binned_predictors_) {
+        std::vector<Vector> cutpoints;
+        for (int j = 0; j < model_->number_of_variables(); ++j) {
+          cutpoints.push_back(model_->variable_summary(j).cutpoints());
         }
+        residual_table_->set_binned_predictors(
+            boost::shared_ptr<Bart::BinnedPredictors>(
+                new Bart::BinnedPredictors(cutpoints, *residual_table_)));
       }
+      residual_table_->set_thread_pool(&pool_, minimum_shard_size_);
       for (int i = 0; i < model_->number_of_trees(); ++i) {
         model_->tree(i)->populate_sufficient_statistics(create_suf());
+        fill_tree_with_residual_data(model_->tree(i));
       }
     }
   }
 
   //----------------------------------------------------------------------
   void BartPosteriorSamplerBase::fill_tree_with_residual_data(Tree *tree) {
-    for (int i = 0; i < residual_size(); ++i) {
-      tree->populate_data(residual(i));
+    tree->populate_data(residual_table_);
+  }
+
+  //----------------------------------------------------------------------
+  void BartPosteriorSamplerBase::use_binned_predictors(bool binned) {
+    use_binned_predictors_ = binned;
+    residual_table_.reset();
+  }
+
+  //----------------------------------------------------------------------
+  void BartPosteriorSamplerBase::set_number_of_threads(
+      int number_of_threads, int minimum_shard_size) {
+    if (minimum_shard_size < 1) {
+      report_error("minimum_shard_size must be positive.");
+    }
+    pool_.set_number_of_threads(std::max(number_of_threads, 0));
+    minimum_shard_size_ = minimum_shard_size;
+    if (!!residual_table_) {
+      residual_table_->set_thread_pool(&pool_, minimum_shard_size_);
     }
   }
 
@@ -698,7 +726,7 @@ namespace BOOM {
     const VariableSummary &variable_summary(model_->variable_summary(variable));
     Vector range = variable_summary.get_cutpoint_range(node);
     ContinuousCutpointLogLikelihood logf(this, node, range[0], range[1]);
-    ScalarSliceSampler slice(logf);
+    ScalarSliceSampler slice(logf, false, 1.0, &rng());
     slice.set_limits(range[0], range[1]);
     double cutpoint = slice.draw(node->cutpoint());
     node->set_variable_and_cutpoint(variable, cutpoint);
@@ -717,6 +745,12 @@ namespace BOOM {
       // There is only one choice.  We need to stay where we are.
       return;
     }
+    if (residual_table_->binned_predictors()
+        && node->has_no_grandchildren()) {
+      slice_sample_discrete_cutpoint_from_histogram(
+          node, potential_cutpoint_values);
+      return;
+    }
 
     double logf_slice = subtree_log_integrated_likelihood(node)
         - rexp_mt(rng(), 1.0);
@@ -740,6 +774,73 @@ namespace BOOM {
     }
   }
 
+  //----------------------------------------------------------------------
+  void BartPosteriorSamplerBase::slice_sample_discrete_cutpoint_from_histogram(
+      TreeNode *node, const Vector &potential_cutpoint_values) {
+    typedef boost::shared_ptr<Bart::SufficientStatisticsBase> SufPtr;
+    int variable = node->variable_index();
+    const Bart::DataPartition &data(*node->data_partition());
+    const Bart::BinnedPredictors &bins(*data.binned_predictors());
+    const Bart::BinnedPredictors::BinCode *codes = bins.codes(variable);
+    int number_of_bins = bins.number_of_bins(variable);
+
+    // below[b] summarizes the node's data in bins 0..b, and above[b]
+    // the data in bins b..(number_of_bins - 1).  The left child of a
+    // split at bin b gets below[b] and the right child gets
+    // above[b + 1].
+    std::vector<SufPtr> below(number_of_bins);
+    for (int b = 0; b < number_of_bins; ++b) {
+      below[b].reset(create_suf());
+      below[b]->clear();
+    }
+    for (int i = node->data_begin(); i < node->data_end(); ++i) {
+      below[codes[data.observation(i)]]->update(*data[i]);
+    }
+    std::vector<SufPtr> above(number_of_bins + 1);
+    above[number_of_bins].reset(create_suf());
+    above[number_of_bins]->clear();
+    for (int b = number_of_bins - 1; b >= 0; --b) {
+      above[b].reset(above[b + 1]->clone());
+      above[b]->combine(*below[b]);
+    }
+    for (int b = 1; b < number_of_bins; ++b) {
+      below[b]->combine(*below[b - 1]);
+    }
+
+    // A cutpoint below the smallest bin boundary (possible only for a
+    // tree that was not built with these bins) sends all the data
+    // right, and above[number_of_bins] is empty.
+    auto split_log_likelihood = [&](int bin) {
+      const Bart::SufficientStatisticsBase &left(
+          bin < 0 ? *above[number_of_bins] : *below[bin]);
+      return log_integrated_likelihood(left)
+          + log_integrated_likelihood(*above[bin + 1]);
+    };
+
+    double logf_slice =
+        split_log_likelihood(bins.bin(variable, node->cutpoint()))
+        - rexp_mt(rng(), 1.0);
+    Selector possible_cutpoint_positions(potential_cutpoint_values.size(), true);
+    double logp = logf_slice - 1;
+    double cutpoint = node->cutpoint();
+    while (logp < logf_slice && possible_cutpoint_positions.nvars() > 0) {
+      int pos = possible_cutpoint_positions.random_included_position(rng());
+      if (pos < 0) {
+        report_error("Something went wrong when sampling cutpoints in "
+                     "'slice_sample_discrete_cutpoint_from_histogram'");
+      }
+      cutpoint = potential_cutpoint_values[pos];
+      logp = split_log_likelihood(bins.bin(variable, cutpoint));
+      possible_cutpoint_positions.drop(pos);
+    }
+    if (logp < logf_slice && possible_cutpoint_positions.nvars() == 0) {
+      report_error("Ran out of choices for cutpoints when slice sampling "
+                   "a discrete variable.");
+    }
+    node->set_variable_and_cutpoint(variable, cutpoint);
+    node->refresh_subtree_data();
+  }
+
   //----------------------------------------------------------------------
   void BartPosteriorSamplerBase::draw_terminal_means_and_adjust_residuals(
       Bart::Tree *tree) {
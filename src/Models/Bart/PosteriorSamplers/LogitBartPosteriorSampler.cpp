@@ -77,6 +77,19 @@ namespace BOOM {
       information_weighted_sum_of_squared_predictions_ += info * pred * pred;
     }
 
+    void LogitSufficientStatistics::combine(
+        const SufficientStatisticsBase &rhs) {
+      const LogitSufficientStatistics &suf(
+          dynamic_cast<const LogitSufficientStatistics &>(rhs));
+      sum_of_information_ += suf.sum_of_information_;
+      information_weighted_prediction_ += suf.information_weighted_prediction_;
+      information_weighted_sum_ += suf.information_weighted_sum_;
+      information_weighted_sum_of_observation_times_prediction_ +=
+          suf.information_weighted_sum_of_observation_times_prediction_;
+      information_weighted_sum_of_squared_predictions_ +=
+          suf.information_weighted_sum_of_squared_predictions_;
+    }
+
     double LogitSufficientStatistics::sum_of_information() const {
       return sum_of_information_;
     }
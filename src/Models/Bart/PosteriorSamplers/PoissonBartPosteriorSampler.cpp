@@ -124,6 +124,18 @@ namespace BOOM {
         weighted_sum_of_squared_residuals_ += weight * square(residual);
       }
     }
+
+    //----------------------------------------------------------------------
+    void PoissonSufficientStatistics::combine(
+        const SufficientStatisticsBase &rhs) {
+      const PoissonSufficientStatistics &suf(
+          dynamic_cast<const PoissonSufficientStatistics &>(rhs));
+      sum_of_weights_ += suf.sum_of_weights_;
+      weighted_sum_of_residuals_ += suf.weighted_sum_of_residuals_;
+      weighted_sum_of_squared_residuals_ +=
+          suf.weighted_sum_of_squared_residuals_;
+    }
+
   }  // namespace Bart
 
   //======================================================================
@@ -72,6 +72,14 @@ namespace BOOM {
       sum_ += data.sum_of_residuals();
     }
 
+    void ProbitSufficientStatistics::combine(
+        const SufficientStatisticsBase &rhs) {
+      const ProbitSufficientStatistics &suf(
+          dynamic_cast<const ProbitSufficientStatistics &>(rhs));
+      n_ += suf.n_;
+      sum_ += suf.sum_;
+    }
+
     int ProbitSufficientStatistics::sample_size() const { return n_; }
 
     double ProbitSufficientStatistics::sum() const { return sum_; }
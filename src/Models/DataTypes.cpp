@@ -37,8 +37,7 @@ namespace BOOM{
   void intrusive_ptr_add_ref(Data *d){
     d->up_count();}
   void intrusive_ptr_release(Data *d){
-    d->down_count();
-    if(d->ref_count()==0) delete d; }
+    if(d->down_count() == 0) delete d; }
 
   Data::missing_status Data::missing()const{
     return missing_flag; }
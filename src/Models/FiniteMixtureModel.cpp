@@ -21,6 +21,7 @@
 #include <boost/bind.hpp>
 #include <distributions.hpp>
 #include <stdexcept>
+#include <cpputil/report_error.hpp>
 
 namespace BOOM{
 
@@ -75,45 +76,135 @@ namespace BOOM{
   }
 
   void FMM::impute_latent_data(RNG &rng){
-    const std::vector<Ptr<Data> >  &d(dat());
-    std::vector<Ptr<CategoricalData> > hvec(latent_data());
-
-    uint n = d.size();
+    uint n = dat().size();
     uint S = number_of_mixture_components();
     class_membership_probabilities_.resize(n, S);
-
-    wsp_.resize(S);
     set_logpi();
-    last_loglike_ = 0;
-    const std::vector<Ptr<MixtureComponent> > &mod(mixture_components_);
-    Ptr<MultinomialModel> mix(mixing_dist_);
     clear_component_data();
-    for(uint i=0; i<n; ++i){
-      dPtr dp = d[i];
-      Ptr<CategoricalData> cd = hvec[i];
+    if(nthreads() > 0){
+      impute_latent_data_with_threads();
+    }else{
+      last_loglike_ = impute_latent_data_block(
+          0, n, mixture_components_, rng);
+    }
+    std::vector<Ptr<CategoricalData> > hvec(latent_data());
+    Ptr<MultinomialModel> mix(mixing_dist_);
+    for(uint i=0; i<n; ++i) mix->add_data(hvec[i]);
+  }
+
+  double FMM::impute_latent_data_block(
+      int begin, int end,
+      const std::vector<Ptr<MixtureComponent> > &mod,
+      RNG &rng,
+      bool add_data){
+    if(end <= begin) return 0;
+    const std::vector<Ptr<Data> >  &d(dat());
+    const std::vector<Ptr<CategoricalData> > &hvec(latent_data());
+    uint S = mod.size();
+    for(uint s=0; s<S; ++s){
+      VectorView logp(class_membership_probabilities_.col(s),
+                      begin, end - begin);
+      mod[s]->batch_logp(d, begin, end, logp);
+    }
+
+    Vector wsp(S);
+    double loglike = 0;
+    for(int i=begin; i<end; ++i){
+      const Ptr<Data> &dp(d[i]);
+      CategoricalData *cd = hvec[i].get();
+      VectorView probs(class_membership_probabilities_.row(i));
       if(dp->missing()){
-        wsp_ = logpi_;
+        wsp = logpi_;
       }else if(which_mixture_component(i) > 0){
         int source = which_mixture_component(i);
-        last_loglike_ += mod[source]->pdf(dp.get(), true);
-        class_membership_probabilities_.row(i) = 0;
-        class_membership_probabilities_(i, source) = 1.0;
+        loglike += probs[source];
+        probs = 0;
+        probs[source] = 1.0;
         cd->set(source);
-        mix->add_data(cd);
-        mod[source]->add_data(dp);
+        if(add_data) mod[source]->add_data(dp);
         continue;
       }else{
+        wsp = logpi_;
+        wsp += probs;
+      }
+      loglike += lse(wsp);
+      wsp.normalize_logprob();
+      probs = wsp;
+      uint h = rmulti_mt(rng, wsp);
+      cd->set(h);
+      if(add_data) mod[h]->add_data(dp);
+    }
+    return loglike;
+  }
+
+  void FMM::set_nthreads(int n, RNG &seeding_rng){
+    if(n < 0){
+      report_error("Number of threads must be non-negative.");
+    }
+    worker_components_.clear();
+    worker_rngs_.clear();
+    uint S = number_of_mixture_components();
+    for(int i=0; i<n; ++i){
+      std::vector<Ptr<MixtureComponent> > components;
+      components.reserve(S);
+      for(uint s=0; s<S; ++s){
+        components.push_back(mixture_components_[s]->clone());
+        // Worker copies only evaluate densities, so they hold no data.
+        components.back()->clear_data();
+      }
+      worker_components_.push_back(components);
+      worker_rngs_.push_back(split_rng(seeding_rng));
+    }
+    worker_loglike_.assign(n, 0.0);
+    pool_.set_number_of_threads(n);
+  }
+
+  int FMM::nthreads()const{ return worker_components_.size();}
+
+  // Each worker owns a contiguous block of observations, along with its
+  // own copies of the mixture components for evaluating densities.
+  // Workers write to disjoint rows of class_membership_probabilities_
+  // and disjoint elements of the latent data, so no locking is needed.
+  //
+  // The observations are then added to the master components serially,
+  // in the same order as the single threaded path.  Merging the
+  // workers' sufficient statistics would be cheaper, but it leaves the
+  // master components without data pointers, which samplers for
+  // components without sufficient statistics need.
+  void FMM::impute_latent_data_with_threads(){
+    try{
+      int n = dat().size();
+      int nworkers = nthreads();
+      uint S = number_of_mixture_components();
+      std::vector<std::function<void()> > tasks;
+      tasks.reserve(nworkers);
+      for(int w=0; w<nworkers; ++w){
+        std::vector<Ptr<MixtureComponent> > &components(
+            worker_components_[w]);
         for(uint s=0; s<S; ++s){
-          wsp_[s] = logpi_[s] + mod[s]->pdf(dp.get(), true);
+          components[s]->unvectorize_params(
+              mixture_components_[s]->vectorize_params());
         }
+        int begin = (n * static_cast<long>(w)) / nworkers;
+        int end = (n * static_cast<long>(w + 1)) / nworkers;
+        tasks.push_back([this, w, begin, end](){
+            worker_loglike_[w] = impute_latent_data_block(
+                begin, end, worker_components_[w], worker_rngs_[w], false);
+          });
       }
-      last_loglike_ += lse(wsp_);
-      wsp_.normalize_logprob();
-      class_membership_probabilities_.row(i) = wsp_;
-      uint h = rmulti_mt(rng, wsp_);
-      cd->set(h);
-      mod[h]->add_data(dp);
-      mix->add_data(cd);
+      pool_.run(tasks);
+      last_loglike_ = 0;
+      for(int w=0; w<nworkers; ++w) last_loglike_ += worker_loglike_[w];
+      const std::vector<Ptr<Data> > &d(dat());
+      const std::vector<Ptr<CategoricalData> > &hvec(latent_data());
+      for(int i=0; i<n; ++i){
+        mixture_components_[hvec[i]->value()]->add_data(d[i]);
+      }
+    }catch(const std::exception &e){
+      report_error(e.what());
+    }catch(...){
+      report_error("FiniteMixtureModel caught unknown exception "
+                   "from a worker thread.");
     }
   }
 
@@ -17,6 +17,8 @@
 */
 #include <Models/GaussianModelBase.hpp>
 #include <distributions.hpp>
+#include <cpputil/Constants.hpp>
+#include <cpputil/report_error.hpp>
 #include <Models/SufstatAbstractCombineImpl.hpp>
 
 namespace BOOM{
@@ -157,6 +159,30 @@ namespace BOOM{
     return logscale ? ans : exp(ans);
   }
 
+  void GaussianModelBase::batch_logp(const std::vector<Ptr<Data> > &data,
+                                     int begin,
+                                     int end,
+                                     VectorView ans) const {
+    if (begin < 0 || end > data.size() || ans.size() != end - begin) {
+      report_error("Invalid range or output vector size in "
+                   "GaussianModelBase::batch_logp.");
+    }
+    const double mu = this->mu();
+    const double sigma = this->sigma();
+    const double log_normalizing_constant =
+        -log(sigma) - Constants::log_root_2pi;
+    const double scale = -0.5 / (sigma * sigma);
+    for (int i = begin; i < end; ++i) {
+      const Data *dp = data[i].get();
+      if (dp->missing()) {
+        ans[i - begin] = 0.0;
+      } else {
+        const double z = DAT(dp)->value() - mu;
+        ans[i - begin] = log_normalizing_constant + scale * z * z;
+      }
+    }
+  }
+
   double GaussianModelBase::Logp(double x, double &g, double &h, uint nd)const{
     double m = mu();
     double ans = dnorm(x, m, sigma(), 1);
@@ -223,4 +223,28 @@ namespace BOOM{
 
   double BLM::log_alpha()const{return log_alpha_;}
 
+  void BLM::set_columnar_data(const Ptr<ColumnarRegressionData> &data) {
+    if (!!data) {
+      for (int i = 0; i < data->nobs(); ++i) {
+        double trials = data->weight(i);
+        double successes = data->y(i);
+        if (trials < 0 || successes < 0 || successes > trials) {
+          std::ostringstream err;
+          err << "Invalid binomial observation in row " << i
+              << " of columnar data.  "
+              << "successes = " << successes
+              << ", trials = " << trials << ".";
+          report_error(err.str());
+        }
+      }
+    }
+    clear_data();
+    store_columnar_data(data);
+  }
+
+  void BLM::clear_data() {
+    DataPolicy::clear_data();
+    store_columnar_data(Ptr<ColumnarRegressionData>());
+  }
+
 }  // namespace BOOM
@@ -0,0 +1,133 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include <Models/Glm/ColumnarRegressionData.hpp>
+#include <LinAlg/blas.hpp>
+#include <cpputil/report_error.hpp>
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace BOOM {
+
+  ColumnarRegressionData::ColumnarRegressionData(const Matrix &X,
+                                                 const Vector &y)
+      : X_(X),
+        y_(y)
+  {
+    if (X_.nrow() != y_.size()) {
+      std::ostringstream err;
+      err << "The design matrix has " << X_.nrow() << " rows, but there are "
+          << y_.size() << " responses.";
+      report_error(err.str());
+    }
+  }
+
+  ColumnarRegressionData::ColumnarRegressionData(const Matrix &X,
+                                                 const Vector &y,
+                                                 const Vector &weights)
+      : ColumnarRegressionData(X, y)
+  {
+    if (!weights.empty() && weights.size() != y_.size()) {
+      report_error("The weight vector must be empty or match the size "
+                   "of the response.");
+    }
+    weights_ = weights;
+  }
+
+  void ColumnarRegressionData::predict(
+      const Vector &beta, int first, VectorView eta) const {
+    if (beta.size() != xdim()) {
+      report_error("Coefficient vector is the wrong size in "
+                   "ColumnarRegressionData::predict.");
+    }
+    if (first < 0 || first + eta.size() > nobs()) {
+      report_error("Rows out of range in ColumnarRegressionData::predict.");
+    }
+    if (eta.size() == 0 || xdim() == 0) {
+      eta = 0.0;
+      return;
+    }
+    blas::dgemv(blas::NoTrans, eta.size(), xdim(), 1.0,
+                X_.data() + first, nobs(),
+                beta.data(), 1,
+                0.0, eta.data(), eta.stride());
+  }
+
+  void ColumnarRegressionData::add_cross_products(
+      int first,
+      const ConstVectorView &weights,
+      const ConstVectorView &weighted_y,
+      SpdMatrix &xtwx,
+      Vector &xtwy) const {
+    const int rows = weighted_y.size();
+    const int p = xdim();
+    if (first < 0 || first + rows > nobs()) {
+      report_error("Rows out of range in "
+                   "ColumnarRegressionData::add_cross_products.");
+    }
+    if (weights.size() > 0 && weights.size() != rows) {
+      report_error("Weights and weighted responses must be the same size.");
+    }
+    if (xtwx.nrow() != p || xtwy.size() != p) {
+      report_error("Cross product arguments are the wrong size in "
+                   "ColumnarRegressionData::add_cross_products.");
+    }
+    if (rows == 0 || p == 0) return;
+
+    const double *X = X_.data() + first;
+    if (weights.size() == 0) {
+      blas::dsyrk(blas::Upper, blas::Trans, p, rows,
+                  1.0, X, nobs(), 1.0, xtwx.data(), p);
+    } else {
+      // Scale each row by the square root of its weight, so that
+      // X^T W X = B^T B can be handed to dsyrk.
+      Matrix B(rows, p);
+      double *b = B.data();
+      for (int j = 0; j < p; ++j) {
+        const double *x = X + j * nobs();
+        double *bj = b + j * rows;
+        for (int i = 0; i < rows; ++i) {
+          bj[i] = std::sqrt(weights[i]) * x[i];
+        }
+      }
+      blas::dsyrk(blas::Upper, blas::Trans, p, rows,
+                  1.0, b, rows, 1.0, xtwx.data(), p);
+    }
+    blas::dgemv(blas::Trans, rows, p, 1.0, X, nobs(),
+                weighted_y.data(), weighted_y.stride(),
+                1.0, xtwy.data(), 1);
+  }
+
+  std::vector<std::pair<int, int> > ColumnarRegressionData::row_ranges(
+      int number_of_ranges) const {
+    if (number_of_ranges < 1) number_of_ranges = 1;
+    const int number_of_blocks = (nobs() + kBlockSize - 1) / kBlockSize;
+    std::vector<std::pair<int, int> > ans;
+    for (int i = 0; i < number_of_ranges; ++i) {
+      int lo = std::min(
+          nobs(), kBlockSize * (number_of_blocks * i / number_of_ranges));
+      int hi = std::min(
+          nobs(),
+          kBlockSize * (number_of_blocks * (i + 1) / number_of_ranges));
+      if (hi > lo) ans.push_back(std::make_pair(lo, hi));
+    }
+    return ans;
+  }
+
+}  // namespace BOOM
@@ -56,7 +56,10 @@ namespace BOOM{
   }
 
   GlmModel::GlmModel() {}
-  GlmModel::GlmModel(const GlmModel & rhs) : Model(rhs) {}
+  GlmModel::GlmModel(const GlmModel & rhs)
+      : Model(rhs),
+        columnar_data_(rhs.columnar_data_)
+  {}
   uint GlmModel::xdim()const{ return coef().nvars_possible();}
   void GlmModel::add(uint p){ coef().add(p);}
   void GlmModel::add_all(){ for(int i = 0; i < xdim(); ++i) add(i);}
@@ -90,4 +93,19 @@ namespace BOOM{
   void GlmModel::set_Beta(const Vector &B){coef().set_Beta(B);}
   double GlmModel::Beta(uint I)const{return coef().Beta(I);}
 
+  void GlmModel::set_columnar_data(const Ptr<ColumnarRegressionData> &) {
+    report_error("This model does not support columnar data.");
+  }
+
+  void GlmModel::store_columnar_data(
+      const Ptr<ColumnarRegressionData> &data) {
+    if (!!data && data->xdim() != xdim()) {
+      std::ostringstream err;
+      err << "Columnar data has " << data->xdim() << " predictors, but the "
+          << "model expects " << xdim() << ".";
+      report_error(err.str());
+    }
+    columnar_data_ = data;
+  }
+
 }  // namespace BOOM;
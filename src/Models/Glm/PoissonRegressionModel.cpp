@@ -48,6 +48,30 @@ namespace BOOM {
     return ParamPolicy::prm_ref();
   }
 
+  void PoissonRegressionModel::set_columnar_data(
+      const Ptr<ColumnarRegressionData> &data) {
+    if (!!data) {
+      for (int i = 0; i < data->nobs(); ++i) {
+        double y = data->y(i);
+        if (y < 0 || y != lround(y) || data->weight(i) <= 0) {
+          std::ostringstream err;
+          err << "Invalid Poisson observation in row " << i
+              << " of columnar data.  "
+              << "y = " << y
+              << ", exposure = " << data->weight(i) << ".";
+          report_error(err.str());
+        }
+      }
+    }
+    clear_data();
+    store_columnar_data(data);
+  }
+
+  void PoissonRegressionModel::clear_data() {
+    DataPolicy::clear_data();
+    store_columnar_data(Ptr<ColumnarRegressionData>());
+  }
+
   Ptr<GlmCoefs> PoissonRegressionModel::coef_prm(){
     return ParamPolicy::prm();}
 
@@ -34,6 +34,7 @@ namespace BOOM {
 
   const SpdMatrix & BLAMS::SufficientStatistics::xtx() const {
     if (!sym_) {
+      xtx_buffer_.flush(xtx_);
       xtx_.reflect();
       sym_ = true;
     }
@@ -47,18 +48,30 @@ namespace BOOM {
   void BLAMS::SufficientStatistics::update(
       const Vector &x, double weighted_value, double weight) {
     sym_ = false;
-    xtx_.add_outer(x, weight, false);
+    xtx_buffer_.add(x, weight, xtx_);
     xty_.axpy(x, weighted_value);
   }
 
+  void BLAMS::SufficientStatistics::add_columnar_data(
+      const ColumnarRegressionData &data,
+      int first,
+      const ConstVectorView &weighted_value,
+      const ConstVectorView &weight) {
+    sym_ = false;
+    data.add_cross_products(first, weight, weighted_value, xtx_, xty_);
+  }
+
   void BLAMS::SufficientStatistics::clear() {
     xtx_ = 0;
     xty_ = 0;
     sym_ = false;
+    xtx_buffer_.clear();
   }
 
   void BLAMS::SufficientStatistics::combine(
       const BLAMS::SufficientStatistics &rhs) {
+    xtx_buffer_.flush(xtx_);
+    rhs.xtx_buffer_.flush(rhs.xtx_);
     xtx_ += rhs.xtx_;
     xty_ += rhs.xty_;
     sym_ = sym_ && rhs.sym_;
@@ -90,7 +103,48 @@ namespace BOOM {
 
   void BLAMS::impute_latent_data() {
     if (!latent_data_fixed_) {
-      suf_ = parallel_data_imputer_.impute();
+      if (!!model_->columnar_data()) {
+        impute_columnar_latent_data();
+      } else {
+        suf_ = parallel_data_imputer_.impute();
+      }
+    }
+  }
+
+  void BLAMS::impute_columnar_latent_data() {
+    columnar_imputer_.impute(
+        *model_->columnar_data(),
+        parallel_data_imputer_.number_of_workers(),
+        &suf_,
+        rng(),
+        [this](int begin, int end, SufficientStatistics *suf, RNG &rng) {
+          impute_columnar_rows(begin, end, suf, rng);
+        });
+  }
+
+  void BLAMS::impute_columnar_rows(int begin, int end,
+                                   SufficientStatistics *suf,
+                                   RNG &rng) const {
+    const ColumnarRegressionData &data(*model_->columnar_data());
+    const BinomialLogitCltDataImputer imputer(clt_threshold_);
+    const Vector &beta(model_->Beta());
+    const int block_size = ColumnarRegressionData::kBlockSize;
+    Vector eta(block_size);
+    Vector weighted_value(block_size);
+    Vector weight(block_size);
+    for (int first = begin; first < end; first += block_size) {
+      int rows = std::min(block_size, end - first);
+      data.predict(beta, first, VectorView(eta, 0, rows));
+      for (int i = 0; i < rows; ++i) {
+        std::pair<double, double> imputed = imputer.impute(
+            rng, data.weight(first + i), data.y(first + i), eta[i]);
+        weighted_value[i] = imputed.first;
+        weight[i] = imputed.second;
+      }
+      suf->add_columnar_data(data,
+                             first,
+                             ConstVectorView(weighted_value, 0, rows),
+                             ConstVectorView(weight, 0, rows));
     }
   }
 
@@ -19,6 +19,7 @@
 #include <Models/Glm/PosteriorSamplers/BinomialLogitDataImputer.hpp>
 #include <distributions.hpp>
 #include <distributions/trun_logit.hpp>
+#include <distributions/polya_gamma.hpp>
 #include <cpputil/math_utils.hpp>
 #include <cpputil/report_error.hpp>
 
@@ -246,4 +247,40 @@ namespace BOOM {
   int BinomialLogitCltDataImputer::clt_threshold() const {
     return clt_threshold_;
   }
+
+  //======================================================================
+  BinomialLogitPolyaGammaDataImputer::BinomialLogitPolyaGammaDataImputer(
+      int clt_threshold)
+      : clt_threshold_(clt_threshold)
+  {}
+
+  std::pair<double, double> BinomialLogitPolyaGammaDataImputer::impute(
+      RNG &rng,
+      double number_of_trials,
+      double number_of_successes,
+      double linear_predictor) const {
+    if (number_of_successes > number_of_trials
+        || number_of_successes < 0) {
+      ostringstream err;
+      err << "The number of successes must be between zero and the number "
+          << "of trials in BinomialLogitPolyaGammaDataImputer::impute()."
+          << endl;
+      debug_status_message(
+          err, number_of_trials, number_of_successes, linear_predictor);
+      report_error(err.str());
+    }
+    if (number_of_trials <= 0) {
+      return std::make_pair(0.0, 0.0);
+    }
+    double omega = number_of_trials < clt_threshold_
+        ? rpolya_gamma_mt(rng, number_of_trials, linear_predictor)
+        : rpolya_gamma_normal_approximation_mt(
+            rng, number_of_trials, linear_predictor);
+    return std::make_pair(number_of_successes - 0.5 * number_of_trials,
+                          omega);
+  }
+
+  int BinomialLogitPolyaGammaDataImputer::clt_threshold() const {
+    return clt_threshold_;
+  }
 }  // namespace BOOM
@@ -0,0 +1,141 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include <Models/Glm/PosteriorSamplers/BinomialLogitPolyaGammaSampler.hpp>
+#include <distributions.hpp>
+#include <cpputil/report_error.hpp>
+
+namespace BOOM {
+  namespace {
+    typedef BinomialLogitPolyaGammaSampler BLPGS;
+    typedef BinomialLogitPolyaGammaRegressionDataImputer BLPGRDI;
+  }  // namespace
+
+  BLPGRDI::BinomialLogitPolyaGammaRegressionDataImputer(
+      int clt_threshold, const GlmCoefs *coefficients)
+      : imputer_(clt_threshold),
+        coefficients_(coefficients)
+  {}
+
+  void BLPGRDI::impute_latent_data(const BinomialRegressionData &observation,
+                                   WeightedRegSuf *suf,
+                                   RNG &rng) const {
+    const Vector &x(observation.x());
+    std::pair<double, double> imputed = imputer_.impute(
+        rng, observation.n(), observation.y(), coefficients_->predict(x));
+    const double omega = imputed.second;
+    if (omega > 0) {
+      suf->add_data(x, imputed.first / omega, omega);
+    }
+  }
+
+  //======================================================================
+  BLPGS::BinomialLogitPolyaGammaSampler(BinomialLogitModel *model,
+                                        Ptr<MvnBase> prior,
+                                        int clt_threshold,
+                                        RNG &seeding_rng)
+      : PosteriorSampler(seeding_rng),
+        model_(model),
+        prior_(prior),
+        clt_threshold_(clt_threshold),
+        suf_(model->xdim()),
+        parallel_data_imputer_(suf_, model_),
+        latent_data_fixed_(false)
+  {
+    set_number_of_workers(1);
+  }
+
+  double BLPGS::logpri() const {
+    return prior_->logp(model_->Beta());
+  }
+
+  void BLPGS::draw() {
+    impute_latent_data();
+    draw_params();
+  }
+
+  void BLPGS::impute_latent_data() {
+    if (latent_data_fixed_) return;
+    if (!!model_->columnar_data()) {
+      impute_columnar_latent_data();
+    } else {
+      suf_ = parallel_data_imputer_.impute();
+    }
+  }
+
+  void BLPGS::impute_columnar_latent_data() {
+    columnar_imputer_.impute(
+        *model_->columnar_data(),
+        parallel_data_imputer_.number_of_workers(),
+        &suf_,
+        rng(),
+        [this](int begin, int end, WeightedRegSuf *suf, RNG &rng) {
+          impute_columnar_rows(begin, end, suf, rng);
+        });
+  }
+
+  void BLPGS::impute_columnar_rows(int begin, int end,
+                                   WeightedRegSuf *suf,
+                                   RNG &rng) const {
+    const ColumnarRegressionData &data(*model_->columnar_data());
+    const BinomialLogitPolyaGammaDataImputer imputer(clt_threshold_);
+    const Vector &beta(model_->Beta());
+    const int block_size = ColumnarRegressionData::kBlockSize;
+    Vector eta(block_size);
+    Vector response(block_size);
+    Vector omega(block_size);
+    for (int first = begin; first < end; first += block_size) {
+      int rows = std::min(block_size, end - first);
+      data.predict(beta, first, VectorView(eta, 0, rows));
+      for (int i = 0; i < rows; ++i) {
+        std::pair<double, double> imputed = imputer.impute(
+            rng, data.weight(first + i), data.y(first + i), eta[i]);
+        omega[i] = imputed.second;
+        response[i] = omega[i] > 0 ? imputed.first / omega[i] : 0.0;
+      }
+      suf->add_columnar_data(data,
+                             first,
+                             ConstVectorView(response, 0, rows),
+                             ConstVectorView(omega, 0, rows));
+    }
+  }
+
+  void BLPGS::draw_params() {
+    SpdMatrix ivar = prior_->siginv() + suf_.xtx();
+    Vector ivar_mu = suf_.xty() + prior_->siginv() * prior_->mu();
+    model_->set_Beta(rmvn_suf_mt(rng(), ivar, ivar_mu));
+  }
+
+  void BLPGS::set_number_of_workers(int n) {
+    if (n < 1) {
+      report_error("At least one data imputation worker is needed.");
+    }
+    parallel_data_imputer_.clear_workers();
+    for (int i = 0; i < n; ++i) {
+      parallel_data_imputer_.add_worker(
+          new BLPGRDI(clt_threshold_, model_->coef_prm().get()),
+          rng());
+    }
+    parallel_data_imputer_.assign_data();
+  }
+
+  void BLPGS::fix_latent_data(bool fixed) {
+    latent_data_fixed_ = fixed;
+  }
+
+}  // namespace BOOM
@@ -54,8 +54,7 @@ namespace BOOM{
     Vector ivar_mu = ivar * g.select(pri_->mu());
     ivar += g.select(suf().xtx());
     ivar_mu += g.select(suf().xty());
-    Vector b = ivar.solve(ivar_mu);
-    b = rmvn_ivar_mt(rng(), b, ivar);
+    Vector b = rmvn_suf_mt(rng(), Chol(ivar), ivar_mu);
 
     // If model selection is turned off and some elements of beta
     // happen to be zero (because, e.g., of a failed MH step) we don't
@@ -24,6 +24,7 @@
 #include <Models/ChisqModel.hpp>
 #include <Models/Glm/PosteriorSamplers/BregVsSampler.hpp>
 #include <Models/MvnGivenScalarSigma.hpp>
+#include <Models/IndependentMvnModelGivenScalarSigma.hpp>
 
 namespace BOOM{
 
@@ -38,6 +39,21 @@ namespace BOOM{
       double sigma_guess = sqrt(sample_variance * (1-expected_rsq));
       return new ChisqModel(prior_nobs, sigma_guess);
     }
+
+    // The default priors set Omega^{-1} to a multiple of XTX / n.  If
+    // the model stores XTX sparsely then forming it densely would
+    // need p^2 storage, so only its diagonal is used.  Returns NULL if
+    // the sufficient statistics are dense.
+    Ptr<MvnGivenScalarSigmaBase> create_sparse_default_prior(
+        RegressionModel *mod, const Vector &b, double prior_nobs) {
+      const SparseRegSuf *suf =
+          dynamic_cast<const SparseRegSuf *>(mod->suf().get());
+      if (!suf) return Ptr<MvnGivenScalarSigmaBase>();
+      Vector unscaled_variance = 1.0 / suf->sparse_xtx().diag();
+      unscaled_variance *= suf->n() / prior_nobs;
+      return new IndependentMvnModelGivenScalarSigma(
+          b, unscaled_variance, mod->Sigsq_prm());
+    }
   }
 
   //----------------------------------------------------------------------
@@ -66,10 +82,13 @@ namespace BOOM{
     if (first_term_is_intercept) {
       b[0] = m_->suf()->ybar();
     }
-    SpdMatrix ominv(m_->suf()->xtx());
-    double n = m_->suf()->n();
-    ominv *= prior_nobs / n;
-    bpri_ = new MvnGivenScalarSigma(ominv, mod->Sigsq_prm());
+    bpri_ = create_sparse_default_prior(mod, b, prior_nobs);
+    if (!bpri_) {
+      SpdMatrix ominv(m_->suf()->xtx());
+      double n = m_->suf()->n();
+      ominv *= prior_nobs / n;
+      bpri_ = new MvnGivenScalarSigma(ominv, mod->Sigsq_prm());
+    }
 
     double prob = expected_model_size/p;
     if (prob>1) prob = 1.0;
@@ -103,8 +122,6 @@ namespace BOOM{
     Vector b = Vector(p, 0.0);
     double ybar = mod->suf()->ybar();
     b[0] = ybar;
-    SpdMatrix ominv(m_->suf()->xtx());
-    double n = m_->suf()->n();
 
     if (prior_sigma_guess <= 0) {
       ostringstream msg;
@@ -114,7 +131,6 @@ namespace BOOM{
           << "legal values are strictly > 0";
       report_error(msg.str());
     }
-    ominv *= prior_beta_nobs/n;
 
     // handle diagonal shrinkage:  ominv =alpha*diag(ominv) + (1-alpha)*ominv
     // This prevents a perfectly singular ominv.
@@ -127,15 +143,22 @@ namespace BOOM{
       report_error(msg.str());
     }
 
-    if (alpha < 1.0) {
-      diag(ominv).axpy(diag(ominv), alpha/(1-alpha));
-      ominv *= (1-alpha);
-    }else{
-      ominv.set_diag(diag(ominv));
+    // Sparse sufficient statistics get a diagonal prior, as if alpha
+    // were 1.
+    bpri_ = create_sparse_default_prior(mod, b, prior_beta_nobs);
+    if (!bpri_) {
+      SpdMatrix ominv(m_->suf()->xtx());
+      double n = m_->suf()->n();
+      ominv *= prior_beta_nobs/n;
+      if (alpha < 1.0) {
+        diag(ominv).axpy(diag(ominv), alpha/(1-alpha));
+        ominv *= (1-alpha);
+      }else{
+        ominv.set_diag(diag(ominv));
+      }
+      bpri_ = new MvnGivenScalarSigma(b, ominv, m_->Sigsq_prm());
     }
 
-    bpri_ = new MvnGivenScalarSigma(b, ominv, m_->Sigsq_prm());
-
     Vector pi(p, prior_inclusion_probability);
     if (force_intercept) pi[0] = 1.0;
 
@@ -240,7 +263,9 @@ namespace BOOM{
     if (ldoi <= negative_infinity()) {
       return negative_infinity();
     }
-    ans += .5*(ldoi - iV_tilde_.logdet());
+    // .5 * logdet(iV_tilde_) is the sum of the logs of the diagonal
+    // elements of its Cholesky factor.
+    ans += .5*ldoi - sum(log(iV_tilde_chol_.diag()));
     ans -= (.5*DF_-1)*log(SS_);
     return ans;
   }
@@ -248,7 +273,7 @@ namespace BOOM{
   double BVS::mcmc_one_flip(Selector &mod, uint which_var, double logp_old) {
     mod.flip(which_var);
     double logp_new = log_model_prob(mod);
-    double u = runif (0,1);
+    double u = runif_mt(rng(), 0,1);
     if (log(u) > logp_new - logp_old) {
       mod.flip(which_var);  // reject draw
       return logp_old;
@@ -256,6 +281,40 @@ namespace BOOM{
     return logp_new;
   }
   //----------------------------------------------------------------------
+  double BVS::incremental_log_model_prob(const Selector &g) const {
+    if (g.nvars() == 0) {
+      return log_model_prob(g);
+    }
+    double ans = vpri_->logp(g);
+    if (ans == negative_infinity()) {
+      return ans;
+    }
+    // The sum of squares in set_reg_post_params simplifies to
+    //   prior_ss + y'y + b'Ominv b - beta_tilde' iV_tilde beta_tilde.
+    double SS = prior_ss() + m_->suf()->yty()
+        + slab_posterior_.prior_mahalanobis()
+        - slab_posterior_.posterior_mahalanobis();
+    double DF = m_->suf()->n() + prior_df();
+    ans += .5*(slab_posterior_.prior_logdet()
+               - slab_posterior_.posterior_logdet());
+    ans -= (.5*DF-1)*log(SS);
+    return ans;
+  }
+  //----------------------------------------------------------------------
+  double BVS::incremental_mcmc_one_flip(
+      Selector &mod, uint which_var, double logp_old) {
+    mod.flip(which_var);
+    double logp_new = slab_posterior_.flip(which_var)
+        ? incremental_log_model_prob(mod) : negative_infinity();
+    double u = runif_mt(rng(), 0,1);
+    if (log(u) > logp_new - logp_old) {
+      mod.flip(which_var);  // reject draw
+      slab_posterior_.restore(which_var, mod.inc(which_var));
+      return logp_old;
+    }
+    return logp_new;
+  }
+  //----------------------------------------------------------------------
   void BVS::draw() {
     if (max_nflips_>0) draw_model_indicators();
     if (draw_beta_ || draw_sigma_) {
@@ -295,15 +354,49 @@ namespace BOOM{
   //----------------------------------------------------------------------
   void BVS::draw_beta() {
     if (model_is_empty()) return;
-    iV_tilde_ /= m_->sigsq();
-    beta_tilde_ = rmvn_ivar(beta_tilde_, iV_tilde_);
+    // The posterior precision is iV_tilde_ / sigsq, so its Cholesky
+    // factor is the one set_reg_post_params computed, divided by sigma.
+    beta_tilde_ = rmvn_ivar_L_mt(rng(), beta_tilde_,
+                                 iV_tilde_chol_ * (1.0 / m_->sigma()));
     m_->set_included_coefficients(beta_tilde_);
   }
   //----------------------------------------------------------------------
   void BVS::draw_model_indicators() {
     Selector g = m_->coef().inc();
-    std::random_shuffle(indx.begin(), indx.end());
-    double logp = log_model_prob(g);
+    // I'd like to rely on std::random_shuffle for this, but I want
+    // control over the random number generator.
+    for (int i = indx.size() - 1; i > 0; --i) {
+      int j = random_int_mt(rng(), 0, i);
+      if (j != i) std::swap(indx[i], indx[j]);
+    }
+    // Ominv = siginv * sigsq.  See set_reg_post_params.
+    // Sparse sufficient statistics are read element by element, so
+    // the dense p x p cross product matrix is never formed.  Neither
+    // is the prior precision, if it is diagonal.
+    Ptr<RegSuf> suf = m_->suf();
+    const SparseRegSuf *sparse_suf =
+        dynamic_cast<const SparseRegSuf *>(suf.get());
+    const IndependentMvnModelGivenScalarSigma *diagonal_prior =
+        dynamic_cast<const IndependentMvnModelGivenScalarSigma *>(bpri_.get());
+    bool ok;
+    if (sparse_suf && diagonal_prior) {
+      unscaled_prior_precision_diagonal_ =
+          1.0 / diagonal_prior->unscaled_variance_diagonal();
+      ok = slab_posterior_.reset(g, unscaled_prior_precision_diagonal_, 1.0,
+                                 bpri_->mu(), sparse_suf->sparse_xtx(),
+                                 suf->xty(), 1.0);
+    } else if (sparse_suf) {
+      ok = slab_posterior_.reset(g, bpri_->siginv(), m_->sigsq(), bpri_->mu(),
+                                 sparse_suf->sparse_xtx(), suf->xty(), 1.0);
+    } else {
+      ok = slab_posterior_.reset(g, bpri_->siginv(), m_->sigsq(), bpri_->mu(),
+                                 suf->xtx(), suf->xty(), 1.0);
+    }
+    // The starting value comes from the factors just computed, rather
+    // than from a fresh O(k^3) call to log_model_prob.  If the
+    // factorization failed, fall back to the dense computation for
+    // the whole sweep.
+    double logp = ok ? incremental_log_model_prob(g) : log_model_prob(g);
 
     if (!std::isfinite(logp)) {
       ostringstream err;
@@ -315,7 +408,8 @@ namespace BOOM{
 
     uint n = std::min<uint>(max_nflips_, g.nvars_possible());
     for (uint i=0; i<n; ++i) {
-      logp = mcmc_one_flip(g, indx[i], logp);
+      logp = ok ? incremental_mcmc_one_flip(g, indx[i], logp)
+          : mcmc_one_flip(g, indx[i], logp);
     }
     m_->coef().set_inc(g);
   }
@@ -331,7 +425,7 @@ namespace BOOM{
     if (g.nvars() > 0) {
       ans += dmvn(g.select(m_->Beta()),
                   g.select(bpri_->mu()),
-                  g.select(bpri_->siginv()), true);
+                  unscaled_prior_precision(g) / sigsq, true);
     }
     return ans;
   }
@@ -344,7 +438,7 @@ namespace BOOM{
     // Sigma = sigsq * Omega, so
     // siginv = ominv / sigsq, so
     // ominv = siginv * sigsq.
-    SpdMatrix Ominv = g.select(bpri_->siginv()) * m_->sigsq();
+    SpdMatrix Ominv = unscaled_prior_precision(g);
     double ldoi = do_ldoi ? Ominv.logdet() : 0.0;
 
     Ptr<RegSuf> s = m_->suf();
@@ -352,17 +446,20 @@ namespace BOOM{
     SpdMatrix xtx = s->xtx(g);
     Vector xty = s->xty(g);
 
-    // iV_tilde_ / sigsq is the inverse of the posterior precision
-    // matrix, given g.
+    // iV_tilde_ / sigsq is the posterior precision matrix, given g.
+    // It is factored once here, and the factor is reused by
+    // log_model_prob and draw_beta.
     iV_tilde_ = Ominv + xtx;
-    // beta_tilde_ is the posterior mean, given g
-    beta_tilde_ = Ominv * b + xty;
     bool positive_definite = true;
-    beta_tilde_ = iV_tilde_.solve(beta_tilde_, positive_definite);
+    iV_tilde_chol_ = iV_tilde_.chol(positive_definite);
     if (!positive_definite) {
       beta_tilde_ = Vector(iV_tilde_.nrow());
       return negative_infinity();
     }
+    // beta_tilde_ is the posterior mean, given g
+    beta_tilde_ = Ominv * b + xty;
+    Lsolve_inplace(iV_tilde_chol_, beta_tilde_);
+    LTsolve_inplace(iV_tilde_chol_, beta_tilde_);
     DF_ = s->n() + prior_df();
     SS_ = prior_ss();
 
@@ -378,6 +475,17 @@ namespace BOOM{
     return ldoi;
   }
 
+  SpdMatrix BVS::unscaled_prior_precision(const Selector &g) const {
+    const IndependentMvnModelGivenScalarSigma *diagonal_prior =
+        dynamic_cast<const IndependentMvnModelGivenScalarSigma *>(bpri_.get());
+    if (diagonal_prior) {
+      SpdMatrix ans(g.nvars(), 0.0);
+      ans.set_diag(1.0 / g.select(diagonal_prior->unscaled_variance_diagonal()));
+      return ans;
+    }
+    return g.select(bpri_->siginv()) * m_->sigsq();
+  }
+
   void BVS::check_dimensions() const {
     if (vpri_->potential_nvars() != bpri_->dim()) {
       ostringstream err;
@@ -108,7 +108,7 @@ namespace BOOM{
       bool top = i == k-1;
       double hi = top ? BOOM::infinity() : delta_[i+1];
       PartialTarget f(m_->delta_log_likelihood(), i, delta_);
-      ScalarSliceSampler sam(f, true);
+      ScalarSliceSampler sam(f, true, 1.0, &rng());
       if(!top) sam.set_limits(lo, hi);
       else sam.set_lower_limit(lo);
       delta_[i] = sam.draw(delta_[i]);
@@ -165,7 +165,7 @@ namespace BOOM{
       subject_proposals_.push_back(prop);
 
       LesSubjectTarget target(m, U, mlm_);
-      NEW(MH, sam)(target, prop);
+      NEW(MH, sam)(target, prop, &rng());
       subject_samplers_.push_back(sam);
 
       Vector tmp(psub);
@@ -178,7 +178,7 @@ namespace BOOM{
       choice_proposal_ = new MvtIndepProposal(choice_pri()->mu(),
                                               choice_pri()->siginv(),
                                               Tdf);
-      choice_sampler_ = new MH(target, choice_proposal_);
+      choice_sampler_ = new MH(target, choice_proposal_, &rng());
       Ominv_mu_choice = choice_pri()->siginv() * choice_pri()->mu();
       xtu_choice = Vector(pch);
     }
@@ -212,13 +212,13 @@ namespace BOOM{
       mlm_->fill_eta(*dp, eta);
       uint y = dp->value();
       double loglam = lse(eta);
-      double logzmin = rlexp(loglam);
+      double logzmin = rlexp_mt(rng(), loglam);
       logz2[0] = logzmin;
       u[y] = mu- logzmin;
       const Vector & xsub(dp->Xsubject());
       for(uint m=0; m<M; ++m){
     if(m!=y){
-      logz2[1] =rlexp(eta[m]);
+      logz2[1] =rlexp_mt(rng(), eta[m]);
       double logz = lse(logz2);
       u[m] = mu-logz;}
     xtu_subject[m].axpy(xsub, u[m]);
@@ -329,7 +329,7 @@ namespace BOOM{
     for(uint m=0; m<M; ++m){
       boost::shared_ptr<DafeLoglike> loglike(new DafeLoglike(mlm_,m));
       Logp logpost(loglike, subject_pri());
-      Ptr<MH> sam = new MH(logpost,subject_proposals_[m]);
+      Ptr<MH> sam = new MH(logpost,subject_proposals_[m], &rng());
       subject_samplers_.push_back(sam);
     }
 
@@ -337,7 +337,7 @@ namespace BOOM{
     if(pch>0){
       boost::shared_ptr<DafeLoglike> choice_loglike(new DafeLoglike(mlm_,0, true));
       Logp choice_logpost(choice_loglike, choice_pri());
-      choice_sampler_ = new MH(choice_logpost, choice_proposal_);
+      choice_sampler_ = new MH(choice_logpost, choice_proposal_, &rng());
     }
 
   }
@@ -114,7 +114,8 @@ namespace BOOM {
     }
     mh_sampler_.reset(new MetropolisHastings(
         target,
-        new MvtIndepProposal(log_alpha_beta, -Hessian, 3)));
+        new MvtIndepProposal(log_alpha_beta, -Hessian, 3),
+        &rng()));
     log_alpha_beta[0] = exp(log_alpha_beta[0]);
     model_->unvectorize_params(log_alpha_beta);
   }
@@ -0,0 +1,328 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include <Models/Glm/PosteriorSamplers/IncrementalSlabPosterior.hpp>
+#include <LinAlg/Cholesky.hpp>
+#include <LinAlg/SubMatrix.hpp>
+#include <cpputil/report_error.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace BOOM {
+
+  namespace {
+    typedef IncrementalSlabPosterior ISP;
+
+    double log_diagonal_sum(const Matrix &L, int k) {
+      double ans = 0;
+      for (int i = 0; i < k; ++i) {
+        ans += std::log(L(i, i));
+      }
+      return ans;
+    }
+  }  // namespace
+
+  ISP::IncrementalSlabPosterior()
+      : prior_precision_(nullptr),
+        prior_precision_diagonal_(nullptr),
+        prior_precision_scale_(1.0),
+        prior_mean_(nullptr),
+        sparse_xtx_(nullptr),
+        data_weight_(1.0),
+        mahalanobis_current_(false),
+        prior_mahalanobis_(0),
+        posterior_mahalanobis_(0)
+  {}
+
+  bool ISP::reset(const Selector &inclusion_indicators,
+                  const SpdMatrix &prior_precision,
+                  double prior_precision_scale,
+                  const Vector &prior_mean,
+                  const SpdMatrix &xtx,
+                  const Vector &xty,
+                  double data_weight) {
+    if (xtx.nrow() != prior_mean.size()) {
+      report_error("Arguments of incompatible dimension passed to "
+                   "IncrementalSlabPosterior::reset.");
+    }
+    xtx_ = xtx;
+    sparse_xtx_ = nullptr;
+    prior_precision_ = &prior_precision;
+    prior_precision_diagonal_ = nullptr;
+    return reset_factors(inclusion_indicators, prior_precision.nrow(),
+                         prior_precision_scale, prior_mean, xty,
+                         data_weight);
+  }
+
+  bool ISP::reset(const Selector &inclusion_indicators,
+                  const SpdMatrix &prior_precision,
+                  double prior_precision_scale,
+                  const Vector &prior_mean,
+                  const SparseCrossProductMatrix &xtx,
+                  const Vector &xty,
+                  double data_weight) {
+    if (xtx.dim() != prior_mean.size()) {
+      report_error("Arguments of incompatible dimension passed to "
+                   "IncrementalSlabPosterior::reset.");
+    }
+    xtx_ = SpdMatrix();
+    sparse_xtx_ = &xtx;
+    prior_precision_ = &prior_precision;
+    prior_precision_diagonal_ = nullptr;
+    return reset_factors(inclusion_indicators, prior_precision.nrow(),
+                         prior_precision_scale, prior_mean, xty,
+                         data_weight);
+  }
+
+  bool ISP::reset(const Selector &inclusion_indicators,
+                  const Vector &prior_precision_diagonal,
+                  double prior_precision_scale,
+                  const Vector &prior_mean,
+                  const SparseCrossProductMatrix &xtx,
+                  const Vector &xty,
+                  double data_weight) {
+    if (xtx.dim() != prior_mean.size()) {
+      report_error("Arguments of incompatible dimension passed to "
+                   "IncrementalSlabPosterior::reset.");
+    }
+    xtx_ = SpdMatrix();
+    sparse_xtx_ = &xtx;
+    prior_precision_ = nullptr;
+    prior_precision_diagonal_ = &prior_precision_diagonal;
+    return reset_factors(inclusion_indicators, prior_precision_diagonal.size(),
+                         prior_precision_scale, prior_mean, xty,
+                         data_weight);
+  }
+
+  bool ISP::reset_factors(const Selector &inclusion_indicators,
+                          int prior_dim,
+                          double prior_precision_scale,
+                          const Vector &prior_mean,
+                          const Vector &xty,
+                          double data_weight) {
+    int p = prior_mean.size();
+    if (prior_dim != p
+        || xty.size() != p
+        || inclusion_indicators.nvars_possible() != p) {
+      report_error("Arguments of incompatible dimension passed to "
+                   "IncrementalSlabPosterior::reset.");
+    }
+    prior_precision_scale_ = prior_precision_scale;
+    prior_mean_ = &prior_mean;
+    xty_ = xty;
+    data_weight_ = data_weight;
+
+    if (factor_position_.size() != p) {
+      prior_chol_ = Matrix();
+      posterior_chol_ = Matrix();
+    }
+    positions_.clear();
+    factor_position_.assign(p, -1);
+    mahalanobis_current_ = false;
+    ensure_capacity(inclusion_indicators.nvars());
+
+    bool ok = true;
+    for (int i = 0; i < inclusion_indicators.nvars(); ++i) {
+      ok = add(inclusion_indicators.indx(i));
+      if (!ok) break;
+    }
+    return ok;
+  }
+
+  void ISP::ensure_capacity(int size) {
+    int capacity = prior_chol_.nrow();
+    if (size <= capacity) return;
+    int p = factor_position_.size();
+    int new_capacity = std::min<int>(p, std::max(size, 2 * capacity));
+    new_capacity = std::max(new_capacity, std::min(p, 16));
+    int k = nvars();
+    Matrix prior_chol(new_capacity, new_capacity);
+    Matrix posterior_chol(new_capacity, new_capacity);
+    for (int r = 0; r < k; ++r) {
+      for (int c = 0; c <= r; ++c) {
+        prior_chol(r, c) = prior_chol_(r, c);
+        posterior_chol(r, c) = posterior_chol_(r, c);
+      }
+    }
+    prior_chol_.swap(prior_chol);
+    posterior_chol_.swap(posterior_chol);
+    workspace_.resize(new_capacity + 1);
+    b_.resize(new_capacity);
+  }
+
+  bool ISP::flip(int i) {
+    if (inc(i)) {
+      drop(i);
+      return true;
+    } else {
+      return add(i);
+    }
+  }
+
+  bool ISP::add(int i) {
+    if (inc(i)) return true;
+    int k = nvars();
+    ensure_capacity(k + 1);
+    for (int r = 0; r < k; ++r) {
+      workspace_[r] = prior_precision(positions_[r], i);
+    }
+    workspace_[k] = prior_precision(i, i);
+    if (!append_row(prior_chol_, k, workspace_)) return false;
+
+    for (int r = 0; r < k; ++r) {
+      workspace_[r] = posterior_precision(positions_[r], i);
+    }
+    workspace_[k] = posterior_precision(i, i);
+    // If this fails then the new row of prior_chol_ is ignored,
+    // because it lies outside the leading k x k block.
+    if (!append_row(posterior_chol_, k, workspace_)) return false;
+
+    positions_.push_back(i);
+    factor_position_[i] = k;
+    mahalanobis_current_ = false;
+    return true;
+  }
+
+  void ISP::drop(int i) {
+    int m = factor_position_[i];
+    if (m < 0) return;
+    int k = nvars();
+    remove_row(prior_chol_, k, m);
+    remove_row(posterior_chol_, k, m);
+    positions_.erase(positions_.begin() + m);
+    factor_position_[i] = -1;
+    for (int r = m; r < positions_.size(); ++r) {
+      factor_position_[positions_[r]] = r;
+    }
+    mahalanobis_current_ = false;
+  }
+
+  void ISP::restore(int i, bool included) {
+    if (inc(i) == included) return;
+    if (!included) {
+      drop(i);
+    } else if (!add(i)) {
+      std::vector<int> positions(positions_);
+      positions.push_back(i);
+      positions_.clear();
+      factor_position_.assign(factor_position_.size(), -1);
+      mahalanobis_current_ = false;
+      for (int r = 0; r < positions.size(); ++r) {
+        if (!add(positions[r])) {
+          report_error("IncrementalSlabPosterior could not restore a "
+                       "previously valid model.");
+        }
+      }
+    }
+  }
+
+  double ISP::prior_logdet() const {
+    return 2 * log_diagonal_sum(prior_chol_, nvars());
+  }
+
+  double ISP::posterior_logdet() const {
+    return 2 * log_diagonal_sum(posterior_chol_, nvars());
+  }
+
+  double ISP::prior_mahalanobis() const {
+    ensure_mahalanobis();
+    return prior_mahalanobis_;
+  }
+
+  double ISP::posterior_mahalanobis() const {
+    ensure_mahalanobis();
+    return posterior_mahalanobis_;
+  }
+
+  // Solves L * l = column[0..k-1] by forward substitution, then
+  // writes l and sqrt(column[k] - l'l) into row k of L.
+  bool ISP::append_row(Matrix &L, int k, Vector &column) {
+    double ss = 0;
+    for (int r = 0; r < k; ++r) {
+      double value = column[r];
+      for (int s = 0; s < r; ++s) {
+        value -= L(r, s) * column[s];
+      }
+      value /= L(r, r);
+      column[r] = value;
+      ss += value * value;
+    }
+    double diagonal = column[k] - ss;
+    if (!(diagonal > 0)) return false;
+    for (int r = 0; r < k; ++r) {
+      L(k, r) = column[r];
+    }
+    L(k, k) = std::sqrt(diagonal);
+    return true;
+  }
+
+  // If L = [L11 0 0; l21 l22 0; L31 l32 L33] with l22 in position m,
+  // the factor of the matrix with row and column m removed is
+  // [L11 0; L31 L33'], where L33' L33'^T = L33 L33^T + l32 l32^T.
+  void ISP::remove_row(Matrix &L, int k, int m) {
+    int trailing = k - 1 - m;
+    if (trailing > 0) {
+      for (int r = 0; r < trailing; ++r) {
+        workspace_[r] = L(m + 1 + r, m);
+      }
+      cholesky_rank_one_update(
+          SubMatrix(L, m + 1, k - 1, m + 1, k - 1),
+          VectorView(workspace_, 0, trailing));
+    }
+    // Shift rows below m up by one, and columns right of m left by one.
+    for (int r = m + 1; r < k; ++r) {
+      for (int c = 0; c < m; ++c) {
+        L(r - 1, c) = L(r, c);
+      }
+      for (int c = m + 1; c <= r; ++c) {
+        L(r - 1, c - 1) = L(r, c);
+      }
+    }
+  }
+
+  void ISP::ensure_mahalanobis() const {
+    if (mahalanobis_current_) return;
+    int k = nvars();
+    const Vector &mu(*prior_mean_);
+    double prior_quadratic = 0;
+    for (int r = 0; r < k; ++r) {
+      int i = positions_[r];
+      double omega_mu = 0;
+      for (int s = 0; s < k; ++s) {
+        omega_mu += prior_precision(i, positions_[s]) * mu[positions_[s]];
+      }
+      prior_quadratic += mu[i] * omega_mu;
+      b_[r] = data_weight_ * xty_[i] + omega_mu;
+    }
+    // Forward substitution: b = L^{-1} b.
+    double posterior_quadratic = 0;
+    for (int r = 0; r < k; ++r) {
+      double value = b_[r];
+      for (int s = 0; s < r; ++s) {
+        value -= posterior_chol_(r, s) * b_[s];
+      }
+      value /= posterior_chol_(r, r);
+      b_[r] = value;
+      posterior_quadratic += value * value;
+    }
+    prior_mahalanobis_ = prior_quadratic;
+    posterior_mahalanobis_ = posterior_quadratic;
+    mahalanobis_current_ = true;
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,87 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include <Models/Glm/PosteriorSamplers/LogitPolyaGammaSampler.hpp>
+#include <distributions.hpp>
+#include <distributions/polya_gamma.hpp>
+#include <cpputil/report_error.hpp>
+
+namespace BOOM {
+  namespace {
+    typedef LogitPolyaGammaSampler LPGS;
+    typedef LogitPolyaGammaRegressionDataImputer LPGRDI;
+  }  // namespace
+
+  LPGRDI::LogitPolyaGammaRegressionDataImputer(const GlmCoefs *coefficients)
+      : coefficients_(coefficients)
+  {}
+
+  void LPGRDI::impute_latent_data(const BinaryRegressionData &observation,
+                                  WeightedRegSuf *suf,
+                                  RNG &rng) const {
+    const Vector &x(observation.x());
+    double omega = rpolya_gamma_mt(rng, 1.0, coefficients_->predict(x));
+    double kappa = observation.y() ? 0.5 : -0.5;
+    suf->add_data(x, kappa / omega, omega);
+  }
+
+  //======================================================================
+  LPGS::LogitPolyaGammaSampler(LogisticRegressionModel *model,
+                               Ptr<MvnBase> prior,
+                               RNG &seeding_rng)
+      : PosteriorSampler(seeding_rng),
+        model_(model),
+        prior_(prior),
+        suf_(model->xdim()),
+        parallel_data_imputer_(suf_, model_)
+  {
+    set_number_of_workers(1);
+  }
+
+  double LPGS::logpri() const {
+    return prior_->logp(model_->Beta());
+  }
+
+  void LPGS::draw() {
+    impute_latent_data();
+    draw_params();
+  }
+
+  void LPGS::impute_latent_data() {
+    suf_ = parallel_data_imputer_.impute();
+  }
+
+  void LPGS::draw_params() {
+    SpdMatrix ivar = prior_->siginv() + suf_.xtx();
+    Vector ivar_mu = suf_.xty() + prior_->siginv() * prior_->mu();
+    model_->set_Beta(rmvn_suf_mt(rng(), ivar, ivar_mu));
+  }
+
+  void LPGS::set_number_of_workers(int n) {
+    if (n < 1) {
+      report_error("At least one data imputation worker is needed.");
+    }
+    parallel_data_imputer_.clear_workers();
+    for (int i = 0; i < n; ++i) {
+      parallel_data_imputer_.add_worker(
+          new LPGRDI(model_->coef_prm().get()), rng());
+    }
+    parallel_data_imputer_.assign_data();
+  }
+
+}  // namespace BOOM
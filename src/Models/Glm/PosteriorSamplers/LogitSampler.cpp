@@ -63,13 +63,13 @@ namespace BOOM{
   void LS::draw_beta(){
     ivar = pri_->siginv() + suf_->xtx();
     ivar_mu = pri_->siginv() * pri_->mu() + suf_->xty();
-    ivar_mu = rmvn_suf(ivar, ivar_mu);
+    ivar_mu = rmvn_suf_mt(rng(), ivar, ivar_mu);
     mod_->set_Beta(ivar_mu);
   }
 
   double LS::draw_z(bool y, double eta)const{
     double trun_prob = plogis(0, eta);
-    double u = y ? runif(trun_prob,1) : runif(0,trun_prob);
+    double u = y ? runif_mt(rng(), trun_prob,1) : runif_mt(rng(), 0,trun_prob);
     return qlogis(u,eta);
   }
 
@@ -61,10 +61,10 @@ namespace BOOM{
   void LSB::limit_model_selection(uint n){ max_nflips_ = n;}
 
 
-  static inline bool keep_flip(double logp_old, double logp_new){
+  static inline bool keep_flip(RNG &rng, double logp_old, double logp_new){
     if(!std::isfinite(logp_new)) return false;
     double pflip = logit_inv(logp_new - logp_old);
-    double u = runif(0,1);
+    double u = runif_mt(rng, 0,1);
     return u < pflip ? true : false;
   }
 
@@ -87,13 +87,18 @@ namespace BOOM{
     }
 
     std::vector<uint> flips = seq<uint>(0, nv-1);
-    std::random_shuffle(flips.begin(), flips.end());
+    // I'd like to rely on std::random_shuffle for this, but I want
+    // control over the random number generator.
+    for (int i = flips.size() - 1; i > 0; --i) {
+      int j = random_int_mt(rng(), 0, i);
+      if (j != i) std::swap(flips[i], flips[j]);
+    }
     uint hi = std::min<uint>(nv, max_nflips_);
     for(uint i=0; i<hi; ++i){
       uint I = flips[i];
       inc.flip(I);
       double logp_new = log_model_prob(inc);
-      if( keep_flip(logp, logp_new)) logp = logp_new;
+      if( keep_flip(rng(), logp, logp_new)) logp = logp_new;
       else inc.flip(I);  // reject the flip, so flip back
     }
     mod_->coef().set_inc(inc);
@@ -131,7 +136,7 @@ namespace BOOM{
     Ominv = inc.select(pri_->siginv());
     SpdMatrix ivar = Ominv + inc.select(suf()->xtx());
     Vector b = inc.select(suf()->xty()) + Ominv * inc.select(pri_->mu());
-    b = rmvn_suf(ivar, b);
+    b = rmvn_suf_mt(rng(), ivar, b);
     mod_->set_included_coefficients(b);
   }
 
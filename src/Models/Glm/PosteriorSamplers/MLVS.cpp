@@ -114,8 +114,7 @@ namespace BOOM{
       SpdMatrix Ominv = inc.select(pri->siginv());
       SpdMatrix ivar = Ominv + inc.select(suf_.xtwx());
       Vector b = inc.select(suf_.xtwu()) + Ominv *inc.select(pri->mu());
-      b = ivar.solve(b);
-      Vector beta = rmvn_ivar(b,ivar);
+      Vector beta = rmvn_suf_mt(rng(), Chol(ivar), b);
       uint n = b.size();
       for (uint i=0; i<n; ++i) {
         uint I = inc.indx(i);
@@ -125,19 +124,20 @@ namespace BOOM{
     mod_->set_beta(Beta);
   }
 
-  inline bool keep_flip(double logp_old, double logp_new) {
+  inline bool keep_flip(RNG &rng, double logp_old, double logp_new) {
     if (!std::isfinite(logp_new)) return false;
     double pflip = logit_inv(logp_new - logp_old);
-    double u = runif (0,1);
+    double u = runif_mt(rng, 0,1);
     return u < pflip ? true : false;
   }
 
   void MLVS::draw_inclusion_vector() {
     Selector inc = mod_->coef().inc();
     uint nv = inc.nvars_possible();
-    double logp = log_model_prob(inc);
+    bool ok = slab_posterior_.reset(
+        inc, pri->siginv(), 1.0, pri->mu(), suf_.xtwx(), suf_.xtwu(), 1.0);
+    double logp = ok ? log_model_prob(inc) : negative_infinity();
     if (!std::isfinite(logp)) {
-      logp = log_model_prob(inc);
       ostringstream err;
       err << "MLVS did not start with a legal configuration." << endl
           << "Selector vector:  " << inc << endl
@@ -146,14 +146,23 @@ namespace BOOM{
     }
 
     std::vector<uint> flips = seq<uint>(0, nv-1);
-    std::random_shuffle(flips.begin(), flips.end());
+    // I'd like to rely on std::random_shuffle for this, but I want
+    // control over the random number generator.
+    for (int i = flips.size() - 1; i > 0; --i) {
+      int j = random_int_mt(rng(), 0, i);
+      if (j != i) std::swap(flips[i], flips[j]);
+    }
     uint hi = std::min<uint>(nv, max_nflips());
     for (uint i=0; i<hi; ++i) {
       uint I = flips[i];
       inc.flip(I);
-      double logp_new = log_model_prob(inc);
-      if ( keep_flip(logp, logp_new)) logp = logp_new;
-      else inc.flip(I);  // reject the flip, so flip back
+      double logp_new = slab_posterior_.flip(I)
+          ? log_model_prob(inc) : negative_infinity();
+      if ( keep_flip(rng(), logp, logp_new)) logp = logp_new;
+      else {
+        inc.flip(I);  // reject the flip, so flip back
+        slab_posterior_.restore(I, inc.inc(I));
+      }
     }
     mod_->coef().set_inc(inc);
   }
@@ -166,7 +175,7 @@ namespace BOOM{
   //______________________________________________________________________
   // computing probabilities
 
-  double MLVS::log_model_prob(const Selector & g) {
+  double MLVS::log_model_prob(const Selector & g) const {
     double num = vpri->logp(g);
     if (num==BOOM::negative_infinity()) return num;
     if (g.nvars() == 0) {
@@ -174,23 +183,13 @@ namespace BOOM{
       return num;
     }
 
-    Ominv = g.select(pri->siginv());
-    num += .5*Ominv.logdet();
+    num += .5 * slab_posterior_.prior_logdet();
     if (num == BOOM::negative_infinity()) return num;
+    num -= .5 * slab_posterior_.prior_mahalanobis();
 
-    Vector mu = g.select(pri->mu());
-    Vector Ominv_mu = Ominv * mu;
-    num -= .5*mu.dot(Ominv_mu);
-
-    bool ok=true;
-    iV_tilde_ = Ominv + g.select(suf_.xtwx());
-    Matrix L = iV_tilde_.chol(ok);
-    if (!ok)  return BOOM::negative_infinity();
-    double denom = sum(log(L.diag()));  // = .5 log |Ominv|
-
-    Vector S = g.select(suf_.xtwu()) + Ominv_mu;
-    Lsolve_inplace(L,S);
-    denom-= .5*S.normsq();  // S.normsq =  beta_tilde ^T V_tilde beta_tilde
+    double denom = .5 * slab_posterior_.posterior_logdet();
+    // posterior_mahalanobis =  beta_tilde ^T V_tilde beta_tilde
+    denom -= .5 * slab_posterior_.posterior_mahalanobis();
 
     return num-denom;
   }
@@ -55,8 +55,7 @@ namespace BOOM{
     SpdMatrix ivar = (xtx)*(1+k/n);
     const Vector &B(b->value());
     Vector mean = mnp->xty() + (xtx*B)*(k/n);
-    mean = ivar.solve(mean);
-    Vector beta = rmvn_ivar(mean, ivar);
+    Vector beta = rmvn_suf_mt(rng(), Chol(ivar), mean);
     if(b0_fixed){
       uint start = 0;
       uint p = mnp->subject_nvars();
@@ -33,8 +33,7 @@ namespace BOOM{
   void MBS::draw(){
     SpdMatrix ivar = mnp->xtx() + pri->siginv();
     Vector mean = mnp->xty() + pri->siginv()*pri->mu();
-    mean = ivar.solve(mean);
-    Vector beta = rmvn_ivar(mean, ivar);
+    Vector beta = rmvn_suf_mt(rng(), Chol(ivar), mean);
     if(b0_fixed){
       uint start = 0;
       uint p = mnp->subject_nvars();
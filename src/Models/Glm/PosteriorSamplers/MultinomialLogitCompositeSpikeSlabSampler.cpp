@@ -191,7 +191,7 @@ namespace BOOM {
           prior_.get(),
           full_chunk_size,
           chunk);
-      TIM tim_sampler(logpost, tdf_);
+      TIM tim_sampler(logpost, tdf_, &rng());
       int start = full_chunk_size * chunk;
       int beta_dim = beta.size();  // type coercsion uint -> int
       int chunk_size = std::min<int>(full_chunk_size, beta_dim - start);
@@ -64,7 +64,7 @@ namespace BOOM{
     Ptr<MvRegSuf> s(mod->suf());
     SpdMatrix sumsq = SS + s->SSE(mod->Beta());
     double df = prior_df + s->n();
-    SpdMatrix ans = rWish(df, sumsq.inv());
+    SpdMatrix ans = rWish_mt(rng(), df, sumsq.inv());
     mod->set_Siginv(ans);
   }
 }
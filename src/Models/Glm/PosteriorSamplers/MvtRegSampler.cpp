@@ -48,7 +48,7 @@ namespace BOOM{
     reg_sampler = new MvRegSampler(reg_model.get(), B_guess, prior_nobs, prior_df, Sigma_guess);
     nu_model->set_prm(mod->Nu_prm());
     Logp_nu nu_logpost(nu_model, nu_prior);
-    nu_sampler = new SliceSampler(nu_logpost, true);
+    nu_sampler = new SliceSampler(nu_logpost, true, &rng());
   }
 
   void MVTRS::draw(){
@@ -91,7 +91,7 @@ namespace BOOM{
     yhat = mod->predict(x);
     double nu = mod->nu();
     double ss = mod->Siginv().Mdist(y,yhat);
-    double w = rgamma( (nu+y.size())/2, (nu+ss)/2);
+    double w = rgamma_mt(rng(), (nu+y.size())/2, (nu+ss)/2);
     return w;
   }
 
@@ -111,7 +111,71 @@ namespace BOOM {
 
   void PRAMS::impute_latent_data() {
     if (!latent_data_fixed_) {
-      complete_data_suf_ = parallel_data_imputer_.impute();
+      if (!!model_->columnar_data()) {
+        impute_columnar_latent_data();
+      } else {
+        complete_data_suf_ = parallel_data_imputer_.impute();
+      }
+    }
+  }
+
+  // Each row contributes an internal observation (if y > 0) and an
+  // external observation, both with the same predictors.  They are
+  // added to the sufficient statistics as two blocks, with the
+  // internal weight set to zero for rows with y == 0.
+  void PRAMS::impute_columnar_latent_data() {
+    columnar_imputer_.impute(
+        *model_->columnar_data(),
+        parallel_data_imputer_.number_of_workers(),
+        &complete_data_suf_,
+        rng(),
+        [this](int begin, int end, WeightedRegSuf *suf, RNG &rng) {
+          impute_columnar_rows(begin, end, suf, rng);
+        });
+  }
+
+  void PRAMS::impute_columnar_rows(int begin, int end,
+                                   WeightedRegSuf *suf,
+                                   RNG &rng) const {
+    const ColumnarRegressionData &data(*model_->columnar_data());
+    PoissonDataImputer imputer;
+    const Vector &beta(model_->Beta());
+    const int block_size = ColumnarRegressionData::kBlockSize;
+    Vector eta(block_size);
+    Vector internal_y(block_size), internal_weight(block_size);
+    Vector external_y(block_size), external_weight(block_size);
+    for (int first = begin; first < end; first += block_size) {
+      int rows = std::min(block_size, end - first);
+      data.predict(beta, first, VectorView(eta, 0, rows));
+      for (int i = 0; i < rows; ++i) {
+        int y = lround(data.y(first + i));
+        double internal_neglog_final_event_time = 0;
+        double internal_mu = 0;
+        double neglog_final_interarrival_time;
+        double external_mu;
+        internal_weight[i] = 0;
+        imputer.impute(rng,
+                       y,
+                       data.weight(first + i),
+                       eta[i],
+                       &internal_neglog_final_event_time,
+                       &internal_mu,
+                       &internal_weight[i],
+                       &neglog_final_interarrival_time,
+                       &external_mu,
+                       &external_weight[i]);
+        if (y == 0) internal_weight[i] = 0;
+        internal_y[i] = internal_neglog_final_event_time - internal_mu;
+        external_y[i] = neglog_final_interarrival_time - external_mu;
+      }
+      suf->add_columnar_data(
+          data, first,
+          ConstVectorView(internal_y, 0, rows),
+          ConstVectorView(internal_weight, 0, rows));
+      suf->add_columnar_data(
+          data, first,
+          ConstVectorView(external_y, 0, rows),
+          ConstVectorView(external_weight, 0, rows));
     }
   }
 
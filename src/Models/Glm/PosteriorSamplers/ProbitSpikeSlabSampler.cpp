@@ -89,7 +89,7 @@ namespace BOOM{
   bool PSSS::keep_flip(double logp_old, double logp_new)const{
     if(!std::isfinite(logp_new)) return false;
     double pflip = logit_inv(logp_new - logp_old);
-    double u = runif(0,1);
+    double u = runif_mt(rng(), 0,1);
     return u < pflip ? true : false;
   }
 
@@ -108,7 +108,12 @@ namespace BOOM{
 
     // do the sampling in random order
     std::vector<uint> flips = seq<uint>(0, nv-1);
-    std::random_shuffle(flips.begin(), flips.end());
+    // I'd like to rely on std::random_shuffle for this, but I want
+    // control over the random number generator.
+    for (int i = flips.size() - 1; i > 0; --i) {
+      int j = random_int_mt(rng(), 0, i);
+      if (j != i) std::swap(flips[i], flips[j]);
+    }
 
     uint hi = std::min<uint>(nv, max_nflips());
     for(uint i=0; i<hi; ++i){
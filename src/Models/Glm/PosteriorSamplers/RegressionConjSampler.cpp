@@ -61,7 +61,7 @@ namespace BOOM{
         DF - prior_df(),
         SS - prior_ss());
     ivar /= sigsq;
-    beta_tilde = rmvn_ivar(beta_tilde, ivar);
+    beta_tilde = rmvn_ivar_mt(rng(), beta_tilde, ivar);
     m_->set_Beta(beta_tilde);
     m_->set_sigsq(sigsq);
   }
@@ -0,0 +1,78 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include <Models/Glm/PosteriorSamplers/RegressionSpikeSlabSampler.hpp>
+#include <cpputil/math_utils.hpp>
+#include <distributions.hpp>
+
+namespace BOOM {
+
+  typedef RegressionSpikeSlabSampler RSSS;
+
+  RSSS::RegressionSpikeSlabSampler(
+      RegressionModel *model,
+      Ptr<MvnBase> slab,
+      Ptr<VariableSelectionPrior> spike,
+      Ptr<GammaModelBase> residual_precision_prior,
+      RNG &seeding_rng)
+      : PosteriorSampler(seeding_rng),
+        model_(model),
+        slab_(slab),
+        spike_(spike),
+        residual_precision_prior_(residual_precision_prior),
+        spike_slab_sampler_(model_, slab_, spike_),
+        sigsq_sampler_(residual_precision_prior_)
+  {}
+
+  void RSSS::draw() {
+    draw_model_indicators_and_coefficients();
+    draw_sigma_full_conditional();
+  }
+
+  double RSSS::logpri() const {
+    return spike_slab_sampler_.logpri() +
+        residual_precision_prior_->logp(1.0 / model_->sigsq());
+  }
+
+  void RSSS::draw_model_indicators_and_coefficients() {
+    double sigsq = model_->sigsq();
+    Ptr<RegSuf> suf = model_->suf();
+    const SparseRegSuf *sparse_suf =
+        dynamic_cast<const SparseRegSuf *>(suf.get());
+    if (sparse_suf) {
+      spike_slab_sampler_.draw_model_indicators(rng(), *sparse_suf, sigsq);
+      spike_slab_sampler_.draw_beta(rng(), *sparse_suf, sigsq);
+    } else {
+      if (!dense_suf_) {
+        dense_suf_ = new WeightedRegSuf(model_->xdim());
+      }
+      dense_suf_->set_xtwx(suf->xtx());
+      dense_suf_->set_xtwy(suf->xty());
+      spike_slab_sampler_.draw_model_indicators(rng(), *dense_suf_, sigsq);
+      spike_slab_sampler_.draw_beta(rng(), *dense_suf_, sigsq);
+    }
+  }
+
+  void RSSS::draw_sigma_full_conditional() {
+    double data_df = model_->suf()->n();
+    double data_ss = model_->suf()->relative_sse(model_->coef());
+    double sigsq = sigsq_sampler_.draw(rng(), data_df, data_ss);
+    model_->set_sigsq(sigsq);
+  }
+
+}  // namespace BOOM
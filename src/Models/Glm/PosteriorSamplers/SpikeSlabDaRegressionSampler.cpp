@@ -263,11 +263,14 @@ namespace BOOM {
     Vector prior_mean = inclusion_indicators.select(beta_prior_->mu());
     Vector posterior_mean = suf.xty(inclusion_indicators) +
         unscaled_prior_information * prior_mean;
-    posterior_mean = posterior_information.solve(posterior_mean);
+    Chol posterior_information_chol(posterior_information);
+    posterior_mean = posterior_information_chol.solve(posterior_mean);
 
-    posterior_information /= model_->sigsq();
+    // The posterior precision is posterior_information / sigsq.
+    // Scaling the Cholesky factor by 1/sigma reuses the decomposition.
     Vector included_coefficients = rmvn_ivar_mt(
-        rng(), posterior_mean, posterior_information);
+        rng(), posterior_mean,
+        posterior_information_chol * (1.0 / sqrt(model_->sigsq())));
     model_->set_included_coefficients(included_coefficients);
   }
 
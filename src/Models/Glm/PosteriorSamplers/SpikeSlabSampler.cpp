@@ -1,4 +1,5 @@
 #include <Models/Glm/PosteriorSamplers/SpikeSlabSampler.hpp>
+#include <Models/IndependentMvnModel.hpp>
 #include <distributions.hpp>
 #include <cpputil/seq.hpp>
 #include <cpputil/math_utils.hpp>
@@ -24,6 +25,21 @@ namespace BOOM {
   void SSS::draw_model_indicators(RNG &rng,
                                   const WeightedRegSuf &suf,
                                   double sigsq) {
+    sweep_model_indicators(rng, [this, &suf, sigsq](const Selector &g) {
+        return reset_slab_posterior(g, suf, sigsq);
+      });
+  }
+
+  void SSS::draw_model_indicators(RNG &rng,
+                                  const SparseRegSuf &suf,
+                                  double sigsq) {
+    sweep_model_indicators(rng, [this, &suf, sigsq](const Selector &g) {
+        return reset_slab_posterior(g, suf, sigsq);
+      });
+  }
+
+  void SSS::sweep_model_indicators(
+      RNG &rng, const std::function<bool(const Selector &)> &reset) {
     if (!allow_model_selection_) return;
     Selector inclusion_indicators = model_->coef().inc();
     std::vector<int> indx = seq<int>(
@@ -38,11 +54,13 @@ namespace BOOM {
       }
     }
 
-    double logp = log_model_prob(inclusion_indicators, suf, sigsq);
+    double logp = reset(inclusion_indicators)
+        ? log_model_prob(inclusion_indicators) : negative_infinity();
 
     if(!std::isfinite(logp)){
       spike_prior_->make_valid(inclusion_indicators);
-      logp = log_model_prob(inclusion_indicators, suf, sigsq);
+      logp = reset(inclusion_indicators)
+          ? log_model_prob(inclusion_indicators) : negative_infinity();
     }
     if(!std::isfinite(logp)){
       ostringstream err;
@@ -56,8 +74,7 @@ namespace BOOM {
     uint n = inclusion_indicators.nvars_possible();
     if(max_flips_ > 0) n = std::min<int>(n, max_flips_);
     for(int i = 0; i < n; ++i){
-      logp = mcmc_one_flip(
-          rng, inclusion_indicators, indx[i], logp, suf, sigsq);
+      logp = mcmc_one_flip(rng, inclusion_indicators, indx[i], logp);
     }
     model_->coef().set_inc(inclusion_indicators);
   }
@@ -68,14 +85,37 @@ namespace BOOM {
       model_->drop_all();
       return;
     }
-    SpdMatrix precision = inclusion_indicators.select(
-        slab_prior_->siginv());
+    draw_included_coefficients(rng,
+                               inclusion_indicators,
+                               inclusion_indicators.select(suf.xtx()),
+                               inclusion_indicators.select(suf.xty()),
+                               sigsq);
+  }
+
+  void SSS::draw_beta(RNG &rng, const SparseRegSuf &suf, double sigsq) {
+    Selector inclusion_indicators = model_->coef().inc();
+    if(inclusion_indicators.nvars() == 0){
+      model_->drop_all();
+      return;
+    }
+    draw_included_coefficients(rng,
+                               inclusion_indicators,
+                               suf.xtx(inclusion_indicators),
+                               suf.xty(inclusion_indicators),
+                               sigsq);
+  }
+
+  void SSS::draw_included_coefficients(RNG &rng,
+                                       const Selector &inclusion_indicators,
+                                       const SpdMatrix &included_xtx,
+                                       const Vector &included_xty,
+                                       double sigsq) {
+    SpdMatrix precision = included_prior_precision(inclusion_indicators);
     Vector precision_mu = precision *
         inclusion_indicators.select(slab_prior_->mu());
-    precision += inclusion_indicators.select(suf.xtx()) / sigsq;
-    precision_mu += inclusion_indicators.select(suf.xty()) / sigsq;
-    Vector coefficients = precision.solve(precision_mu);
-    coefficients = rmvn_ivar_mt(rng, coefficients, precision);
+    precision += included_xtx / sigsq;
+    precision_mu += included_xty / sigsq;
+    Vector coefficients = rmvn_suf_mt(rng, Chol(precision), precision_mu);
 
     // If model selection is turned off and some elements of beta
     // happen to be zero (because, e.inclusion_indicators., of a
@@ -90,7 +130,7 @@ namespace BOOM {
     if(inclusion_indicators.nvars() > 0){
       ans += dmvn(model_->included_coefficients(),
                   inclusion_indicators.select(slab_prior_->mu()),
-                  inclusion_indicators.select(slab_prior_->siginv()),
+                  included_prior_precision(inclusion_indicators),
                   true);
     }
     return ans;
@@ -104,9 +144,7 @@ namespace BOOM {
     max_flips_ = max_flips;
   }
 
-  double SSS::log_model_prob(const Selector &inclusion_indicators,
-                             const WeightedRegSuf &suf,
-                             double sigsq) const {
+  double SSS::log_model_prob(const Selector &inclusion_indicators) const {
     double numerator = spike_prior_->logp(inclusion_indicators);
     if(numerator==BOOM::negative_infinity() ||
        inclusion_indicators.nvars() == 0){
@@ -119,38 +157,76 @@ namespace BOOM {
       // case below.
       return numerator;
     }
-    SpdMatrix precision = inclusion_indicators.select(slab_prior_->siginv());
-    numerator += .5*precision.logdet();
+    numerator += .5 * slab_posterior_.prior_logdet();
     if(numerator == BOOM::negative_infinity()) return numerator;
+    numerator -= .5 * slab_posterior_.prior_mahalanobis();
 
-    Vector mu = inclusion_indicators.select(slab_prior_->mu());
-    Vector precision_mu = precision * mu;
-    numerator -= .5*mu.dot(precision_mu);
-
-    bool ok = true;
-    precision += inclusion_indicators.select(suf.xtx()) / sigsq;
-    Matrix L = precision.chol(ok);
-    if(!ok)  return BOOM::negative_infinity();
-    double denominator = sum(log(L.diag()));  // = .5 log |precision|
-    Vector S = inclusion_indicators.select(suf.xty()) / sigsq + precision_mu;
-    Lsolve_inplace(L,S);
-    denominator -= .5 * S.normsq();
-    // S.normsq =  beta_tilde ^T V_tilde beta_tilde
+    double denominator = .5 * slab_posterior_.posterior_logdet();
+    // posterior_mahalanobis = beta_tilde ^T V_tilde beta_tilde
+    denominator -= .5 * slab_posterior_.posterior_mahalanobis();
     return numerator - denominator;
   }
 
+  bool SSS::reset_slab_posterior(const Selector &inclusion_indicators,
+                                 const WeightedRegSuf &suf,
+                                 double sigsq) {
+    return slab_posterior_.reset(inclusion_indicators,
+                                 slab_prior_->siginv(),
+                                 1.0,
+                                 slab_prior_->mu(),
+                                 suf.xtx(),
+                                 suf.xty(),
+                                 1.0 / sigsq);
+  }
+
+  bool SSS::reset_slab_posterior(const Selector &inclusion_indicators,
+                                 const SparseRegSuf &suf,
+                                 double sigsq) {
+    const IndependentMvnModel *diagonal_prior =
+        dynamic_cast<const IndependentMvnModel *>(slab_prior_.get());
+    if (diagonal_prior) {
+      prior_precision_diagonal_ = 1.0 / diagonal_prior->sigsq();
+      return slab_posterior_.reset(inclusion_indicators,
+                                   prior_precision_diagonal_,
+                                   1.0,
+                                   slab_prior_->mu(),
+                                   suf.sparse_xtx(),
+                                   suf.xty(),
+                                   1.0 / sigsq);
+    }
+    return slab_posterior_.reset(inclusion_indicators,
+                                 slab_prior_->siginv(),
+                                 1.0,
+                                 slab_prior_->mu(),
+                                 suf.sparse_xtx(),
+                                 suf.xty(),
+                                 1.0 / sigsq);
+  }
+
+  SpdMatrix SSS::included_prior_precision(
+      const Selector &inclusion_indicators) const {
+    const IndependentMvnModel *diagonal_prior =
+        dynamic_cast<const IndependentMvnModel *>(slab_prior_.get());
+    if (diagonal_prior) {
+      SpdMatrix ans(inclusion_indicators.nvars(), 0.0);
+      ans.set_diag(1.0 / inclusion_indicators.select(diagonal_prior->sigsq()));
+      return ans;
+    }
+    return inclusion_indicators.select(slab_prior_->siginv());
+  }
+
   double SSS::mcmc_one_flip(
       RNG &rng,
       Selector &mod,
       int which_var,
-      double logp_old,
-      const WeightedRegSuf &suf,
-      double sigsq) {
+      double logp_old) {
     mod.flip(which_var);
-    double logp_new = log_model_prob(mod, suf, sigsq);
+    double logp_new = slab_posterior_.flip(which_var)
+        ? log_model_prob(mod) : negative_infinity();
     double u = runif_mt(rng, 0,1);
     if(log(u) > logp_new - logp_old){
       mod.flip(which_var);  // reject draw
+      slab_posterior_.restore(which_var, mod.inc(which_var));
       return logp_old;
     }
     return logp_new;
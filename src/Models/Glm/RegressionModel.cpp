@@ -55,6 +55,12 @@ namespace BOOM{
     return ans;
   }
 
+  void RegSuf::add_columnar_data(const ColumnarRegressionData &data) {
+    for (int i = 0; i < data.nobs(); ++i) {
+      add_mixture_data(data.y(i), data.x(i), data.weight(i));
+    }
+  }
+
   double RegSuf::relative_sse(const GlmCoefs &coefficients) const {
     double ans = yty();
     const Selector &inc(coefficients.inc());
@@ -322,7 +328,7 @@ namespace BOOM{
 
   void NeRegSuf::add_mixture_data(double y, const ConstVectorView &x, double prob){
     if(!xtx_is_fixed_) {
-      xtx_.add_outer(x, prob, false);
+      xtx_buffer_.add(x, prob, xtx_);
       needs_to_reflect_ = true;
     }
     xty_.axpy(x, y * prob);
@@ -334,6 +340,7 @@ namespace BOOM{
 
   void NeRegSuf::clear(){
     if(!xtx_is_fixed_) xtx_=0.0;
+    xtx_buffer_.clear();
     xty_=0.0;
     sumsqy=0.0;
     n_ = 0;
@@ -351,7 +358,7 @@ namespace BOOM{
     double y = rdp.y();
     xty_.axpy(tmpx, y);
     if(!xtx_is_fixed_) {
-      xtx_.add_outer(tmpx, 1.0, false);
+      xtx_buffer_.add(tmpx, 1.0, xtx_);
       needs_to_reflect_ = true;
     }
     sumsqy+= y*y;
@@ -359,6 +366,45 @@ namespace BOOM{
     x_column_sums_.axpy(tmpx, 1.0);
   }
 
+  void NeRegSuf::add_columnar_data(const ColumnarRegressionData &data) {
+    const int p = data.xdim();
+    if (p != xty_.size()) {
+      report_error("Columnar data has the wrong number of predictors.");
+    }
+    SpdMatrix unused_xtx;
+    if (xtx_is_fixed_) unused_xtx.resize(p);
+    SpdMatrix &xtx(xtx_is_fixed_ ? unused_xtx : xtx_);
+    const int nobs = data.nobs();
+    const int block_size = ColumnarRegressionData::kBlockSize;
+    Vector weighted_y(block_size);
+    for (int first = 0; first < nobs; first += block_size) {
+      int rows = std::min(block_size, nobs - first);
+      VectorView wy(weighted_y, 0, rows);
+      ConstVectorView y(data.y(), first, rows);
+      if (data.has_weights()) {
+        ConstVectorView w(data.weights(), first, rows);
+        for (int i = 0; i < rows; ++i) wy[i] = w[i] * y[i];
+        data.add_cross_products(first, w, wy, xtx, xty_);
+        sumsqy += wy.dot(y);
+        sumy_ += wy.sum();
+        n_ += w.sum();
+      } else {
+        wy = y;
+        data.add_cross_products(first, ConstVectorView(nullptr, 0, 1), wy,
+                                xtx, xty_);
+        sumsqy += y.normsq();
+        sumy_ += y.sum();
+        n_ += rows;
+      }
+    }
+    for (int j = 0; j < p; ++j) {
+      ConstVectorView column(data.X().col(j));
+      x_column_sums_[j] += data.has_weights()
+          ? column.dot(data.weights()) : column.sum();
+    }
+    needs_to_reflect_ = true;
+  }
+
   uint NeRegSuf::size()const{ return xtx_.ncol();}  // dim(beta)
   SpdMatrix NeRegSuf::xtx()const{
     reflect();
@@ -390,23 +436,19 @@ namespace BOOM{
   double NeRegSuf::ybar()const{ return sumy_/n_;}
 
   void NeRegSuf::combine(Ptr<RegSuf> sp){
-    Ptr<NeRegSuf> s(sp.dcast<NeRegSuf>());
-    xtx_ += s->xtx_;   // Do we want to combine xtx_ if xtx_is_fixed_?
-    needs_to_reflect_ = needs_to_reflect_ || s->needs_to_reflect_;
-    xty_ += s->xty_;
-    sumsqy += s->sumsqy;
-    sumy_ += s->sumy_;
-    n_ += s->n_;
+    combine(*sp);
   }
 
   void NeRegSuf::combine(const RegSuf & sp){
     const NeRegSuf& s(dynamic_cast<const NeRegSuf &>(sp));
+    reflect();
+    s.reflect();
     xtx_ += s.xtx_;   // Do we want to combine xtx_ if xtx_is_fixed_?
-    needs_to_reflect_ = needs_to_reflect_ || s.needs_to_reflect_;
     xty_ += s.xty_;
     sumsqy += s.sumsqy;
     sumy_ += s.sumy_;
     n_ += s.n_;
+    x_column_sums_ += s.x_column_sums_;
   }
 
   NeRegSuf * NeRegSuf::abstract_combine(Sufstat *s){
@@ -425,6 +467,7 @@ namespace BOOM{
   Vector::const_iterator NeRegSuf::unvectorize(Vector::const_iterator &v,
                                   bool minimal){
     // do we want to store xtx_is_fixed_?
+    xtx_buffer_.clear();
     xtx_.unvectorize(v, minimal);
     needs_to_reflect_ = true;
     uint dim = xty_.size();
@@ -458,11 +501,149 @@ namespace BOOM{
 
   void NeRegSuf::reflect()const{
     if(needs_to_reflect_){
+      xtx_buffer_.flush(xtx_);
       xtx_.reflect();
       needs_to_reflect_ = false;
     }
   }
 
+  //---------------------------------------------
+  SparseRegSuf::SparseRegSuf(uint p)
+      : xtx_(p),
+        xty_(p, 0.0),
+        sumsqy_(0.0),
+        n_(0.0),
+        sumy_(0.0),
+        x_column_sums_(p, 0.0)
+  {}
+
+  SparseRegSuf * SparseRegSuf::clone()const{
+    return new SparseRegSuf(*this);}
+
+  void SparseRegSuf::clear(){
+    xtx_.clear();
+    xty_ = 0.0;
+    sumsqy_ = 0.0;
+    n_ = 0.0;
+    sumy_ = 0.0;
+    x_column_sums_ = 0.0;
+  }
+
+  void SparseRegSuf::add_mixture_data(double y, const Vector &x, double prob){
+    add_mixture_data(y, ConstVectorView(x), prob);
+  }
+
+  void SparseRegSuf::add_mixture_data(double y, const ConstVectorView &x,
+                                      double prob){
+    xtx_.add_outer(x, prob);
+    xty_.axpy(x, y * prob);
+    sumsqy_ += y * y * prob;
+    n_ += prob;
+    sumy_ += y * prob;
+    x_column_sums_.axpy(x, prob);
+  }
+
+  void SparseRegSuf::Update(const RegressionData &rdp){
+    add_mixture_data(rdp.y(), rdp.x(), 1.0);
+  }
+
+  void SparseRegSuf::add_sparse_data(const SparseRegressionData &data){
+    if (data.xdim() != size()) {
+      report_error("Sparse data has the wrong number of predictors.");
+    }
+    data.add_cross_products(xtx_, xty_);
+    for (int i = 0; i < data.nobs(); ++i) {
+      double w = data.weight(i);
+      double y = data.y(i);
+      sumsqy_ += w * y * y;
+      sumy_ += w * y;
+      n_ += w;
+      const int *columns = data.column_indices(i);
+      const double *values = data.values(i);
+      for (int k = 0; k < data.row_size(i); ++k) {
+        x_column_sums_[columns[k]] += w * values[k];
+      }
+    }
+  }
+
+  uint SparseRegSuf::size()const{ return xty_.size();}
+  double SparseRegSuf::yty()const{ return sumsqy_;}
+  Vector SparseRegSuf::xty()const{ return xty_;}
+  SpdMatrix SparseRegSuf::xtx()const{ return xtx_.dense();}
+  Vector SparseRegSuf::xty(const Selector &inc)const{
+    return inc.select(xty_);}
+  SpdMatrix SparseRegSuf::xtx(const Selector &inc)const{
+    return xtx_.select(inc);}
+
+  Vector SparseRegSuf::beta_hat()const{
+    return xtx().solve(xty_);
+  }
+
+  double SparseRegSuf::SSE()const{
+    SpdMatrix ivar = xtx().inv();
+    return yty() - ivar.Mdist(xty_);
+  }
+
+  double SparseRegSuf::SST()const{ return sumsqy_ - n() * pow(ybar(), 2);}
+  double SparseRegSuf::ybar()const{ return sumy_ / n_;}
+  Vector SparseRegSuf::xbar()const{ return x_column_sums_ / n_;}
+  double SparseRegSuf::n()const{ return n_;}
+
+  void SparseRegSuf::combine(Ptr<RegSuf> sp){
+    combine(*sp);
+  }
+
+  void SparseRegSuf::combine(const RegSuf &sp){
+    const SparseRegSuf &s(dynamic_cast<const SparseRegSuf &>(sp));
+    xtx_.add(s.xtx_);
+    xty_ += s.xty_;
+    sumsqy_ += s.sumsqy_;
+    n_ += s.n_;
+    sumy_ += s.sumy_;
+    x_column_sums_ += s.x_column_sums_;
+  }
+
+  SparseRegSuf * SparseRegSuf::abstract_combine(Sufstat *s){
+    return abstract_combine_impl(this, s);}
+
+  Vector SparseRegSuf::vectorize(bool)const{
+    Vector ans = xtx_.vectorize();
+    ans.concat(xty_);
+    ans.push_back(sumsqy_);
+    ans.push_back(n_);
+    ans.push_back(sumy_);
+    ans.concat(x_column_sums_);
+    return ans;
+  }
+
+  Vector::const_iterator SparseRegSuf::unvectorize(
+      Vector::const_iterator &v, bool){
+    xtx_.unvectorize(v);
+    uint dim = xty_.size();
+    xty_.assign(v, v + dim);
+    v += dim;
+    sumsqy_ = *v; ++v;
+    n_ = *v; ++v;
+    sumy_ = *v; ++v;
+    x_column_sums_.assign(v, v + dim);
+    v += dim;
+    return v;
+  }
+
+  Vector::const_iterator SparseRegSuf::unvectorize(const Vector &v,
+                                                   bool minimal){
+    Vector::const_iterator it = v.begin();
+    return unvectorize(it, minimal);
+  }
+
+  ostream & SparseRegSuf::print(ostream &out)const{
+    return out << "sumsqy = " << sumsqy_ << endl
+               << "sumy_  = " << sumy_ << endl
+               << "n_     = " << n_ << endl
+               << "xty_ = " << xty_ << endl
+               << "nonzero elements of xtx: " << xtx_.nonzeros() << endl;
+  }
+
   //======================================================================
   typedef RegressionDataPolicy RDP;
 
@@ -520,6 +701,14 @@ namespace BOOM{
       DataPolicy(new NeRegSuf(d.begin(), d.end()))
   {}
 
+  RM::RegressionModel(const Ptr<SparseRegressionData> &data)
+    : GlmModel(),
+      ParamPolicy(new GlmCoefs(data->xdim()), new UnivParams(1.0)),
+      DataPolicy(new SparseRegSuf(data->xdim()))
+  {
+    set_sparse_data(data);
+  }
+
   RM::RegressionModel(const RegressionModel &rhs)
     : Model(rhs),
       GlmModel(rhs),
@@ -527,7 +716,8 @@ namespace BOOM{
       DataPolicy(rhs),
       PriorPolicy(rhs),
       NumOptModel(rhs),
-      EmMixtureComponent(rhs)
+      EmMixtureComponent(rhs),
+      sparse_data_(rhs.sparse_data_)
   {}
 
   RM * RM::clone()const{return new RegressionModel(*this); }
@@ -649,8 +839,11 @@ namespace BOOM{
 
   void RM::use_normal_equations(){
     RegSuf *s = suf().get();
-    NeRegSuf *rs = dynamic_cast<NeRegSuf *>(s);
-    if (rs) return;
+    // Sparse sufficient statistics also solve the normal equations,
+    // and converting them would need a dense p x p matrix.
+    if (dynamic_cast<NeRegSuf *>(s) || dynamic_cast<SparseRegSuf *>(s)) {
+      return;
+    }
     Ptr<NeRegSuf> ne_reg_suf(new NeRegSuf(
         s->xtx(),
         s->xty(),
@@ -665,6 +858,34 @@ namespace BOOM{
     suf()->add_mixture_data(d->y(), d->x(), prob);
   }
 
+  void RM::set_columnar_data(const Ptr<ColumnarRegressionData> &data) {
+    clear_data();
+    use_normal_equations();
+    store_columnar_data(data);
+    if (!!data) suf()->add_columnar_data(*data);
+  }
+
+  void RM::clear_data() {
+    DataPolicy::clear_data();
+    store_columnar_data(Ptr<ColumnarRegressionData>());
+    sparse_data_.reset();
+  }
+
+  void RM::set_sparse_data(const Ptr<SparseRegressionData> &data) {
+    clear_data();
+    if (!data) return;
+    if (data->xdim() != xdim()) {
+      std::ostringstream err;
+      err << "Sparse data has " << data->xdim() << " predictors, but the "
+          << "model expects " << xdim() << ".";
+      report_error(err.str());
+    }
+    Ptr<SparseRegSuf> sparse_suf(new SparseRegSuf(xdim()));
+    sparse_suf->add_sparse_data(*data);
+    reset_suf_ptr(sparse_suf);
+    sparse_data_ = data;
+  }
+
   /*
      SSE = (y-Xb)^T (y-Xb)
      = (y - QQTy)^T (y - Q Q^Ty)
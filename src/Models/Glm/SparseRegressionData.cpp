@@ -0,0 +1,145 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include <Models/Glm/SparseRegressionData.hpp>
+#include <cpputil/report_error.hpp>
+#include <sstream>
+
+namespace BOOM {
+
+  SparseRegressionData::SparseRegressionData(const Matrix &X,
+                                             const Vector &y,
+                                             const Vector &weights)
+      : xdim_(X.ncol()),
+        y_(y),
+        weights_(weights)
+  {
+    if (X.nrow() != y_.size()) {
+      std::ostringstream err;
+      err << "The design matrix has " << X.nrow() << " rows, but there are "
+          << y_.size() << " responses.";
+      report_error(err.str());
+    }
+    row_offsets_.reserve(X.nrow() + 1);
+    row_offsets_.push_back(0);
+    for (int i = 0; i < X.nrow(); ++i) {
+      for (int j = 0; j < X.ncol(); ++j) {
+        if (X(i, j) != 0.0) {
+          column_indices_.push_back(j);
+          values_.push_back(X(i, j));
+        }
+      }
+      row_offsets_.push_back(values_.size());
+    }
+    check_storage();
+  }
+
+  SparseRegressionData::SparseRegressionData(
+      int xdim,
+      const std::vector<std::size_t> &row_offsets,
+      const std::vector<int> &column_indices,
+      const Vector &values,
+      const Vector &y,
+      const Vector &weights)
+      : xdim_(xdim),
+        row_offsets_(row_offsets),
+        column_indices_(column_indices),
+        values_(values),
+        y_(y),
+        weights_(weights)
+  {
+    check_storage();
+  }
+
+  void SparseRegressionData::check_storage() const {
+    if (xdim_ < 0) {
+      report_error("The number of predictors must be non-negative.");
+    }
+    if (row_offsets_.size() != y_.size() + 1
+        || row_offsets_[0] != 0
+        || row_offsets_.back() != values_.size()
+        || column_indices_.size() != values_.size()) {
+      report_error("Inconsistent sizes for the compressed sparse row "
+                   "arrays in SparseRegressionData.");
+    }
+    if (!weights_.empty() && weights_.size() != y_.size()) {
+      report_error("The weight vector must be empty or match the size "
+                   "of the response.");
+    }
+    for (int i = 0; i < nobs(); ++i) {
+      if (row_offsets_[i + 1] < row_offsets_[i]) {
+        report_error("Row offsets must be non-decreasing.");
+      }
+      const int *columns = column_indices(i);
+      for (int k = 0; k < row_size(i); ++k) {
+        if (columns[k] < 0 || columns[k] >= xdim_
+            || (k > 0 && columns[k] <= columns[k - 1])) {
+          std::ostringstream err;
+          err << "Row " << i << " of the sparse design matrix has column "
+              << "indices that are out of range or not strictly increasing.";
+          report_error(err.str());
+        }
+      }
+    }
+  }
+
+  Vector SparseRegressionData::x(int i) const {
+    Vector ans(xdim_, 0.0);
+    const int *columns = column_indices(i);
+    const double *v = values(i);
+    for (int k = 0; k < row_size(i); ++k) ans[columns[k]] = v[k];
+    return ans;
+  }
+
+  double SparseRegressionData::predict(int i, const Vector &beta) const {
+    const int *columns = column_indices(i);
+    const double *v = values(i);
+    double ans = 0;
+    for (int k = 0; k < row_size(i); ++k) ans += v[k] * beta[columns[k]];
+    return ans;
+  }
+
+  void SparseRegressionData::predict(
+      const Vector &beta, int first, VectorView eta) const {
+    if (beta.size() != xdim()) {
+      report_error("Coefficient vector is the wrong size in "
+                   "SparseRegressionData::predict.");
+    }
+    if (first < 0 || first + eta.size() > nobs()) {
+      report_error("Rows out of range in SparseRegressionData::predict.");
+    }
+    for (int i = 0; i < eta.size(); ++i) eta[i] = predict(first + i, beta);
+  }
+
+  void SparseRegressionData::add_cross_products(
+      SparseCrossProductMatrix &xtwx, Vector &xtwy) const {
+    if (xtwx.dim() != xdim() || xtwy.size() != xdim()) {
+      report_error("Cross product arguments are the wrong size in "
+                   "SparseRegressionData::add_cross_products.");
+    }
+    for (int i = 0; i < nobs(); ++i) {
+      const int *columns = column_indices(i);
+      const double *v = values(i);
+      double w = weight(i);
+      xtwx.add_outer(columns, v, row_size(i), w);
+      double wy = w * y_[i];
+      for (int k = 0; k < row_size(i); ++k) xtwy[columns[k]] += wy * v[k];
+    }
+  }
+
+}  // namespace BOOM
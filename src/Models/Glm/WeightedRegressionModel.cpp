@@ -35,6 +35,7 @@ namespace BOOM{
       xtwy_(p, 0.0),
       n_(0.0),
       yt_w_y_(0.0),
+      sumlogw_(0.0),
       sym_(false)
   {}
 
@@ -69,7 +70,9 @@ namespace BOOM{
       xtwy_(rhs.xtwy_),
       n_(rhs.n_),
       yt_w_y_(rhs.yt_w_y_),
-      sym_(rhs.sym_)
+      sumlogw_(rhs.sumlogw_),
+      sym_(rhs.sym_),
+      xtwx_buffer_(rhs.xtwx_buffer_)
   {}
 
   WRS * WRS::clone() const {return new WRS(*this);}
@@ -84,15 +87,12 @@ namespace BOOM{
   }
 
   void WRS::combine(Ptr<WRS> s) {
-    xtwx_ += s->xtwx_;
-    xtwy_ += s->xtwy_;
-    n_ += s->n_;
-    yt_w_y_ += s->yt_w_y_;
-    sumlogw_ += s->sumlogw_;
-    sym_ = sym_ && s->sym_;
+    combine(*s);
   }
 
   void WRS::combine(const WRS & s) {
+    flush_buffer();
+    s.flush_buffer();
     xtwx_ += s.xtwx_;
     xtwy_ += s.xtwy_;
     n_ += s.n_;
@@ -105,6 +105,7 @@ namespace BOOM{
     return abstract_combine_impl(this,s); }
 
   Vector WRS::vectorize(bool minimal) const {
+    if (!sym_) make_symmetric();
     Vector ans = xtwx_.vectorize(minimal);
     ans.concat(xtwy_);
     ans.push_back(n_);
@@ -115,6 +116,7 @@ namespace BOOM{
 
   Vector::const_iterator WRS::unvectorize(Vector::const_iterator &v,
                                           bool) {
+    xtwx_buffer_.clear();
     xtwx_.unvectorize(v);
     uint dim = xtwy_.size();
     xtwy_.assign(v, v+dim);
@@ -135,6 +137,7 @@ namespace BOOM{
     xtwx_ = SpdMatrix(p, 0.0);
     xtwy_ = Vector(p, 0.0);
     sym_  = false;
+    xtwx_buffer_.clear();
   }
 
   void WRS::reweight(const Matrix &X, const Vector &y, const Vector &w) {
@@ -151,6 +154,7 @@ namespace BOOM{
 
   //------------------------------------------------------------
   void WRS::set_xtwx(const SpdMatrix &xtwx) {
+    xtwx_buffer_.clear();
     xtwx_ = xtwx;
   }
 
@@ -161,16 +165,41 @@ namespace BOOM{
   //------------------------------------------------------------
 
   void WRS::add_data(const Vector &x, double y, double w) {
+    // An observation with zero weight has infinite variance, so it
+    // carries no information.  Skipping it keeps n() and sumlogw()
+    // consistent with add_columnar_data.
+    if (w == 0) return;
     ++n_;
     yt_w_y_ += w*y*y;
     sumlogw_ += log(w);
-    xtwx_.add_outer(x,w, false);
+    xtwx_buffer_.add(x, w, xtwx_);
     xtwy_.axpy(x,w*y);
     sym_ = false;
   }
 
+  void WRS::add_columnar_data(const ColumnarRegressionData &data,
+                              int first,
+                              const ConstVectorView &y,
+                              const ConstVectorView &w) {
+    if (y.size() != w.size()) {
+      report_error("Responses and weights must be the same size.");
+    }
+    Vector wy(y.size());
+    for (int i = 0; i < y.size(); ++i) {
+      wy[i] = w[i] * y[i];
+      if (w[i] != 0) {
+        ++n_;
+        yt_w_y_ += wy[i] * y[i];
+        sumlogw_ += log(w[i]);
+      }
+    }
+    data.add_cross_products(first, w, wy, xtwx_, xtwy_);
+    sym_ = false;
+  }
+
   void WRS::clear() {
     xtwx_=0.0;
+    xtwx_buffer_.clear();
     xtwy_ = 0.0;
     yt_w_y_ = n_ = sumlogw_ = 0.0;
     sym_ = false;
@@ -187,10 +216,15 @@ namespace BOOM{
     return xtwx_;
   }
   void WRS::make_symmetric() const {
+    flush_buffer();
     xtwx_.reflect();
     sym_ = true;
   }
 
+  void WRS::flush_buffer() const {
+    xtwx_buffer_.flush(xtwx_);
+  }
+
   Vector WRS::xty(const Selector &inc) const {return inc.select(xtwy_);}
   SpdMatrix WRS::xtx(const Selector &inc) const {return inc.select(xtx());}
 
@@ -206,7 +240,10 @@ namespace BOOM{
 
   double WRS::SST() const { return yty()/sumw() - pow(ybar(), 2); }
   double WRS::n() const {return n_;}
-  double WRS::sumw() const {return xtwx_(0,0);}
+  double WRS::sumw() const {
+    flush_buffer();
+    return xtwx_(0,0);
+  }
   double WRS::sumlogw() const {return sumlogw_;}
   double WRS::ybar() const {return xtwy_[0]/sumw();}
 
@@ -7,10 +7,7 @@
 #include <Models/HMM/hmm_tools.hpp>
 #include <distributions.hpp>
 #include <distributions/Markov.hpp>
-
-#ifndef NO_BOOST_THREADS
-#include <boost/thread.hpp>
-#endif
+#include <functional>
 
 namespace BOOM {
 
@@ -69,6 +66,40 @@ namespace BOOM {
       }
 
 
+  NestedHmm::NestedHmm(const NestedHmm &rhs)
+      : Model(rhs),
+        CompositeParamPolicy(),
+        DataPolicy(rhs),
+        PriorPolicy(rhs),
+        S0_(rhs.S0_),
+        S1_(rhs.S1_),
+        S2_(rhs.S2_),
+        session_type_distribution_(rhs.session_type_distribution_),
+        session_model_(rhs.session_model_->clone()),
+        mix_(rhs.S2_),
+        loglike_(new UnivParams(rhs.last_loglike())),
+        logpost_(new UnivParams(rhs.last_logpost())),
+        pi_(S1_ * S2_),
+        logpi0_(S1_ * S2_),
+        logd_(S1_ * S2_),
+        one_(S1_ * S2_, 1.0),
+        logQ1_(S1_ * S2_, S1_ * S2_),
+        logQ2_(S1_ * S2_, S1_ * S2_),
+        rng_(rhs.rng_)
+  {
+    ParamPolicy::add_model(session_model_);
+    for(int H = 0; H < S2_; ++H){
+      event_model_.push_back(rhs.event_model_[H]->clone());
+      ParamPolicy::add_model(event_model_.back());
+      for(int h = 0; h < S1_; ++h){
+        mix_[H].push_back(rhs.mix_[H][h]->clone());
+        ParamPolicy::add_model(mix_[H].back());
+      }
+    }
+    // ThreadWorkerPool::run is not reentrant, so the copy cannot share
+    // the workers or the pool with rhs.
+    if(!rhs.workers_.empty()) set_threads(rhs.workers_.size());
+  }
   //----------------------------------------------------------------------
   NestedHmm * NestedHmm::clone()const{return new NestedHmm(*this);}
   //----------------------------------------------------------------------
@@ -310,7 +341,6 @@ namespace BOOM {
     return ans;
   }
   //----------------------------------------------------------------------
-#ifndef NO_BOOST_THREADS
   double NestedHmm::fwd_bkwd_with_threads(bool bayes, bool find_mode){
     clear_client_data();
     pass_params_to_workers();
@@ -324,15 +354,12 @@ namespace BOOM {
     if(find_mode) complete_data_mode(bayes);
     return loglike;
   }
-#endif
 
   //----------------------------------------------------------------------
   // One step of an EM algorithm for finding point estimates of model
   // parameters
   double NestedHmm::fwd_bkwd(bool bayes, bool find_mode){
-#ifndef NO_BOOST_THREADS
     if(!workers_.empty()) return fwd_bkwd_with_threads(bayes, find_mode);
-#endif
     clear_client_data();
     int N = Nstreams();
     fill_big_Q();
@@ -523,9 +550,7 @@ namespace BOOM {
   Ptr<Clickstream::Stream> NestedHmm::stream(int i){ return this->dat()[i]; }
   //----------------------------------------------------------------------
   double NestedHmm::impute_latent_data(){
-#ifndef NO_BOOST_THREADS
     if(workers_.size() > 0) return impute_latent_data_with_threads();
-#endif
     clear_client_data();
     double ans = 0;
     fill_big_Q();
@@ -539,7 +564,6 @@ namespace BOOM {
     return ans;
   }
   //----------------------------------------------------------------------
-#ifndef NO_BOOST_THREADS
   double NestedHmm::impute_latent_data_with_threads(){
     clear_client_data();
     pass_params_to_workers();
@@ -549,32 +573,20 @@ namespace BOOM {
     logpost_->set(loglike + logpri());
     return loglike;
   }
-#endif
-  //----------------------------------------------------------------------
-  struct ClickstreamSamplingImputer{
-    Ptr<NestedHmm> mod;
-    ClickstreamSamplingImputer(Ptr<NestedHmm> m) : mod(m){}
-    void operator()(){ mod->impute_latent_data();}
-  };
   //----------------------------------------------------------------------
-  struct ClickstreamEmImputer{
-    ClickstreamEmImputer(Ptr<NestedHmm> m) : mod(m) {}
-    Ptr<NestedHmm> mod;
-    void operator()(){ mod->fwd_bkwd(false, false); }
-  };
-  //----------------------------------------------------------------------
-#ifdef NO_BOOST_THREADS
-  void NestedHmm::set_threads(int n) {
-    // nothing needed.
-  }
-#else
+  // Each worker is a NestedHmm holding a static share of the streams.
+  // The workers run on a pool of threads which persists across calls.
   void NestedHmm::set_threads(int n){
     clear_workers();
     for(int i = 0; i<n; ++i){
       NEW(NestedHmm, worker)(S2_, S1_, S0_);
+      // Workers sample latent data in parallel, so each one needs its
+      // own random number stream.
+      worker->rng() = split_rng(rng());
       add_worker(worker);
     }
     allocate_data_to_workers();
+    pool_.set_number_of_threads(n);
   }
   //----------------------------------------------------------------------
   void NestedHmm::pass_params_to_workers(){
@@ -583,12 +595,12 @@ namespace BOOM {
   }
   //----------------------------------------------------------------------
   void NestedHmm::start_thread_imputation(){
-    boost::thread_group tg;
+    std::vector<std::function<void()> > tasks;
     for(int i = 0; i<workers_.size(); ++i){
-      ClickstreamSamplingImputer imp(workers_[i]);
-      tg.add_thread(new boost::thread(imp));
+      NestedHmm *worker = workers_[i].get();
+      tasks.push_back([worker](){worker->impute_latent_data();});
     }
-    tg.join_all();
+    pool_.run(tasks);
   }
   //----------------------------------------------------------------------
   void NestedHmm::add_worker(Ptr<NestedHmm> w){ workers_.push_back(w); }
@@ -604,12 +616,12 @@ namespace BOOM {
   }
   //----------------------------------------------------------------------
   void NestedHmm::start_thread_em(){
-    boost::thread_group tg;
+    std::vector<std::function<void()> > tasks;
     for(int i = 0; i<workers_.size(); ++i){
-      ClickstreamEmImputer imp(workers_[i]);
-      tg.add_thread(new boost::thread(imp));
+      NestedHmm *worker = workers_[i].get();
+      tasks.push_back([worker](){worker->fwd_bkwd(false, false);});
     }
-    tg.join_all();
+    pool_.run(tasks);
   }
   //----------------------------------------------------------------------
   double NestedHmm::collect_threads(){
@@ -626,7 +638,6 @@ namespace BOOM {
     }
     return loglike;
   }
-#endif
   //----------------------------------------------------------------------
   void NestedHmm::clear_client_data(){
     session_model()->clear_data();
@@ -31,11 +31,7 @@
 
 #include <stdexcept>
 #include <cmath>
-
-#ifndef NO_BOOST_THREADS
-#include <boost/thread.hpp>
-#include <boost/ref.hpp>
-#endif
+#include <functional>
 
 namespace BOOM{
 
@@ -78,6 +74,10 @@ namespace BOOM{
   HMM * HMM::clone()const{return new HMM(*this);}
 
   void HMM::randomly_assign_data(){
+    randomly_assign_data(GlobalRng::rng);
+  }
+
+  void HMM::randomly_assign_data(RNG &rng){
     clear_client_data();
     uint S = state_space_size();
     Vector prob(S, 1.0/S);
@@ -85,7 +85,7 @@ namespace BOOM{
       const DataSeriesType & ts(dat(s));
       uint n = ts.size();
       for(uint i=0; i<n; ++i){
-        uint h = rmulti(prob);
+        uint h = rmulti_mt(rng, prob);
         mix_[h]->add_data(ts[i]);}}
   }
 
@@ -237,10 +237,12 @@ namespace BOOM{
   }
 
   double HMM::impute_latent_data(){
-#ifndef NO_BOOST_THREADS
+    return impute_latent_data(GlobalRng::rng);
+  }
+
+  double HMM::impute_latent_data(RNG &rng){
     if(nthreads()>0)
       return impute_latent_data_with_threads();
-#endif
 
     clear_client_data();
     double ans=0;
@@ -248,7 +250,7 @@ namespace BOOM{
     for(uint series = 0; series<ns; ++series){
       const DataSeriesType & ts(dat(series));
       ans += filter_->fwd(ts);
-      filter_->bkwd_sampling(ts);}
+      filter_->bkwd_sampling_mt(ts, rng);}
     set_loglike(ans);
     set_logpost(ans + logpri());
     return ans;
@@ -282,28 +284,32 @@ namespace BOOM{
 
   ////////////////////////////////////////////////////////////////////////////
 
-  void HMM::set_nthreads(uint n){
-#ifndef NO_BOOST_THREADS
+  void HMM::set_nthreads(uint n, RNG &seeding_rng){
     workers_.clear();
     for(uint i=0; i<n; ++i){
-      NEW(HmmDataImputer, imp)(this, i, n);
+      NEW(HmmDataImputer, imp)(this, i, n, seeding_rng);
       workers_.push_back(imp);}
-#endif
+    pool_.set_number_of_threads(n);
 }
 
   uint HMM::nthreads()const{ return workers_.size();}
 
-#ifndef NO_BOOST_THREADS
+  // Each worker owns a static share of the series (every nthreads'th
+  // one), along with its own copies of the models to collect the
+  // imputed sufficient statistics.  The workers run on a pool of
+  // threads that persists across calls.
   double HMM::impute_latent_data_with_threads(){
     try{
       clear_client_data();
 
-      boost::thread_group tg;
+      std::vector<std::function<void()> > tasks;
+      tasks.reserve(nthreads());
       for(uint i = 0; i<nthreads(); ++i){
-        workers_[i]->setup(this);
-        tg.add_thread(new boost::thread(boost::ref(*workers_[i])));
+        HmmDataImputer *worker = workers_[i].get();
+        worker->setup(this);
+        tasks.push_back([worker](){(*worker)();});
       }
-      tg.join_all();
+      pool_.run(tasks);
       uint S = state_space_size();
       double loglike=0;
       for(uint i=0; i<nthreads(); ++i){
@@ -311,15 +317,16 @@ namespace BOOM{
         mark_->combine_data(*workers_[i]->mark(), true);
         for(uint s=0; s<S; ++s) mix_[s]->combine_data(*workers_[i]->models(s), true);
       }
+      set_loglike(loglike);
+      set_logpost(loglike + logpri());
       return loglike;
     }catch(const std::exception &e){
       report_error(e.what());
     }catch(...){
-      report_error("HMM caught unknown exception from boost::threads");
+      report_error("HMM caught unknown exception from a worker thread");
     }
     return 0;
   }
-#endif
 
 
 } // ends namespace BOOM
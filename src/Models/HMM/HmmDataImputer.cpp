@@ -6,19 +6,13 @@
 namespace BOOM{
 typedef HmmDataImputer HDI;
 
-inline unsigned long getseed(){
-  double u = runif() * std::numeric_limits<unsigned long>::max();
-  unsigned long ans(lround(u));
-  return ans;
-}
-
-HDI::HmmDataImputer(HiddenMarkovModel * hmm, uint id, uint nworkers)
+HDI::HmmDataImputer(HiddenMarkovModel * hmm, uint id, uint nworkers,
+                    RNG &seeding_rng)
     : id_(id),
       nworkers_(nworkers),
       mark_(new MarkovModel(hmm->state_space_size())),
-      eng(getseed())
+      eng(split_rng(seeding_rng))
 {
-  eng.seed();
   uint S = hmm->state_space_size();
   for(uint s=0; s<S; ++s){
     Ptr<MixtureComponent> m(hmm->mixture_component(s)->clone());
@@ -28,80 +28,94 @@
 
 namespace BOOM{
 
-  void hmm_recursion_error(const Matrix &p, const Vector &Marg, const Matrix &Tmat,
-                           const Vector &Wsp, uint i, Ptr<Data>);
-  void hmm_recursion_error(const Matrix &P, const Vector &marg, const Matrix &tmat,
-                           const Vector &wsp, uint i, Ptr<Data> dp){
-    string str;
-    ostringstream s(str);
-    s << "error in HMM recursion at step "<< i<< ":" << endl;
-    s << "marg:" << endl << marg << endl;
-    s << "P: " << endl << P << endl;
-    s << "hmm.cpp:  Q = " << endl << tmat << endl;
-    s << "hmm.cpp: p(data|state) = " << wsp << endl;
-    s << "here is the observed data that caused the error: " << endl
-      << *dp << endl;
-    report_error(s.str());
-  }
-
   HmmFilter::HmmFilter(std::vector<Ptr<MixtureComponent> > mv,
                        Ptr<MarkovModel> mark)
       : models_(mv),
-      P(0),
       pi(mv.size()),
-      logp(mv.size()),
-      logpi(mv.size()),
       one(mv.size(), 1.0),
-      logQ(mv.size(), mv.size()),
+      predicted_(mv.size()),
       markov_(mark)
       {}
 
   uint HmmFilter::state_space_size()const{
     return models_.size();}
 
-  double HmmFilter::initialize(const Data * dp){
+  //------------------------------------------------------------
+  void HmmFilter::compute_log_densities(const std::vector<Ptr<Data> > &dv){
+    uint n = dv.size();
     uint S = state_space_size();
-    pi = markov_->pi0();
-    if(dp->missing()) logp = 0;
-    else for(uint s=0; s<S; ++s) logp[s] = models_[s]->pdf(dp, true);
-    pi = log(pi) + logp;
-    double m = max(pi);
-    pi = exp(pi-m);
-    double nc = sum(pi);
-    double loglike = m + log(nc);
-    pi/=nc;
-    return loglike;
+    if(logd_.nrow() != n || logd_.ncol() != S) logd_ = Matrix(n, S);
+    for(uint s=0; s<S; ++s) models_[s]->batch_logp(dv, logd_.col(s));
+    transition_ = markov_->Q().t();
+  }
+
+  //------------------------------------------------------------
+  double HmmFilter::filter_step(uint t, const ConstVectorView &previous,
+                                VectorView next){
+    uint S = state_space_size();
+    uint n = logd_.nrow();
+    const double *logd = logd_.data() + t;
+
+    // predicted[s] = sum_r previous[r] * Q(r, s), accumulated one row
+    // of Q at a time.
+    double *predicted = predicted_.data();
+    if(t == 0){
+      for(uint s=0; s<S; ++s) predicted[s] = previous[s];
+    } else {
+      for(uint s=0; s<S; ++s) predicted[s] = 0;
+      const double *Q = transition_.data();
+      for(uint r=0; r<S; ++r){
+        const double weight = previous[r];
+        const double *Qr = Q + r * S;
+        for(uint s=0; s<S; ++s) predicted[s] += weight * Qr[s];
+      }
+    }
+
+    double m = negative_infinity();
+    for(uint s=0; s<S; ++s) m = std::max(m, logd[s * n]);
+    double nc = 0;
+    for(uint s=0; s<S; ++s){
+      next[s] = predicted[s] * exp(logd[s * n] - m);
+      nc += next[s];
+    }
+    next /= nc;
+    return m + log(nc);
   }
 
+  //------------------------------------------------------------
   double HmmFilter::fwd(const std::vector<Ptr<Data> > &dv){
-    logQ = log(markov_->Q() );
     uint n = dv.size();
     uint S = state_space_size();
-    if(logp.size()!=S) logp.resize(S);
-    if(P.size() < n) P.resize(n);
-    double loglike = initialize(dv[0].get());
-    for(uint i=1; i<n; ++i){
-      if(dv[i]->missing()) logp = 0;
-      else for(uint s=0; s<S; ++s) logp[s] = models_[s]->pdf(dv[i].get(), true);
-      loglike += fwd_1(pi, P[i], logQ, logp, one);
+    if(n == 0) return 0;
+    compute_log_densities(dv);
+    if(filtered_.nrow() != S || filtered_.ncol() != n){
+      filtered_ = Matrix(S, n);
+    }
+    double loglike = filter_step(0, markov_->pi0(), filtered_.col(0));
+    for(uint t=1; t<n; ++t){
+      loglike += filter_step(t, filtered_.col(t-1), filtered_.col(t));
     }
+    pi = filtered_.col(n-1);
     return loglike;
   }
   //------------------------------------------------------------
 
   double HmmFilter::loglike(const std::vector<Ptr<Data> > & dv){
-    logQ = log(markov_->Q());
-    pi = markov_->pi0();
-    uint S = pi.size();
-    uint n = dv.size();
-    Matrix P(logQ);
-    double ans = initialize(dv[0].get());
-    for(uint i=1; i<n; ++i){
-      if(dv[i]->missing()) logp = 0;
-      else for(uint s=0; s<S; ++s) logp[s] = models_[s]->pdf(dv[i].get(), true);
-      ans += fwd_1(pi, P, logQ, logp, one);
+    return fwd(dv);
+  }
+
+  //------------------------------------------------------------
+  void HmmFilter::transition_column(uint t, uint s, Vector &ans) const{
+    uint S = state_space_size();
+    if(ans.size() != S) ans.resize(S);
+    const double *previous = filtered_.data() + (t-1) * S;
+    double total = 0;
+    for(uint r=0; r<S; ++r){
+      ans[r] = previous[r] * transition_(s, r);
+      total += ans[r];
     }
-    return ans;
+    // The column sums to p(h[t] = s | y[0..t]).
+    if(total > 0) ans *= filtered_(s, t) / total;
   }
   //------------------------------------------------------------
 
@@ -109,39 +123,23 @@ namespace BOOM{
                                    RNG & eng){
     uint n = dv.size();
     // pi was already set by fwd.
-    // So the following line would  break things when n=1.
-    //      pi = one * P.back();
-    uint s = rmulti_mt(eng,pi);
-    models_[s]->add_data(dv.back());
-    for(uint i=n-1; i!=0; --i){
-      pi = P[i].col(s);
+    uint s = rmulti_mt(eng,pi);         // last obs in state s
+    allocate(dv.back(), s);             // last data point allocated
+    for(uint i=n-1; i!=0; --i){         // start with s=h[i]
+      transition_column(i, s, pi);      // compute r = h[i-1]
       pi.normalize_prob();
       uint r = rmulti_mt(eng,pi);
-      models_[r]->add_data(dv[i-1]);
+      allocate(dv[i-1], r);
       markov_->suf()->add_transition(r,s);
       s=r;
     }
     markov_->suf()->add_initial_value(s);
+    // in last step of loop i = 1, so s=h[0]
   }
 
   //------------------------------------------------------------
   void HmmFilter::bkwd_sampling(const std::vector<Ptr<Data> > &dv ){
-    uint n = dv.size();
-    // pi was already set by fwd, so the following line would breaks
-    // things when n=1.
-    //      pi = one * P.back();
-    uint s = rmulti(pi);                // last obs in state s
-    allocate(dv.back(), s);             // last data point allocated
-
-    for(uint i=n-1; i!=0; --i){         // start with s=h[i]
-      pi = P[i].col(s);                 // compute r = h[i-1]
-      uint r = rmulti(pi);
-      allocate(dv[i-1], r);
-      markov_->suf()->add_transition(r,s);
-      s=r;
-    }
-    markov_->suf()->add_initial_value(s);
-    // in last step of loop i = 1, so s=h[0]
+    bkwd_sampling_mt(dv, GlobalRng::rng);
   }
   //----------------------------------------------------------------------
   void HmmFilter::allocate(Ptr<Data> dp, uint h){
@@ -194,12 +192,18 @@ namespace BOOM{
     // pi was set by fwd;
     uint n = dv.size();
     uint S = state_space_size();
+    Matrix P(S, S);
+    Vector column(S);
+    Vector wsp(S);
     for(uint i=n-1; i!=0; --i){
       for(uint s=0; s<S; ++s) models_[s]->add_mixture_data(dv[i], pi[s]);
-      markov_->suf()->add_transition_distribution(P[i]);
-      bkwd_1(pi, P[i], logp, one);
+      for(uint s=0; s<S; ++s){
+        transition_column(i, s, column);
+        P.col(s) = column;
+      }
+      markov_->suf()->add_transition_distribution(P);
+      bkwd_1(pi, P, wsp, one);   // sets pi to p(h[i-1] | y[0..n-1])
     }
-    pi = P[1] * one;
     for(uint s=0; s<S; ++s) models_[s]->add_mixture_data(dv[0], pi[s]);
     markov_->suf()->add_initial_distribution(pi);
   }
@@ -19,23 +19,14 @@
 #include <Models/HMM/PosteriorSamplers/HmmPosteriorSampler.hpp>
 #include <Models/HMM/HmmFilter.hpp>
 
-#ifndef NO_BOOST_THREADS
-#include <boost/thread.hpp>
-#include <boost/ref.hpp>
-#endif
-
 namespace BOOM{
 
 typedef HmmPosteriorSampler HS;
 
   HS::HmmPosteriorSampler(HiddenMarkovModel *hmm, RNG &seeding_rng)
       : PosteriorSampler(seeding_rng),
-#ifndef NO_BOOST_THREADS
         hmm_(hmm),
         use_threads_(false)
-#else
-        hmm_(hmm)
-#endif
   {}
 
   void HS::draw(){
@@ -43,7 +34,7 @@ typedef HmmPosteriorSampler HS;
     draw_mixture_components();
     // by drawing latent data at the end, the log likelihood stored
     // int the model matches the current set of parameters.
-    hmm_->impute_latent_data();
+    hmm_->impute_latent_data(rng());
   }
 
   double HS::logpri()const{
@@ -58,32 +49,30 @@ typedef HmmPosteriorSampler HS;
     std::vector<Ptr<MixtureComponent> > mix = hmm_->mixture_components();
     uint S = mix.size();
 
-#ifndef NO_BOOST_THREADS
     if(use_threads_){
-      if(workers_.size()!=S) use_threads(true);
-      boost::thread_group tg;
-      for(uint s=0; s<S; ++s)
-        tg.add_thread(new boost::thread(boost::ref(*workers_[s])));
-      tg.join_all();
-    }else
-#endif
-    {
+      if(tasks_.size()!=S) use_threads(true);
+      pool_.run(tasks_);
+    }else{
       for(uint s=0; s<S; ++s) mix[s]->sample_posterior();
     }
   }
 
   void HS::use_threads(bool yn){
-#ifndef NO_BOOST_THREADS
     use_threads_ = yn;
-    if(!use_threads_) return;
+    tasks_.clear();
+    if(!use_threads_){
+      pool_.set_number_of_threads(0);
+      return;
+    }
     std::vector<Ptr<MixtureComponent> > mix = hmm_->mixture_components();
     uint S = mix.size();
-    workers_.clear();
     for(uint s=0; s<S; ++s){
-      boost::shared_ptr<MixtureComponentSampler>
-          worker(new MixtureComponentSampler(mix[s].get()));
-      workers_.push_back(worker);
+      // Components are sampled in parallel, so give each one's
+      // samplers a stream that can't collide with the others.
+      mix[s]->seed_samplers(rng());
+      Model *component = mix[s].get();
+      tasks_.push_back([component](){component->sample_posterior();});
     }
-#endif
+    pool_.set_number_of_threads(S);
   }
 }
@@ -104,11 +104,11 @@ namespace BOOM{
     //------------------------------------------------------------
     void IMP::impute_u(Vector &u, const Vector &eta, uint y){
       double log_nc = lse(eta);
-      double logzmin = rlexp(log_nc);
+      double logzmin = rlexp_mt(rng(), log_nc);
       uint M = u.size();
       for(uint m=0; m<M; ++m){
     if(m==y) u[m] = mu-logzmin;
-    else u[m] = mu - lse2(logzmin, rlexp(eta[m]));}}
+    else u[m] = mu - lse2(logzmin, rlexp_mt(rng(), eta[m]));}}
 
   } // namespace IRT
 } // namespace BOOM
@@ -87,7 +87,7 @@ namespace BOOM{
       uint dim = mod->beta().size();
 
       prop = new MvtRwmProposal(SpdMatrix(dim).Id(), Tdf);
-      sampler = new MetropolisHastings(target,prop);
+      sampler = new MetropolisHastings(target, prop, &rng());
     }
 
     void ISAM::draw(){
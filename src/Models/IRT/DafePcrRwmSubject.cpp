@@ -83,7 +83,7 @@ namespace BOOM{
       SpdMatrix Siginv(Ndim);
       Siginv.set_diag(1.0);
       prop = new MvtRwmProposal(Siginv, Tdf);
-      sampler = new MetropolisHastings(target, prop);
+      sampler = new MetropolisHastings(target, prop, &rng());
     }
 
     //------------------------------------------------------------
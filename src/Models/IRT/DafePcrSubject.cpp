@@ -96,7 +96,7 @@ namespace BOOM{
       SpdMatrix Ominv(dim);
       Ominv.set_diag(1.0);
       prop = new MvtIndepProposal(Vector(dim), Ominv, Tdf);
-      sampler = new MetropolisHastings(target, prop);
+      sampler = new MetropolisHastings(target, prop, &rng());
     }
     //------------------------------------------------------------
     double DAFE::logpri()const{ return pri->pdf(subject, true);}
@@ -52,7 +52,7 @@ namespace BOOM{
   sub(s),
     pri(p),
     target(sub, pri),
-    sam(new SliceSampler(target))
+    sam(new SliceSampler(target, false, &rng()))
     { }
 
     SSS * SSS::clone()const{return new SSS(*this);}
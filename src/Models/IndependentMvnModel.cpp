@@ -162,20 +162,14 @@ namespace BOOM{
   IndependentMvnModel::IndependentMvnModel(int dim)
       : ParamPolicy(new VectorParams(dim, 0.0),
                     new VectorParams(dim, 1.0)),
-        DataPolicy(new IndependentMvnSuf(dim)),
-        sigma_scratch_(dim),
-        g_(dim),
-        h_(dim, dim)
+        DataPolicy(new IndependentMvnSuf(dim))
   {}
 
   IndependentMvnModel::IndependentMvnModel(const Vector &mean,
                                            const Vector &variance)
       : ParamPolicy(new VectorParams(mean),
                     new VectorParams(variance)),
-        DataPolicy(new IndependentMvnSuf(mean.size())),
-        sigma_scratch_(mean.size()),
-        g_(mean.size()),
-        h_(mean.size(), mean.size())
+        DataPolicy(new IndependentMvnSuf(mean.size()))
   {
     if (mean.size() != variance.size()) {
       report_error("The mean and the variance must be equal-sized "
@@ -188,10 +182,7 @@ namespace BOOM{
         MvnBase(rhs),
         ParamPolicy(rhs),
         DataPolicy(rhs),
-        PriorPolicy(rhs),
-        sigma_scratch_(rhs.dim()),
-        g_(rhs.dim()),
-        h_(rhs.dim(), rhs.dim())
+        PriorPolicy(rhs)
   {}
 
   IndependentMvnModel * IndependentMvnModel::clone()const{
@@ -227,11 +218,13 @@ namespace BOOM{
   }
 
   const SpdMatrix & IndependentMvnModel::Sigma()const{
+    sigma_scratch_.resize(dim());
     sigma_scratch_.set_diag(sigsq());
     return sigma_scratch_;
   }
 
   const SpdMatrix & IndependentMvnModel::siginv()const{
+    sigma_scratch_.resize(dim());
     sigma_scratch_.set_diag(1.0/sigsq());
     return sigma_scratch_;
   }
@@ -121,6 +121,7 @@ namespace BOOM {
   void ConditionalFiniteMixtureModel::clear_data() {
     clear_component_data();
     data_.clear();
+    component_data_.clear();
     mixing_distribution_->clear_data();
   }
 
@@ -158,43 +159,50 @@ namespace BOOM {
     int S = number_of_mixture_components();
     wsp_.resize(S);
     class_membership_probabilities_.resize(n, S);
+    last_loglike_ = 0;
+    component_data_.resize(n);
+    for (int i = 0; i < n; ++i) {
+      component_data_[i] = data_[i]->shared_data();
+    }
+    // Evaluate each mixture component on all the data at once, filling
+    // the columns of class_membership_probabilities_ with the log
+    // densities.  Each row is normalized below.
+    for (int s = 0; s < S; ++s) {
+      mixture_component(s)->batch_logp(
+          component_data_, class_membership_probabilities_.col(s));
+    }
     for (int i = 0; i < n; ++i) {
       ConditionalMixtureData &data_point(*data_[i]);
       const ChoiceData &mixture_category_data(
           *(data_point.mixture_category_data()));
+      VectorView probs(class_membership_probabilities_.row(i));
       if (data_point.missing()) {
         // Need to handle missing data differently than in
         // FiniteMixtureModel because no predictors are at hand to
         // give prior probabilities.
         //
         // Ignore missing data.
+        probs = 0.0;
       } else if (data_point.known_mixture_component() > 0) {
         // This code branch deals with the case where we know which
         // mixture component produced the given data point.
         int source = data_point.known_mixture_component();
-        last_loglike_ +=
-            mixture_component(source)->pdf(
-                data_point.data(), true);
-        class_membership_probabilities_.row(i) = 0.0;
-        class_membership_probabilities_.row(i)[source] = 1.0;
+        last_loglike_ += probs[source];
+        probs = 0.0;
+        probs[source] = 1.0;
         set_mixture_component_for_observation(i, source);
+        mixture_component(source)->add_data(component_data_[i]);
       } else {
         for (int s = 0; s < S; ++s) {
-          wsp_[s] =
-              mixing_distribution_->predict_subject(
-                  mixture_category_data,
-                  s)
-              + mixture_component(s)->pdf(
-                  data_point.data(),
-                  true);
+          wsp_[s] = mixing_distribution_->predict_subject(
+              mixture_category_data, s) + probs[s];
         }
         last_loglike_ += lse(wsp_);
         wsp_.normalize_logprob();
-        class_membership_probabilities_.row(i) = wsp_;
+        probs = wsp_;
         int mixture_indicator = rmulti_mt(rng, wsp_);
         set_mixture_component_for_observation(i, mixture_indicator);
-        mixture_component(mixture_indicator)->add_data(
-            data_point.shared_data());
+        mixture_component(mixture_indicator)->add_data(component_data_[i]);
       }
     }
   }
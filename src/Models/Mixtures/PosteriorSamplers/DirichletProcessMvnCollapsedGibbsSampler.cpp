@@ -18,7 +18,10 @@
 
 #include <Models/Mixtures/PosteriorSamplers/DirichletProcessMvnCollapsedGibbsSampler.hpp>
 #include <distributions.hpp>
+#include <LinAlg/Cholesky.hpp>
+#include <LinAlg/SubMatrix.hpp>
 #include <cpputil/report_error.hpp>
+#include <cmath>
 
 namespace BOOM {
   namespace {
@@ -58,7 +61,7 @@ namespace BOOM {
         ans.mean_sample_size += suf.n();
         ans.sum_of_squares += suf.center_sumsq();
         double weight =
-            precision_model.nu() * suf.n() / ans.variance_sample_size;
+            mean_model.kappa() * suf.n() / ans.mean_sample_size;
         ans.sum_of_squares.add_outer(suf.ybar() - mean_model.mu(), weight);
         double shrinkage = mean_model.kappa() / (mean_model.kappa() + suf.n());
         ans.mean *= shrinkage;
@@ -67,6 +70,15 @@ namespace BOOM {
       return ans;
     }
 
+    // The log determinant of L * L^T, where L is lower triangular.
+    double cholesky_logdet(const Matrix &L) {
+      double ans = 0;
+      for (int i = 0; i < L.nrow(); ++i) {
+        ans += log(L(i, i));
+      }
+      return 2 * ans;
+    }
+
   }  // namespace
 
   DPMCGS::DirichletProcessMvnCollapsedGibbsSampler(
@@ -101,16 +113,18 @@ namespace BOOM {
         cluster_indicators_[i] = 0;
       }
     }
+    refresh_cluster_posteriors();
 
     for (int i = 0; i < data.size(); ++i) {
       const Vector &y(data[i]->value());
-      remove_data_from_cluster(y, cluster_indicators_[i]);
+      remove_data_from_cluster(y, slot_positions_[cluster_indicators_[i]]);
       cluster_indicators_[i] = -1;
       Vector prob = cluster_membership_probability(y);
       int cluster_number = rmulti_mt(rng(), prob);
-      model_->assign_data_to_cluster(y, cluster_number);
-      cluster_indicators_[i] = cluster_number;
+      assign_data_to_cluster(y, cluster_number);
+      cluster_indicators_[i] = cluster_slots_[cluster_number];
     }
+    compact_slots();
   }
 
   void DPMCGS::draw_parameters() {
@@ -130,64 +144,190 @@ namespace BOOM {
   }
 
   Vector DPMCGS::cluster_membership_probability(const Vector &y) {
+    ensure_cluster_posteriors();
     Vector ans(model_->number_of_clusters() + 1);
     int n = model_->dat().size();
     for (int i = 0; i < model_->number_of_clusters(); ++i) {
       const MvnSuf &suf(*model_->cluster(i).suf());
       ans[i] = log(suf.n()) - log(n - 1 + model_->alpha())
-          + log_marginal_density(y, suf);
+          + log_predictive_density(y, slots_[cluster_slots_[i]]);
     }
     ans.back() = log(model_->alpha()) - log(n - 1 + model_->alpha())
-        + log_marginal_density(y, empty_suf_);
+        + log_predictive_density(y, prior_);
 
     ans.normalize_logprob();
     return ans;
   }
 
-  // For the math, see Murphy (Machine Learning: A probabilistic
-  // perspective) page 161 (eq: 5.29).  We omit any factors that only
-  // depend on the 'sample size' (which is always 1), or other
-  // quantities that will be the same for all elements of the cluster
-  // membership probability vector.  We also rely on heavy
-  // cancellation in ratios of the multivariate gamma function.
   double DPMCGS::log_marginal_density(
       const Vector &y, const MvnSuf &suf) const {
-    NormalInverseWishartParameters prior = compute_mvn_posterior(
-        *mean_base_measure_,
-        *precision_base_measure_,
-        suf);
-    MvnSuf posterior_suf(suf);
-    posterior_suf.update_raw(y);
-    NormalInverseWishartParameters posterior = compute_mvn_posterior(
-        *mean_base_measure_,
-        *precision_base_measure_,
-        posterior_suf);
-    int dim = prior.mean.size();
-    double ans =
-        0.5 * dim * log(prior.mean_sample_size / posterior.mean_sample_size)
-        + 0.5 * prior.variance_sample_size
-              * prior.sum_of_squares.logdet()
-        - 0.5 * posterior.variance_sample_size
-              * posterior.sum_of_squares.logdet()
-        + lgamma((prior.variance_sample_size + 1) / 2.0)
-        - lgamma((prior.variance_sample_size + 1 - dim) / 2.0);
-    return ans;
+    ClusterPosterior posterior;
+    compute_cluster_posterior(suf, &posterior);
+    return log_predictive_density(y, posterior);
   }
 
   void DPMCGS::assign_data_to_cluster(const Vector &y, int cluster) {
+    ensure_cluster_posteriors();
+    if (cluster == cluster_slots_.size()) {
+      int slot;
+      if (free_slots_.empty()) {
+        slot = slots_.size();
+        slots_.push_back(prior_);
+        slot_positions_.push_back(-1);
+      } else {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+        slots_[slot] = prior_;
+      }
+      slot_positions_[slot] = cluster;
+      cluster_slots_.push_back(slot);
+    } else if (cluster < 0 || cluster > cluster_slots_.size()) {
+      report_error("Cluster indicator out of range in "
+                   "assign_data_to_cluster.");
+    }
     model_->assign_data_to_cluster(y, cluster);
+    add_to_posterior(y, &slots_[cluster_slots_[cluster]]);
   }
 
   void DPMCGS::remove_data_from_cluster(const Vector &y, int cluster) {
-    double empty = (model_->cluster(cluster).suf()->n() == 1);
+    ensure_cluster_posteriors();
+    if (cluster < 0 || cluster >= cluster_slots_.size()) {
+      report_error("Cluster indicator out of range in "
+                   "remove_data_from_cluster.");
+    }
+    int slot = cluster_slots_[cluster];
+    bool empty = (model_->cluster(cluster).suf()->n() == 1);
     model_->remove_data_from_cluster(y, cluster);
     if (empty) {
-      for (int i = 0; i < cluster_indicators_.size(); ++i) {
-        if (cluster_indicators_[i] >= cluster) {
-          --cluster_indicators_[i];
-        }
+      cluster_slots_.erase(cluster_slots_.begin() + cluster);
+      for (int i = cluster; i < cluster_slots_.size(); ++i) {
+        slot_positions_[cluster_slots_[i]] = i;
+      }
+      slot_positions_[slot] = -1;
+      free_slots_.push_back(slot);
+    } else if (!remove_from_posterior(y, &slots_[slot])) {
+      compute_cluster_posterior(*model_->cluster(cluster).suf(),
+                                &slots_[slot]);
+    }
+  }
+
+  void DPMCGS::ensure_cluster_posteriors() {
+    if (prior_.mean.empty()
+        || cluster_slots_.size() != model_->number_of_clusters()) {
+      refresh_cluster_posteriors();
+    }
+  }
+
+  void DPMCGS::refresh_cluster_posteriors() {
+    compute_cluster_posterior(MvnSuf(model_->dim()), &prior_);
+    int number_of_clusters = model_->number_of_clusters();
+    slots_.resize(number_of_clusters);
+    cluster_slots_.resize(number_of_clusters);
+    slot_positions_.resize(number_of_clusters);
+    free_slots_.clear();
+    for (int i = 0; i < number_of_clusters; ++i) {
+      compute_cluster_posterior(*model_->cluster(i).suf(), &slots_[i]);
+      cluster_slots_[i] = i;
+      slot_positions_[i] = i;
+    }
+  }
+
+  void DPMCGS::compute_cluster_posterior(
+      const MvnSuf &suf, ClusterPosterior *posterior) const {
+    NormalInverseWishartParameters params = compute_mvn_posterior(
+        *mean_base_measure_,
+        *precision_base_measure_,
+        suf);
+    Chol cholesky(params.sum_of_squares);
+    if (!cholesky.is_pos_def()) {
+      report_error("Posterior sum of squares matrix is not positive "
+                   "definite in DirichletProcessMvnCollapsedGibbsSampler.");
+    }
+    posterior->mean = params.mean;
+    posterior->mean_sample_size = params.mean_sample_size;
+    posterior->variance_sample_size = params.variance_sample_size;
+    posterior->sum_of_squares_cholesky = cholesky.getL();
+    posterior->sum_of_squares_logdet = cholesky.logdet();
+  }
+
+  // If the cluster posterior has mean m, mean sample size kappa,
+  // degrees of freedom nu, and sum of squares S, then adding y gives
+  // S' = S + (kappa / (kappa + 1)) * (y - m) * (y - m)^T.  The ratio
+  // of normalizing constants in Murphy's eq 5.29 then reduces to a
+  // multivariate T density, with |S'| = |S| * (1 + c * q), where c =
+  // kappa / (kappa + 1) and q = (y - m)^T S^{-1} (y - m).  As in the
+  // original computation, factors of pi that are the same for all
+  // clusters are omitted.
+  double DPMCGS::log_predictive_density(
+      const Vector &y, const ClusterPosterior &posterior) const {
+    const int dim = y.size();
+    const double kappa = posterior.mean_sample_size;
+    const double nu = posterior.variance_sample_size;
+    const double shrinkage = kappa / (kappa + 1);
+    wsp_ = y;
+    wsp_ -= posterior.mean;
+    Lsolve_inplace(posterior.sum_of_squares_cholesky, wsp_);
+    return 0.5 * dim * log(shrinkage)
+        - 0.5 * posterior.sum_of_squares_logdet
+        - 0.5 * (nu + 1) * ::log1p(shrinkage * wsp_.normsq())
+        + lgamma((nu + 1) / 2.0)
+        - lgamma((nu + 1 - dim) / 2.0);
+  }
+
+  void DPMCGS::add_to_posterior(const Vector &y,
+                                ClusterPosterior *posterior) {
+    const double kappa = posterior->mean_sample_size;
+    wsp_ = y;
+    wsp_ -= posterior->mean;
+    posterior->mean.axpy(wsp_, 1.0 / (kappa + 1));
+    wsp_ *= sqrt(kappa / (kappa + 1));
+    cholesky_rank_one_update(SubMatrix(posterior->sum_of_squares_cholesky),
+                             VectorView(wsp_));
+    posterior->mean_sample_size += 1;
+    posterior->variance_sample_size += 1;
+    posterior->sum_of_squares_logdet =
+        cholesky_logdet(posterior->sum_of_squares_cholesky);
+  }
+
+  // Removing y reverses add_to_posterior: with kappa the mean sample
+  // size after removal and m the mean after removal, S = S' - (kappa /
+  // (kappa + 1)) * (y - m) * (y - m)^T.
+  bool DPMCGS::remove_from_posterior(const Vector &y,
+                                     ClusterPosterior *posterior) {
+    const double kappa = posterior->mean_sample_size - 1;
+    posterior->mean *= kappa + 1;
+    posterior->mean -= y;
+    posterior->mean /= kappa;
+    wsp_ = y;
+    wsp_ -= posterior->mean;
+    wsp_ *= sqrt(kappa / (kappa + 1));
+    if (!cholesky_rank_one_downdate(
+            SubMatrix(posterior->sum_of_squares_cholesky),
+            VectorView(wsp_))) {
+      return false;
+    }
+    posterior->mean_sample_size -= 1;
+    posterior->variance_sample_size -= 1;
+    posterior->sum_of_squares_logdet =
+        cholesky_logdet(posterior->sum_of_squares_cholesky);
+    return true;
+  }
+
+  void DPMCGS::compact_slots() {
+    for (int i = 0; i < cluster_indicators_.size(); ++i) {
+      if (cluster_indicators_[i] >= 0) {
+        cluster_indicators_[i] = slot_positions_[cluster_indicators_[i]];
       }
     }
+    std::vector<ClusterPosterior> compacted;
+    compacted.reserve(cluster_slots_.size());
+    for (int i = 0; i < cluster_slots_.size(); ++i) {
+      compacted.push_back(slots_[cluster_slots_[i]]);
+      cluster_slots_[i] = i;
+    }
+    slots_.swap(compacted);
+    slot_positions_ = cluster_slots_;
+    free_slots_.clear();
   }
 
 }  // namespace BOOM
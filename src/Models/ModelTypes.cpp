@@ -34,12 +34,18 @@ namespace BOOM{
     : RefCounted()
   {}
 
+  void Model::seed_samplers(RNG &seeding_rng) {
+    for (int i = 0; i < number_of_sampling_methods(); ++i) {
+      sampler(i)->rng() = split_rng(seeding_rng);
+    }
+  }
+
   Vector Model::vectorize_params(bool minimal)const{
     ParamVector prm(t());
     uint nprm = prm.size();
     uint N(0), nmax(0);
     for(uint i=0; i<nprm; ++i){
-      uint n = prm[i]->size();
+      uint n = prm[i]->size(minimal);
       N += n;
       nmax = std::max(nmax, n);
     }
@@ -59,6 +65,25 @@ namespace BOOM{
     for(uint i=0; i<prm.size(); ++i) b = prm[i]->unvectorize(b, minimal);
   }
 
+  //============================================================
+  void MixtureComponent::batch_logp(const std::vector<Ptr<Data> > &data,
+                                    VectorView ans) const {
+    batch_logp(data, 0, data.size(), ans);
+  }
+
+  void MixtureComponent::batch_logp(const std::vector<Ptr<Data> > &data,
+                                    int begin,
+                                    int end,
+                                    VectorView ans) const {
+    if (begin < 0 || end > data.size() || ans.size() != end - begin) {
+      report_error("Invalid range or output vector size in "
+                   "MixtureComponent::batch_logp.");
+    }
+    for (int i = begin; i < end; ++i) {
+      ans[i - begin] = data[i]->missing() ? 0.0 : pdf(data[i].get(), true);
+    }
+  }
+
   //============================================================
   void PosteriorModeModel::find_posterior_mode(double epsilon) {
     if (number_of_sampling_methods() != 1) {
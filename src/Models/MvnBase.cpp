@@ -79,10 +79,16 @@ namespace BOOM{
   void MvnSuf::update_raw(const Vector & y) {
     check_dimension(y);
     n_+=1.0;
-    wsp_ = (y - ybar_) / n_;  // old ybar, new n
+    // wsp_ is reused for both outer products so that updating a
+    // sufficient statistic does not allocate.
+    wsp_ = y;
+    wsp_ -= ybar_;            // old ybar
+    wsp_ /= n_;               // new n
     ybar_ += wsp_;            // new ybar
     sumsq_.add_outer(wsp_, n_-1, false);
-    sumsq_.add_outer(y - ybar_, 1, false);
+    wsp_ = y;
+    wsp_ -= ybar_;
+    sumsq_.add_outer(wsp_, 1, false);
     sym_ = false;
   }
 
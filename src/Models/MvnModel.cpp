@@ -21,6 +21,7 @@
 
 #include <cmath>
 #include <distributions.hpp>
+#include <cpputil/Constants.hpp>
 
 #include <Models/MvnGivenSigma.hpp>
 #include <Models/WishartModel.hpp>
@@ -60,6 +61,45 @@ namespace BOOM{
     return logscale ? ans : exp(ans);
   }
 
+  void MvnModel::batch_logp(const std::vector<Ptr<Data> > &data,
+                            int begin, int end, VectorView ans) const {
+    if (begin < 0 || end > data.size() || begin > end
+        || ans.size() != end - begin) {
+      report_error("Index out of range in MvnModel::batch_logp.");
+    }
+    const int block_size = 64;
+    const int d = dim();
+    const Vector &mean(mu());
+    const Matrix &L(Sigma_prm()->ivar_chol());
+    const double constant = 0.5 * ldsi() - d * Constants::log_root_2pi;
+    Matrix residuals;
+    Matrix transformed;
+    for (int start = begin; start < end; start += block_size) {
+      int m = std::min(block_size, end - start);
+      if (residuals.nrow() != m) {
+        residuals.resize(m, d);
+        transformed.resize(m, d);
+      }
+      for (int i = 0; i < m; ++i) {
+        const Data *dp = data[start + i].get();
+        if (dp->missing()) {
+          residuals.row(i) = 0.0;
+        } else {
+          VectorView residual(residuals.row(i));
+          residual = DAT(dp)->value();
+          residual -= mean;
+        }
+      }
+      // If siginv = L * L^T then the quadratic form for row i is the
+      // squared norm of row i of residuals * L.
+      residuals.mult(L, transformed);
+      for (int i = 0; i < m; ++i) {
+        ans[start - begin + i] = data[start + i]->missing() ? 0.0 :
+            constant - 0.5 * transformed.row(i).normsq();
+      }
+    }
+  }
+
   Vector MvnModel::sim()const{
     return sim(GlobalRng::rng);
   }
@@ -77,7 +77,7 @@ void EDS::draw(){
 
   for(uint i=0; i<d; ++i){
     target logp(sumlog, nobs, nu, i, pri_);
-    ScalarSliceSampler sam(logp);
+    ScalarSliceSampler sam(logp, false, 1.0, &rng());
     sam.set_lower_limit(0);
     nu[i] = sam.draw(nu[i]);
   }
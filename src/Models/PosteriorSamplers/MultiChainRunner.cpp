@@ -0,0 +1,77 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include <Models/PosteriorSamplers/MultiChainRunner.hpp>
+#include <cpputil/report_error.hpp>
+#include <chrono>
+
+namespace BOOM {
+
+  MultiChainRunner::MultiChainRunner(const Ptr<Model> &prototype,
+                                     int number_of_chains,
+                                     unsigned long seed,
+                                     const ChainSetup &setup,
+                                     int number_of_threads) {
+    if (!prototype) {
+      report_error("MultiChainRunner needs a prototype model.");
+    }
+    if (number_of_chains <= 0) {
+      report_error("MultiChainRunner needs at least one chain.");
+    }
+    RNG master_rng(seed);
+    for (int i = 0; i < number_of_chains; ++i) {
+      RNG seeding_rng(split_rng(master_rng));
+      Ptr<Model> chain(prototype->clone());
+      setup(chain.get(), seeding_rng);
+      if (chain->number_of_sampling_methods() == 0) {
+        report_error("MultiChainRunner setup did not assign a posterior "
+                     "sampler to the model.");
+      }
+      chain->seed_samplers(seeding_rng);
+      chains_.push_back(chain);
+    }
+    draws_.resize(number_of_chains);
+    reports_.resize(number_of_chains);
+    pool_.set_number_of_threads(
+        number_of_threads < 0 ? number_of_chains : number_of_threads);
+  }
+
+  void MultiChainRunner::run(int niter) {
+    std::vector<std::function<void()>> tasks;
+    for (int i = 0; i < chains_.size(); ++i) {
+      tasks.push_back([this, i, niter]() {this->run_chain(i, niter);});
+    }
+    pool_.run(tasks);
+  }
+
+  void MultiChainRunner::run_chain(int chain, int niter) {
+    Model *model = chains_[chain].get();
+    Matrix &draws(draws_[chain]);
+    draws.resize(niter, model->vectorize_params(false).size());
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < niter; ++i) {
+      model->sample_posterior();
+      draws.row(i) = model->vectorize_params(false);
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    reports_[chain].iterations = niter;
+    reports_[chain].seconds = elapsed.count();
+  }
+
+}  // namespace BOOM
@@ -80,7 +80,7 @@ namespace BOOM{
 
   void MCS::draw(){
     set_posterior_sufficient_statistics();
-    SS = rWish(DF, SS.inv());// check this.. inverse?
+    SS = rWish_mt(rng(), DF, SS.inv());// check this.. inverse?
     mod_->set_siginv(SS);
     mu_hat = rmvn_mt(rng(), mu_hat, mod_->Sigma()/(n+k));
     mod_->set_mu(mu_hat);
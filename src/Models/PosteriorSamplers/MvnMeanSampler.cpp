@@ -102,8 +102,8 @@ namespace BOOM{
     const SpdMatrix &siginv(mvn->siginv());
     const SpdMatrix &ominv(mu_prior_->siginv());
     SpdMatrix Ivar = n*siginv + ominv;
-    Vector mu = Ivar.solve(n*(siginv*s->ybar()) + ominv*mu_prior_->mu());
-    mu = rmvn_ivar(mu, Ivar);
+    Vector mu = rmvn_suf_mt(rng(), Chol(Ivar),
+                            n*(siginv*s->ybar()) + ominv*mu_prior_->mu());
     mvn->set_mu(mu);
   }
 }
@@ -57,7 +57,7 @@ namespace BOOM{
     double df = pdf_->value() + s->n();
     SpdMatrix S = s->center_sumsq(mvn_->mu());
     S += pss_->value();
-    S = rWish(df, S.inv());
+    S = rWish_mt(rng(), df, S.inv());
     Ptr<SpdParams> sp = mvn_->Sigma_prm();
     sp->set_ivar(S);
   }
@@ -81,7 +81,7 @@ namespace BOOM{
     double df = pdf()->value() + s->n() - 1;
     SpdMatrix S = s->center_sumsq(s->ybar());
     S += pss()->value();
-    S = rWish(df, S.inv());
+    S = rWish_mt(rng(), df, S.inv());
     Ptr<SpdParams> sp = mvn()->Sigma_prm();
     sp->set_ivar(S);
   }
@@ -24,7 +24,7 @@ namespace BOOM{
   void intrusive_ptr_add_ref(PosteriorSampler *m) { m->up_count(); }
 
   void intrusive_ptr_release(PosteriorSampler *m) {
-    m->down_count(); if(m->ref_count()==0) delete m; }
+    if(m->down_count() == 0) delete m; }
 
   PosteriorSampler::PosteriorSampler(RNG &seeding_rng)
       : rng_(seed_rng(seeding_rng))
@@ -42,7 +42,7 @@ void PDPS::draw(){
           phi_row_prior_[i].get(),
           alpha_row_prior_[i].get(),
           min_nu_);
-      ScalarSliceSampler sam(logp, true);
+      ScalarSliceSampler sam(logp, true, 1.0, &rng());
       sam.set_lower_limit(min_nu_);
       nu[j]= sam.draw(nu[j]);
     }
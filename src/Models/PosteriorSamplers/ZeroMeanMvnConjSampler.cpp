@@ -43,7 +43,7 @@ namespace BOOM{
     Ptr<MvnSuf> s = m_->suf();
     double df = s->n() + siginv_prior_->nu();
     SpdMatrix S = s->center_sumsq(m_->mu()) + siginv_prior_->sumsq();
-    S = rWish(df, S.inv());
+    S = rWish_mt(rng(), df, S.inv());
     m_->prm()->set_ivar(S);
   }
 
@@ -310,18 +310,22 @@ namespace BOOM{
   void SD::set_var(const SpdMatrix & var, bool sig){
     var_->set(var,sig);
     current_rep_ = var_;
+    if(sig) signal();
   }
   void SD::set_ivar(const SpdMatrix & ivar, bool sig){
     ivar_->set(ivar, sig);
     current_rep_ =ivar_;
+    if(sig) signal();
   }
   void SD::set_ivar_chol(const Matrix & L, bool sig){
     ivar_chol_->set(L, sig);
     current_rep_ = ivar_chol_;
+    if(sig) signal();
   }
   void SD::set_var_chol(const Matrix & L, bool sig){
     var_chol_->set(L, sig);
     current_rep_ = var_chol_;
+    if(sig) signal();
   }
 
   void SD::set_S_Rchol(const Vector &sd, const Matrix &L){
@@ -22,8 +22,36 @@
 #include <Models/StateSpace/Filters/SparseMatrix.hpp>
 #include <distributions.hpp>
 #include <cpputil/report_error.hpp>
+#include <algorithm>
+#include <cmath>
 
 namespace BOOM{
+  void SparseKalmanWorkspace::resize(int state_dimension) {
+    if (PZ.size() != state_dimension) {
+      PZ.resize(state_dimension);
+      TPZ.resize(state_dimension);
+      state.resize(state_dimension);
+      state2.resize(state_dimension);
+    }
+  }
+
+  double sparse_scalar_kalman_update(
+      double y,
+      Vector &a,
+      SpdMatrix &P,
+      Vector &K,
+      double &F,
+      double &v,
+      bool missing,
+      const SparseVector & Z,
+      double H,
+      const SparseKalmanMatrix & T,
+      const SparseKalmanMatrix & RQR) {
+    SparseKalmanWorkspace workspace;
+    return sparse_scalar_kalman_update(
+        y, a, P, K, F, v, missing, Z, H, T, RQR, workspace);
+  }
+
   double sparse_scalar_kalman_update(
       double y,                         // New observation at time t
       Vector &a,                        // Input a[t].  Output a[t+1]
@@ -35,9 +63,12 @@ namespace BOOM{
       const SparseVector & Z,           // Model matrix for obs. equation
       double H,                         // Var(Y | state)
       const SparseKalmanMatrix & T,     // State transition matrix
-      const SparseKalmanMatrix & RQR) { // State variance matrix
-
-    Vector PZ = P*Z;
+      const SparseKalmanMatrix & RQR,   // State variance matrix
+      SparseKalmanWorkspace &workspace) {
+    workspace.resize(a.size());
+    Vector &PZ(workspace.PZ);
+    Vector &TPZ(workspace.TPZ);
+    multiply(VectorView(PZ), P, Z);
     F = Z.dot(PZ) + H;
     if (F <= 0) {
       std::ostringstream err;
@@ -51,20 +82,24 @@ namespace BOOM{
           << "Z = " << Z.dense() << endl;
       report_error(err.str());
     }
-    Vector TPZ = T * PZ;
+    T.multiply(VectorView(TPZ), ConstVectorView(PZ));
 
     double loglike=0;
+    K.resize(a.size());
     if (!missing) {
-      K = TPZ/F;
+      K = TPZ;
+      K /= F;
       double mu = Z.dot(a);
       v = y-mu;
       loglike = dnorm(y, mu, sqrt(F), true);
     }else{
-      K = a.zero();
+      K = 0.0;
       v = 0;
     }
 
-    a = T * a;                         // Sparse multiplication
+    // a = T * a, computed in the workspace and swapped into place.
+    T.multiply(VectorView(workspace.state), ConstVectorView(a));
+    a.swap(workspace.state);
     if (!missing) a.axpy(K, v);         // a += K * v
     T.sandwich_inplace(P);             // P = T P T.transpose()
     if (!missing) {                      // K is zero if missing, so skip this
@@ -75,6 +110,98 @@ namespace BOOM{
     return loglike;
   }
 
+  //======================================================================
+  SteadyStateKalmanFilter::SteadyStateKalmanFilter(
+      double tolerance, int stable_steps_required)
+      : tolerance_(tolerance),
+        stable_steps_required_(stable_steps_required),
+        enabled_(false),
+        converged_(false),
+        stable_steps_(0),
+        previous_F_(-1),
+        previous_H_(-1),
+        steady_state_sd_(-1)
+  {}
+
+  void SteadyStateKalmanFilter::reset(bool enabled) {
+    enabled_ = enabled;
+    converged_ = false;
+    stable_steps_ = 0;
+    previous_F_ = -1;
+    previous_H_ = -1;
+  }
+
+  bool SteadyStateKalmanFilter::check_convergence(const Vector &K, double F) {
+    bool ans = previous_F_ > 0
+        && previous_K_.size() == K.size()
+        && fabs(F - previous_F_) <= tolerance_ * F;
+    if (ans) {
+      double scale = 0;
+      double change = 0;
+      for (int i = 0; i < K.size(); ++i) {
+        scale = std::max(scale, fabs(K[i]));
+        change = std::max(change, fabs(K[i] - previous_K_[i]));
+      }
+      ans = change <= tolerance_ * scale;
+    }
+    previous_F_ = F;
+    previous_K_ = K;
+    return ans;
+  }
+
+  double SteadyStateKalmanFilter::update(
+      double y,
+      Vector &a,
+      SpdMatrix &P,
+      Vector &K,
+      double &F,
+      double &v,
+      bool missing,
+      const SparseVector &Z,
+      double H,
+      const SparseKalmanMatrix &T,
+      const SparseKalmanMatrix &RQR,
+      SparseKalmanWorkspace &workspace) {
+    if (!enabled_) {
+      return sparse_scalar_kalman_update(
+          y, a, P, K, F, v, missing, Z, H, T, RQR, workspace);
+    }
+
+    if (converged_ && !missing && H == previous_H_) {
+      // Steady state: P[t+1] == P[t], so only the mean moves.
+      K = previous_K_;
+      F = previous_F_;
+      double mu = Z.dot(a);
+      v = y - mu;
+      T.multiply(VectorView(workspace.state), ConstVectorView(a));
+      a.swap(workspace.state);
+      a.axpy(K, v);
+      return dnorm(y, mu, steady_state_sd_, true);
+    }
+
+    double loglike = sparse_scalar_kalman_update(
+        y, a, P, K, F, v, missing, Z, H, T, RQR, workspace);
+    if (missing || H != previous_H_) {
+      // A missing observation or a change in H knocks P off its
+      // steady state, so start counting again.
+      converged_ = false;
+      stable_steps_ = 0;
+      previous_H_ = H;
+      previous_F_ = -1;
+      return loglike;
+    }
+    if (check_convergence(K, F)) {
+      if (++stable_steps_ >= stable_steps_required_) {
+        converged_ = true;
+        steady_state_sd_ = sqrt(F);
+      }
+    } else {
+      stable_steps_ = 0;
+    }
+    return loglike;
+  }
+
+  //======================================================================
   // As part of the Kalman smoothing (backward) recursion, update the
   // vector r[t] and the matrix N[t] to time t-1.
   //
@@ -137,4 +264,101 @@ namespace BOOM{
     scaled_residual_variance_N = previousN;
   }
 
+  //----------------------------------------------------------------------
+  double sparse_sequential_kalman_update(
+      const Vector &y,
+      Vector &a,
+      SpdMatrix &P,
+      std::vector<LightKalmanStorage> &storage,
+      const std::vector<bool> &missing,
+      const std::vector<SparseVector> &Z,
+      const Vector &H,
+      const SparseKalmanMatrix &T,
+      const SparseKalmanMatrix &RQR) {
+    SparseKalmanWorkspace workspace;
+    return sparse_sequential_kalman_update(
+        y, a, P, storage, missing, Z, H, T, RQR, workspace);
+  }
+
+  double sparse_sequential_kalman_update(
+      const Vector &y,
+      Vector &a,
+      SpdMatrix &P,
+      std::vector<LightKalmanStorage> &storage,
+      const std::vector<bool> &missing,
+      const std::vector<SparseVector> &Z,
+      const Vector &H,
+      const SparseKalmanMatrix &T,
+      const SparseKalmanMatrix &RQR,
+      SparseKalmanWorkspace &workspace) {
+    workspace.resize(a.size());
+    Vector &PZ(workspace.PZ);
+    double loglike = 0;
+    for (int j = 0; j < y.size(); ++j) {
+      LightKalmanStorage &s(storage[j]);
+      s.K.resize(a.size());
+      if (missing[j]) {
+        s.K = 0.0;
+        s.v = 0;
+        s.F = 1;
+        continue;
+      }
+      multiply(VectorView(PZ), P, Z[j]);
+      s.F = Z[j].dot(PZ) + H[j];
+      if (s.F <= 0) {
+        std::ostringstream err;
+        err << "Found a zero forecast variance for element " << j
+            << " of a multivariate observation:" << endl
+            << "a = " << a << endl
+            << "P = " << endl << P << endl
+            << "y = " << y << endl
+            << "H = " << H << endl
+            << "Z = " << Z[j].dense() << endl;
+        report_error(err.str());
+      }
+      s.v = y[j] - Z[j].dot(a);
+      s.K = PZ;
+      s.K /= s.F;
+      loglike += dnorm(s.v, 0, sqrt(s.F), true);
+      a.axpy(s.K, s.v);                  // a += K * v
+      P.Matrix::add_outer(PZ, s.K, -1);  // P -= P * Z * Z' * P / F
+    }
+    // a = T * a, computed in the workspace and swapped into place.
+    T.multiply(VectorView(workspace.state), ConstVectorView(a));
+    a.swap(workspace.state);
+    T.sandwich_inplace(P);
+    RQR.add_to(P);
+    return loglike;
+  }
+
+  //----------------------------------------------------------------------
+  // Durbin and Koopman (2001) equation (6.62), written in terms of
+  // the r[t] used by the scalar disturbance smoother in
+  // StateSpaceModelBase.
+  void sparse_sequential_disturbance_smoother_update(
+      Vector &r,
+      const std::vector<LightKalmanStorage> &storage,
+      const std::vector<SparseVector> &Z,
+      const SparseKalmanMatrix &T) {
+    SparseKalmanWorkspace workspace;
+    sparse_sequential_disturbance_smoother_update(
+        r, storage, Z, T, workspace);
+  }
+
+  void sparse_sequential_disturbance_smoother_update(
+      Vector &r,
+      const std::vector<LightKalmanStorage> &storage,
+      const std::vector<SparseVector> &Z,
+      const SparseKalmanMatrix &T,
+      SparseKalmanWorkspace &workspace) {
+    workspace.resize(r.size());
+    T.Tmult(VectorView(workspace.state), ConstVectorView(r));
+    r.swap(workspace.state);
+    for (int j = storage.size() - 1; j >= 0; --j) {
+      const LightKalmanStorage &s(storage[j]);
+      double coefficient = (s.v / s.F) - s.K.dot(r);
+      Z[j].add_this_to(r, coefficient);
+    }
+  }
+
 }
@@ -116,6 +116,34 @@ namespace BOOM{
     return ans;
   }
 
+  //======================================================================
+  void DenseMatrix::multiply(VectorView lhs, const ConstVectorView &rhs) const {
+    conforms_to_rows(lhs.size());
+    conforms_to_cols(rhs.size());
+    for (int i = 0; i < lhs.size(); ++i) {
+      lhs[i] = m_.row(i).dot(rhs);
+    }
+  }
+
+  void DenseMatrix::Tmult(VectorView lhs, const ConstVectorView &rhs) const {
+    conforms_to_cols(lhs.size());
+    conforms_to_rows(rhs.size());
+    for (int i = 0; i < lhs.size(); ++i) {
+      lhs[i] = m_.col(i).dot(rhs);
+    }
+  }
+
+  //======================================================================
+  void DenseSpd::multiply(VectorView lhs, const ConstVectorView &rhs) const {
+    conforms_to_rows(lhs.size());
+    conforms_to_cols(rhs.size());
+    // m_ is symmetric, so columns can stand in for rows.  Columns are
+    // contiguous.
+    for (int i = 0; i < lhs.size(); ++i) {
+      lhs[i] = m_.col(i).dot(rhs);
+    }
+  }
+
   //======================================================================
   typedef SeasonalStateSpaceMatrix SSSM;
 
@@ -324,6 +352,16 @@ namespace BOOM{
     return ans;
   }
 
+  void SparseKalmanMatrix::multiply(VectorView lhs,
+                                    const ConstVectorView &rhs) const {
+    lhs = (*this) * rhs;
+  }
+
+  void SparseKalmanMatrix::Tmult(VectorView lhs,
+                                 const ConstVectorView &rhs) const {
+    lhs = this->Tmult(Vector(rhs));
+  }
+
   SubMatrix SparseKalmanMatrix::add_to_submatrix(SubMatrix P) const {
     Matrix tmp(P.to_matrix());
     this->add_to(tmp);
@@ -431,6 +469,40 @@ namespace BOOM{
     return ans;
   }
 
+  void BlockDiagonalMatrix::multiply(VectorView lhs,
+                                     const ConstVectorView &rhs) const {
+    if (lhs.size() != nrow() || rhs.size() != ncol()) {
+      report_error("incompatible vector in BlockDiagonalMatrix::multiply");
+    }
+    int lhs_pos = 0;
+    int rhs_pos = 0;
+    for (int b = 0; b < blocks_.size(); ++b) {
+      int nr = blocks_[b]->nrow();
+      int nc = blocks_[b]->ncol();
+      blocks_[b]->multiply(VectorView(lhs, lhs_pos, nr),
+                           ConstVectorView(rhs, rhs_pos, nc));
+      lhs_pos += nr;
+      rhs_pos += nc;
+    }
+  }
+
+  void BlockDiagonalMatrix::Tmult(VectorView lhs,
+                                  const ConstVectorView &rhs) const {
+    if (lhs.size() != ncol() || rhs.size() != nrow()) {
+      report_error("incompatible vector in BlockDiagonalMatrix::Tmult");
+    }
+    int lhs_pos = 0;
+    int rhs_pos = 0;
+    for (int b = 0; b < blocks_.size(); ++b) {
+      int nr = blocks_[b]->nrow();
+      int nc = blocks_[b]->ncol();
+      blocks_[b]->Tmult(VectorView(lhs, lhs_pos, nc),
+                        ConstVectorView(rhs, rhs_pos, nr));
+      lhs_pos += nc;
+      rhs_pos += nr;
+    }
+  }
+
   // This assumes blocks_ are square
   SpdMatrix BlockDiagonalMatrix::sandwich(const SpdMatrix &P) const {
     SpdMatrix ans(P);
@@ -19,13 +19,21 @@
 #include <Models/StateSpace/Filters/SparseVector.hpp>
 #include <cpputil/report_error.hpp>
 #include <LinAlg/SpdMatrix.hpp>
+#include <algorithm>
 #include <iostream>
 
 namespace BOOM{
 
   typedef SparseVectorReturnProxy SVRP;
-  typedef std::map<int,double>::iterator  It;
-  typedef std::map<int,double>::const_iterator  Cit;
+  typedef std::pair<int, double> Element;
+  typedef std::vector<Element>::iterator  It;
+  typedef std::vector<Element>::const_iterator  Cit;
+
+  namespace {
+    bool position_less(const Element &element, int position) {
+      return element.first < position;
+    }
+  }  // namespace
 
   SVRP::SparseVectorReturnProxy(int position, double value,
                                 SparseVector *v)
@@ -35,7 +43,7 @@ namespace BOOM{
   {}
 
   SVRP & SVRP::operator=(double x){
-    v_->elements_[position_] = x;
+    v_->set_element(position_, x);
     value_ = x;
     return *this;
   }
@@ -55,17 +63,35 @@ namespace BOOM{
 
   SparseVector::SparseVector(const Vector &dense)
       : size_(dense.size()) {
+    elements_.reserve(size_);
     for (int i = 0; i < size_; ++i) {
-      elements_[i] = dense[i];
+      elements_.push_back(Element(i, dense[i]));
     }
   }
 
   int SparseVector::size() const {return size_;}
 
+  void SparseVector::set_element(int n, double value) {
+    if (elements_.empty() || elements_.back().first < n) {
+      elements_.push_back(Element(n, value));
+      return;
+    }
+    It it = std::lower_bound(
+        elements_.begin(), elements_.end(), n, position_less);
+    if (it != elements_.end() && it->first == n) {
+      it->second = value;
+    } else {
+      elements_.insert(it, Element(n, value));
+    }
+  }
+
   SparseVector & SparseVector::concatenate(const SparseVector &rhs){
-    for(Cit it = rhs.elements_.begin(); it!=rhs.elements_.end(); ++it){
-      int indx = size_ + it->first;
-      elements_[indx] = it->second;
+    // Index rather than iterate over rhs, so that v.concatenate(v)
+    // is safe.
+    int nonzeros = rhs.elements_.size();
+    elements_.reserve(elements_.size() + nonzeros);
+    for (int i = 0; i < nonzeros; ++i) {
+      set_element(size_ + rhs.elements_[i].first, rhs.elements_[i].second);
     }
     size_ += rhs.size_;
     return *this;
@@ -73,15 +99,17 @@ namespace BOOM{
 
   double SparseVector::operator[](int n) const {
     check_index(n);
-    Cit it = elements_.find(n);
-    if(it == elements_.end()) return 0;
+    Cit it = std::lower_bound(
+        elements_.begin(), elements_.end(), n, position_less);
+    if(it == elements_.end() || it->first != n) return 0;
     return it->second;
   }
 
   SparseVectorReturnProxy SparseVector::operator[](int n){
     check_index(n);
-    It it = elements_.find(n);
-    if(it == elements_.end()){
+    It it = std::lower_bound(
+        elements_.begin(), elements_.end(), n, position_less);
+    if(it == elements_.end() || it->first != n){
       return SparseVectorReturnProxy(n, 0, this);
     }
     return SparseVectorReturnProxy(n, it->second, this);
@@ -112,7 +140,7 @@ namespace BOOM{
   }
 
   template <class VEC>
-  double do_dot(const VEC &v, const std::map<int,double> &m, int size){
+  double do_dot(const VEC &v, const std::vector<Element> &m, int size){
     if(v.size() != size){
       report_error("incompatible vector in SparseVector dot product");
     }
@@ -212,6 +240,18 @@ namespace BOOM{
     return ans;
   }
 
+  void multiply(VectorView ans, const SpdMatrix &P, const SparseVector &z){
+    int n = nrow(P);
+    if(ans.size() != n){
+      report_error("Wrong size output argument to multiply(VectorView, "
+                   "SpdMatrix, SparseVector).");
+    }
+    for(int i = 0; i < n; ++i){
+      // P is symmetric, and its columns are contiguous.
+      ans[i] = z.dot(P.col(i));
+    }
+  }
+
   Vector operator*(SubMatrix P, const SparseVector &z){
     int n = P.nrow();
     Vector ans(n);
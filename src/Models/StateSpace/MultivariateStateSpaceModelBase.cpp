@@ -0,0 +1,249 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include <Models/StateSpace/MultivariateStateSpaceModelBase.hpp>
+#include <Models/StateSpace/Filters/SparseKalmanTools.hpp>
+#include <cpputil/math_utils.hpp>
+#include <cpputil/report_error.hpp>
+#include <distributions.hpp>
+
+namespace BOOM {
+
+  typedef MultivariateStateSpaceModelBase MSSMB;
+
+  MSSMB::MultivariateStateSpaceModelBase() {}
+
+  MSSMB::MultivariateStateSpaceModelBase(const MSSMB &rhs)
+      : Model(rhs),
+        StateSpaceModelBase(rhs)
+  {}
+
+  //----------------------------------------------------------------------
+  double MSSMB::observation_coefficient(int, int) const {
+    return 1.0;
+  }
+
+  //----------------------------------------------------------------------
+  SparseVector MSSMB::observation_matrix(int t, int series) const {
+    SparseVector ans;
+    for (int s = 0; s < nstate(); ++s) {
+      SparseVector block = state_model(s)->observation_matrix(t);
+      double coefficient = observation_coefficient(series, s);
+      if (coefficient == 0.0) {
+        block = SparseVector(block.size());
+      } else if (coefficient != 1.0) {
+        block *= coefficient;
+      }
+      ans.concatenate(block);
+    }
+    return ans;
+  }
+
+  //----------------------------------------------------------------------
+  double MSSMB::observation_variance(int) const {
+    report_error("The scalar version of observation_variance() is not "
+                 "defined for a MultivariateStateSpaceModelBase.");
+    return negative_infinity();
+  }
+
+  //----------------------------------------------------------------------
+  double MSSMB::adjusted_observation(int) const {
+    report_error("The scalar version of adjusted_observation() is not "
+                 "defined for a MultivariateStateSpaceModelBase.");
+    return negative_infinity();
+  }
+
+  //----------------------------------------------------------------------
+  bool MSSMB::is_missing_observation(int t) const {
+    for (int j = 0; j < nseries(); ++j) {
+      if (!is_missing_observation(t, j)) return false;
+    }
+    return true;
+  }
+
+  //----------------------------------------------------------------------
+  void MSSMB::impute_state(RNG &rng) {
+    set_state_model_behavior(StateModel::MIXTURE);
+    resize_state();
+    clear_client_data();
+    simulate_forward(rng);
+    smooth_disturbances();
+    propagate_disturbances();
+  }
+
+  //----------------------------------------------------------------------
+  double MSSMB::log_likelihood() const {
+    int n = time_dimension();
+    if (n == 0) return 0;
+    Vector a = initial_state_mean();
+    SpdMatrix P = initial_state_variance();
+    std::vector<LightKalmanStorage> storage(
+        nseries(), LightKalmanStorage(state_dimension()));
+    std::vector<SparseVector> Z;
+    Vector y, H;
+    std::vector<bool> missing;
+    double ans = 0;
+    for (int t = 0; t < n; ++t) {
+      observation_equation(t, Z, y, H, missing);
+      ans += sparse_sequential_kalman_update(
+          y, a, P, storage, missing, Z, H,
+          *state_transition_matrix(t),
+          *state_variance_matrix(t));
+    }
+    return ans;
+  }
+
+  //----------------------------------------------------------------------
+  void MSSMB::observation_equation(int t,
+                                   std::vector<SparseVector> &Z,
+                                   Vector &y,
+                                   Vector &H,
+                                   std::vector<bool> &missing) const {
+    int p = nseries();
+    Z.resize(p);
+    y.resize(p);
+    H.resize(p);
+    missing.resize(p);
+    for (int j = 0; j < p; ++j) {
+      Z[j] = observation_matrix(t, j);
+      H[j] = observation_variance(t, j);
+      missing[j] = is_missing_observation(t, j);
+      y[j] = missing[j] ? 0.0 : adjusted_observation(t, j);
+    }
+  }
+
+  //----------------------------------------------------------------------
+  void MSSMB::check_kalman_storage(
+      std::vector<std::vector<LightKalmanStorage> > &kalman_storage) {
+    int n = time_dimension();
+    int p = nseries();
+    int dim = state_dimension();
+    if (!kalman_storage.empty()
+        && (kalman_storage[0].size() != p
+            || kalman_storage[0][0].K.size() != dim)) {
+      kalman_storage.clear();
+    }
+    kalman_storage.resize(
+        n, std::vector<LightKalmanStorage>(p, LightKalmanStorage(dim)));
+  }
+
+  //----------------------------------------------------------------------
+  // Simulate alpha_+ and y_+ from the model, and run the Kalman
+  // filter on both y_+ and the observed y.  This mirrors
+  // StateSpaceModelBase::simulate_forward, with each time step
+  // absorbing a vector of observations.
+  void MSSMB::simulate_forward(RNG &rng) {
+    check_kalman_storage(kalman_storage_);
+    check_kalman_storage(supplemental_kalman_storage_);
+    observation_matrices_.resize(time_dimension());
+    Matrix &state(mutable_state());
+    for (int t = 0; t < time_dimension(); ++t) {
+      if (t == 0) {
+        simulate_initial_state(rng, state.col(0));
+        a_ = initial_state_mean();
+        P_ = initial_state_variance();
+        supplemental_a_ = a_;
+        supplemental_P_ = P_;
+      } else {
+        simulate_next_state(rng, state.col(t - 1), state.col(t), t);
+      }
+      std::vector<SparseVector> &Z(observation_matrices_[t]);
+      observation_equation(t, Z, observed_y_, observation_variances_,
+                           missing_);
+      simulated_y_.resize(nseries());
+      for (int j = 0; j < nseries(); ++j) {
+        simulated_y_[j] = rnorm_mt(
+            rng,
+            Z[j].dot(state.col(t)),
+            sqrt(observation_variances_[j]));
+      }
+      const SparseKalmanMatrix &transition(*state_transition_matrix(t));
+      const SparseKalmanMatrix &variance(*state_variance_matrix(t));
+      sparse_sequential_kalman_update(
+          simulated_y_, a_, P_, kalman_storage_[t], missing_,
+          Z, observation_variances_,
+          transition, variance, kalman_workspace_);
+      sparse_sequential_kalman_update(
+          observed_y_, supplemental_a_, supplemental_P_,
+          supplemental_kalman_storage_[t], missing_,
+          Z, observation_variances_,
+          transition, variance, kalman_workspace_);
+    }
+  }
+
+  //----------------------------------------------------------------------
+  // Run the backward disturbance smoothing recursions for the
+  // simulated and observed data together, using the observation
+  // matrices saved by simulate_forward().  Only the difference
+  // between the two sets of disturbances is needed by
+  // propagate_disturbances().
+  void MSSMB::smooth_disturbances() {
+    int n = time_dimension();
+    r_sim_.resize(state_dimension());
+    r_sim_ = 0.0;
+    r_obs_.resize(state_dimension());
+    r_obs_ = 0.0;
+    disturbance_difference_.resize(state_dimension(), n);
+    for (int t = n - 1; t >= 0; --t) {
+      VectorView difference(disturbance_difference_.col(t));
+      difference = r_obs_;
+      difference -= r_sim_;
+      const std::vector<SparseVector> &Z(observation_matrices_[t]);
+      const SparseKalmanMatrix &transition(*state_transition_matrix(t));
+      sparse_sequential_disturbance_smoother_update(
+          r_sim_, kalman_storage_[t], Z, transition, kalman_workspace_);
+      sparse_sequential_disturbance_smoother_update(
+          r_obs_, supplemental_kalman_storage_[t], Z, transition,
+          kalman_workspace_);
+    }
+    initial_disturbance_difference_ = r_obs_;
+    initial_disturbance_difference_ -= r_sim_;
+  }
+
+  //----------------------------------------------------------------------
+  // The smoothed state means for the observed and simulated data obey
+  // the same linear recursion, so their difference can be propagated
+  // directly and added to the simulated state.
+  void MSSMB::propagate_disturbances() {
+    int n = time_dimension();
+    if (n <= 0) return;
+    Matrix &state(mutable_state());
+    mean_difference_ =
+        initial_state_variance() * initial_disturbance_difference_;
+    variance_term_.resize(state_dimension());
+    kalman_workspace_.resize(state_dimension());
+    Vector &transition_term(kalman_workspace_.state);
+    state.col(0) += mean_difference_;
+    observe_state(0);
+    observe_data_given_state(0);
+    for (int t = 1; t < n; ++t) {
+      // mean[t] = T[t-1] * mean[t-1] + RQR[t-1] * r[t-1].
+      state_variance_matrix(t - 1)->multiply(
+          VectorView(variance_term_),
+          ConstVectorView(disturbance_difference_.col(t - 1)));
+      state_transition_matrix(t - 1)->multiply(
+          VectorView(transition_term), ConstVectorView(mean_difference_));
+      mean_difference_.swap(transition_term);
+      mean_difference_ += variance_term_;
+      state.col(t) += mean_difference_;
+      observe_state(t);
+      observe_data_given_state(t);
+    }
+  }
+
+}  // namespace BOOM
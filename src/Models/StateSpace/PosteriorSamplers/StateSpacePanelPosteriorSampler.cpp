@@ -0,0 +1,57 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include <Models/StateSpace/PosteriorSamplers/StateSpacePanelPosteriorSampler.hpp>
+
+namespace BOOM {
+
+  typedef StateSpacePanelPosteriorSampler SSPPS;
+
+  SSPPS::StateSpacePanelPosteriorSampler(StateSpacePanel *model,
+                                         RNG &seeding_rng)
+      : PosteriorSampler(seeding_rng),
+        m_(model),
+        latent_data_initialized_(false)
+  {}
+
+  void SSPPS::draw() {
+    if (!latent_data_initialized_) {
+      m_->impute_state(rng());
+      latent_data_initialized_ = true;
+    }
+    m_->sample_observation_posteriors();
+    for (int s = 0; s < m_->nstate(); ++s) {
+      m_->shared_state_model(s)->sample_posterior();
+    }
+    // End with a call to impute_state() so that the internal state of
+    // each series' Kalman filter matches up with the parameter draws.
+    m_->impute_state(rng());
+  }
+
+  double SSPPS::logpri() const {
+    double ans = 0;
+    for (int s = 0; s < m_->nstate(); ++s) {
+      ans += m_->shared_state_model(s)->logpri();
+    }
+    for (int i = 0; i < m_->number_of_series(); ++i) {
+      ans += m_->series(i)->observation_model()->logpri();
+    }
+    return ans;
+  }
+
+}  // namespace BOOM
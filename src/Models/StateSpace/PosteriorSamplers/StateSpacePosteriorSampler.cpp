@@ -31,7 +31,7 @@ namespace BOOM{
 
   void SSPS::draw(){
     if (!latent_data_initialized_) {
-      m_->impute_state();
+      m_->impute_state(rng());
       latent_data_initialized_ = true;
     }
     impute_nonstate_latent_data();
@@ -39,7 +39,7 @@ namespace BOOM{
     for(int s = 0; s < m_->nstate(); ++s) {
       m_->state_model(s)->sample_posterior();
     }
-    m_->impute_state();
+    m_->impute_state(rng());
     // End with a call to impute_state() so that the internal state of
     // the Kalman filter matches up with the parameter draws.
   }
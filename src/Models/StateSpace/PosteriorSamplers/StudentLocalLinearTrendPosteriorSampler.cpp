@@ -109,7 +109,7 @@ namespace BOOM {
   void StudentLocalLinearTrendPosteriorSampler::draw_nu_level(){
     NuPosterior logpost(nu_level_prior_.get(),
                         &model_->nu_level_complete_data_suf());
-    ScalarSliceSampler sampler(logpost, true);
+    ScalarSliceSampler sampler(logpost, true, 1.0, &rng());
     sampler.set_lower_limit(0.0);
     double nu = sampler.draw(model_->nu_level());
     model_->set_nu_level(nu);
@@ -118,7 +118,7 @@ namespace BOOM {
   void StudentLocalLinearTrendPosteriorSampler::draw_nu_slope(){
     NuPosterior logpost(nu_slope_prior_.get(),
                         &model_->nu_slope_complete_data_suf());
-    ScalarSliceSampler sampler(logpost, true);
+    ScalarSliceSampler sampler(logpost, true, 1.0, &rng());
     sampler.set_lower_limit(0.0);
     double nu = sampler.draw(model_->nu_slope());
     model_->set_nu_slope(nu);
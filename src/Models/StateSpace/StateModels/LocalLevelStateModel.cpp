@@ -20,6 +20,7 @@
 #include <Models/StateSpace/StateModels/LocalLevelStateModel.hpp>
 #include <distributions.hpp>
 #include <cpputil/math_utils.hpp>
+#include <boost/bind.hpp>
 
 namespace BOOM{
 
@@ -33,16 +34,23 @@ namespace BOOM{
         state_variance_matrix_(new ConstantMatrix(1, sigma*sigma)),
         initial_state_mean_(1),
         initial_state_variance_(1)
-  {}
+  {
+    Sigsq_prm()->add_observer(
+        boost::bind(&LocalLevelStateModel::observe_sigsq, this));
+  }
 
   LLSM::LocalLevelStateModel(const LocalLevelStateModel &rhs)
       : Model(rhs),
         StateModel(rhs),
+        ZeroMeanGaussianModel(rhs),
         state_transition_matrix_(rhs.state_transition_matrix_),
         state_variance_matrix_(new ConstantMatrix(1, sigsq())),
         initial_state_mean_(rhs.initial_state_mean_),
         initial_state_variance_(rhs.initial_state_variance_)
-  {}
+  {
+    Sigsq_prm()->add_observer(
+        boost::bind(&LocalLevelStateModel::observe_sigsq, this));
+  }
 
   LocalLevelStateModel * LLSM::clone() const {
     return new LocalLevelStateModel(*this);}
@@ -58,13 +66,13 @@ namespace BOOM{
 
   uint LLSM::state_dimension() const {return 1;}
 
-  void LLSM::simulate_state_error(VectorView eta, int) const {
-    eta[0] = rnorm(0, sigma());
+  void LLSM::simulate_state_error(RNG &rng, VectorView eta, int) const {
+    eta[0] = rnorm_mt(rng, 0, sigma());
   }
 
-  void LLSM::simulate_initial_state(VectorView eta) const {
-    eta[0] = rnorm(initial_state_mean_[0],
-                   sqrt(initial_state_variance_(0,0)));
+  void LLSM::simulate_initial_state(RNG &rng, VectorView eta) const {
+    eta[0] = rnorm_mt(rng, initial_state_mean_[0],
+                      sqrt(initial_state_variance_(0,0)));
   }
 
   Ptr<SparseMatrixBlock> LLSM::state_transition_matrix(int) const {
@@ -114,11 +122,6 @@ namespace BOOM{
     initial_state_variance_(0,0) = v;
   }
 
-  void LLSM::set_sigsq(double sigsq){
-    ZeroMeanGaussianModel::set_sigsq(sigsq);
-    state_variance_matrix_->set_value(sigsq);
-  }
-
   void LLSM::update_complete_data_sufficient_statistics(
       int,
       const ConstVectorView &state_error_mean,
@@ -17,6 +17,7 @@
 */
 #include <Models/StateSpace/StateModels/LocalLinearTrend.hpp>
 #include <distributions.hpp>
+#include <boost/bind.hpp>
 
 namespace BOOM{
   namespace{
@@ -30,9 +31,13 @@ namespace BOOM{
         state_variance_matrix_(new DenseSpd(ZeroMeanMvnModel::Sigma())),
         state_error_expander_(new IdentityMatrix(2)),
         initial_state_mean_(2, 0.0),
-        initial_state_variance_(2)
+        initial_state_variance_(2),
+        state_error_(2)
   {
     observation_matrix_[0] = 1;
+    Sigma_prm()->add_observer(
+        boost::bind(&LLTSM::observe_Sigma, this));
+    observe_Sigma();
   }
 
   LLTSM::LocalLinearTrendStateModel(const LLTSM &rhs)
@@ -43,8 +48,13 @@ namespace BOOM{
         state_variance_matrix_(rhs.state_variance_matrix_->clone()),
         state_error_expander_(rhs.state_error_expander_->clone()),
         initial_state_mean_(rhs.initial_state_mean_),
-        initial_state_variance_(rhs.initial_state_variance_)
-  {}
+        initial_state_variance_(rhs.initial_state_variance_),
+        state_error_cholesky_(rhs.state_error_cholesky_),
+        state_error_(2)
+  {
+    Sigma_prm()->add_observer(
+        boost::bind(&LLTSM::observe_Sigma, this));
+  }
 
   LLTSM * LLTSM::clone()const{return new LLTSM(*this);}
 
@@ -54,11 +64,19 @@ namespace BOOM{
     check_dim(then);
     check_dim(now);
 
-    Vector mu(2);
-    state_transition_matrix_->multiply(VectorView(mu), then);
-    Vector err = now - mu;
+    // state_error_ = now - T * then.
+    state_transition_matrix_->multiply(VectorView(state_error_), then);
+    state_error_ *= -1;
+    state_error_ += now;
+
+    suf()->update_raw(state_error_);
+  }
 
-    suf()->update_raw(err);
+  void LLTSM::observe_Sigma(){
+    state_variance_matrix_->set_matrix(Sigma());
+    bool ok = true;
+    state_error_cholesky_ = Sigma().chol(ok);
+    if (!ok) state_error_cholesky_ = Matrix();
   }
 
   void LLTSM::check_dim(const ConstVectorView &v)const{
@@ -72,8 +90,12 @@ namespace BOOM{
     }
   }
 
-  void LLTSM::simulate_state_error(VectorView eta, int t)const{
-    eta = ZeroMeanMvnModel::sim();
+  void LLTSM::simulate_state_error(RNG &rng, VectorView eta, int t)const{
+    if (state_error_cholesky_.nrow() == 2) {
+      rmvn_L_mt(rng, state_error_cholesky_, eta);
+    } else {
+      eta = rmvn_robust_mt(rng, mu(), Sigma());
+    }
   }
 
   Ptr<SparseMatrixBlock> LLTSM::state_transition_matrix(int t)const{
@@ -98,11 +120,6 @@ namespace BOOM{
   void LLTSM::set_initial_state_variance(const SpdMatrix &Sigma){
     initial_state_variance_ = Sigma; }
 
-  void LLTSM::set_Sigma(const SpdMatrix &Sigma){
-    ZeroMeanMvnModel::set_Sigma(Sigma);
-    state_variance_matrix_->set_matrix(Sigma);
-  }
-
   void LLTSM::update_complete_data_sufficient_statistics(
       int t,
       const ConstVectorView &state_error_mean,
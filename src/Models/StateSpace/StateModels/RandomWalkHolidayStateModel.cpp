@@ -21,6 +21,7 @@
 #include <distributions.hpp>
 #include <cpputil/report_error.hpp>
 #include <cpputil/math_utils.hpp>
+#include <boost/bind.hpp>
 
 namespace BOOM {
   typedef RandomWalkHolidayStateModel RWHSM;
@@ -37,6 +38,27 @@ namespace BOOM {
       NEW(SingleSparseDiagonalElementMatrix, variance_matrix)(dim, 1.0, i);
       active_state_variance_matrix_.push_back(variance_matrix);
     }
+    Sigsq_prm()->add_observer(
+        boost::bind(&RandomWalkHolidayStateModel::observe_sigsq, this));
+  }
+
+  RWHSM::RandomWalkHolidayStateModel(const RandomWalkHolidayStateModel &rhs)
+      : Model(rhs),
+        StateModel(rhs),
+        ZeroMeanGaussianModel(rhs),
+        holiday_(rhs.holiday_),
+        time_zero_(rhs.time_zero_),
+        initial_state_mean_(rhs.initial_state_mean_),
+        initial_state_variance_(rhs.initial_state_variance_),
+        identity_transition_matrix_(rhs.identity_transition_matrix_),
+        zero_state_variance_matrix_(rhs.zero_state_variance_matrix_)
+  {
+    for(int i = 0; i < rhs.active_state_variance_matrix_.size(); ++i){
+      active_state_variance_matrix_.push_back(
+          rhs.active_state_variance_matrix_[i]->clone());
+    }
+    Sigsq_prm()->add_observer(
+        boost::bind(&RandomWalkHolidayStateModel::observe_sigsq, this));
   }
 
   RandomWalkHolidayStateModel * RWHSM::clone()const{
@@ -58,13 +80,13 @@ namespace BOOM {
     return holiday_->maximum_window_width();
   }
 
-  void RWHSM::simulate_state_error(VectorView eta, int t)const{
+  void RWHSM::simulate_state_error(RNG &rng, VectorView eta, int t)const{
     Date now = time_zero_ + t;
     eta = 0;
     if(holiday_->active(now)){
       Date holiday_date(holiday_->nearest(now));
       int position = now - holiday_->earliest_influence(holiday_date);
-      eta[position] = rnorm(0, sigma());
+      eta[position] = rnorm_mt(rng, 0, sigma());
     }
   }
 
@@ -101,10 +123,9 @@ namespace BOOM {
     return ans;
   }
 
-  void RWHSM::set_sigsq(double sigsq){
-    ZeroMeanGaussianModel::set_sigsq(sigsq);
+  void RWHSM::observe_sigsq(){
     for(int i = 0; i < active_state_variance_matrix_.size(); ++i){
-      active_state_variance_matrix_[i]->set_value(sigsq);
+      active_state_variance_matrix_[i]->set_value(sigsq());
     }
   }
 
@@ -19,6 +19,7 @@
 #include <Models/StateSpace/StateModels/SeasonalStateModel.hpp>
 #include <distributions.hpp>
 #include <cpputil/math_utils.hpp>
+#include <boost/bind.hpp>
 
 namespace BOOM{
 
@@ -50,6 +51,8 @@ namespace BOOM{
       report_error(err.str());
     }
     this->only_keep_sufstats(true);
+    Sigsq_prm()->add_observer(
+        boost::bind(&SeasonalStateModel::observe_sigsq, this));
   }
 
   SSM::SeasonalStateModel(const SeasonalStateModel &rhs)
@@ -71,6 +74,8 @@ namespace BOOM{
         initial_state_variance_(rhs.initial_state_variance_)
   {
     this->only_keep_sufstats(true);
+    Sigsq_prm()->add_observer(
+        boost::bind(&SeasonalStateModel::observe_sigsq, this));
   }
 
   SSM * SSM::clone()const{return new SSM(*this);}
@@ -126,7 +131,8 @@ namespace BOOM{
     return nseasons_ - 1;
   }
 
-  void SSM::simulate_state_error(VectorView state_error, int t)const{
+  void SSM::simulate_state_error(
+      RNG &rng, VectorView state_error, int t)const{
     if(initial_state_mean_.size() != state_dimension()
        || initial_state_variance_.nrow() != state_dimension()){
       ostringstream err;
@@ -143,7 +149,7 @@ namespace BOOM{
     if(new_season(t+1)){
       // If next time period is the start of a new season, then an
       // update is needed.  Otherwise, the state error is zero.
-      state_error[0] = rnorm(0, sigma());
+      state_error[0] = rnorm_mt(rng, 0, sigma());
     }
   }
 
@@ -153,10 +159,9 @@ namespace BOOM{
     return ans;
   }
 
-  void SSM::set_sigsq(double sigsq){
-    ZeroMeanGaussianModel::set_sigsq(sigsq);
-    RQR0_->set_value(sigsq);
-    state_error_variance_at_new_season_->set_value(sigsq);
+  void SSM::observe_sigsq(){
+    RQR0_->set_value(sigsq());
+    state_error_variance_at_new_season_->set_value(sigsq());
   }
 
   void SSM::set_time_of_first_observation(int t){
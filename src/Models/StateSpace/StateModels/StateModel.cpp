@@ -30,7 +30,16 @@ namespace BOOM{
                  "for this StateModel subclass.");
   }
 
+  void StateModel::simulate_state_error(
+      RNG &, VectorView eta, int t) const {
+    simulate_state_error(eta, t);
+  }
+
   void StateModel::simulate_initial_state(VectorView eta)const{
+    simulate_initial_state(GlobalRng::rng, eta);
+  }
+
+  void StateModel::simulate_initial_state(RNG &rng, VectorView eta)const{
     if(eta.size() != state_dimension()){
       std::ostringstream err;
       err << "output vector 'eta' has length " << eta.size()
@@ -38,7 +47,7 @@ namespace BOOM{
           << state_dimension();
       report_error(err.str());
     }
-    eta = rmvn(initial_state_mean(), initial_state_variance());
+    eta = rmvn_mt(rng, initial_state_mean(), initial_state_variance());
   }
 
   void StateModel::observe_initial_state(const ConstVectorView &state){}
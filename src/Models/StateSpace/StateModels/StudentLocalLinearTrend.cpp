@@ -40,7 +40,8 @@ namespace BOOM {
         state_error_expander_(new IdentityMatrix(2)),
         initial_state_mean_(2, 0.0),
         initial_state_variance_(2),
-        behavior_(MIXTURE)
+        behavior_(MIXTURE),
+        rng_(seed_rng(GlobalRng::rng))
   {
     observation_matrix_[0] = 1.0;
     // The latent_slope_scale_factors_ and latent_level_scale_factors_
@@ -71,7 +72,8 @@ namespace BOOM {
             rhs.level_weight_sufficient_statistics_),
         slope_weight_sufficient_statistics_(
             rhs.slope_weight_sufficient_statistics_),
-        behavior_(rhs.behavior_)
+        behavior_(rhs.behavior_),
+        rng_(seed_rng(GlobalRng::rng))
   {}
 
   StudentLocalLinearTrendStateModel *
@@ -111,7 +113,8 @@ namespace BOOM {
     double level_alpha = .5 * (1 + nu_level());
     double level_beta = .5 * (nu_level() +
                               level_residual * level_residual / sigsq_level());
-    latent_level_scale_factors_[time_now - 1] = rgamma(level_alpha, level_beta);
+    latent_level_scale_factors_[time_now - 1] =
+        rgamma_mt(rng_, level_alpha, level_beta);
     level_weight_sufficient_statistics_.update_raw(
         latent_level_scale_factors_[time_now - 1]);
 
@@ -122,7 +125,8 @@ namespace BOOM {
     double slope_alpha = .5 * (1 + nu_slope());
     double slope_beta = .5 * (nu_slope() +
                               slope_residual * slope_residual / sigsq_slope());
-    latent_slope_scale_factors_[time_now - 1] = rgamma(slope_alpha, slope_beta);
+    latent_slope_scale_factors_[time_now - 1] =
+        rgamma_mt(rng_, slope_alpha, slope_beta);
     slope_weight_sufficient_statistics_.update_raw(
         latent_slope_scale_factors_[time_now - 1]);
   }
@@ -136,13 +140,13 @@ namespace BOOM {
   }
 
   void SLLTSM::simulate_state_error(
-      VectorView eta, int t) const {
+      RNG &rng, VectorView eta, int t) const {
     switch (behavior_) {
       case MIXTURE:
-        simulate_conditional_state_error(eta, t);
+        simulate_conditional_state_error(rng, eta, t);
         break;
       case MARGINAL:
-        simulate_marginal_state_error(eta, t);
+        simulate_marginal_state_error(rng, eta, t);
         break;
       default:
         ostringstream err;
@@ -154,17 +158,17 @@ namespace BOOM {
   }
 
   void SLLTSM::simulate_marginal_state_error(
-      VectorView eta, int t) const {
-    eta[0] = rt(nu_level()) * sigma_level();
-    eta[1] = rt(nu_slope()) * sigma_slope();
+      RNG &rng, VectorView eta, int t) const {
+    eta[0] = rt_mt(rng, nu_level()) * sigma_level();
+    eta[1] = rt_mt(rng, nu_slope()) * sigma_slope();
   };
 
   void SLLTSM::simulate_conditional_state_error(
-      VectorView eta, int t) const {
+      RNG &rng, VectorView eta, int t) const {
     double level_weight = latent_level_scale_factors_[t];
     double slope_weight = latent_slope_scale_factors_[t];
-    eta[0] = rnorm(0, sigma_level() / sqrt(level_weight));
-    eta[1] = rnorm(0, sigma_slope() / sqrt(slope_weight));
+    eta[0] = rnorm_mt(rng, 0, sigma_level() / sqrt(level_weight));
+    eta[1] = rnorm_mt(rng, 0, sigma_slope() / sqrt(slope_weight));
   };
 
   Ptr<SparseMatrixBlock> SLLTSM::state_transition_matrix(int t) const {
@@ -28,7 +28,8 @@ namespace BOOM {
         frequencies_(frequencies),
         state_transition_matrix_(new IdentityMatrix(state_dimension())),
         state_variance_matrix_(new DiagonalMatrixBlock(state_dimension())),
-        variance_is_current_(false)
+        variance_is_current_(false),
+        state_error_(2 * frequencies.size())
   {
     if (frequencies_.empty()) {
       report_error("At least one frequency needed to "
@@ -47,7 +48,9 @@ namespace BOOM {
   void TrigStateModel::observe_state(const ConstVectorView then,
                                      const ConstVectorView now,
                                      int time_now) {
-    suf()->update_raw(now - then);
+    state_error_ = now;
+    state_error_ -= then;
+    suf()->update_raw(state_error_);
   }
 
   void TrigStateModel::update_complete_data_sufficient_statistics(
@@ -60,9 +63,12 @@ namespace BOOM {
         state_error_variance.diag() + pow(state_error_mean, 2));
   }
 
-  void TrigStateModel::simulate_state_error(VectorView eta, int t) const {
-    refresh_variance();
-    eta = sim();
+  void TrigStateModel::simulate_state_error(
+      RNG &rng, VectorView eta, int t) const {
+    const Vector &mean(mu());
+    for (int i = 0; i < eta.size(); ++i) {
+      eta[i] = rnorm_mt(rng, mean[i], sigma(i));
+    }
   }
 
   SparseVector TrigStateModel::observation_matrix(int t) const {
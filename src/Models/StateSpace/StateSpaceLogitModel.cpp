@@ -118,7 +118,7 @@ namespace BOOM {
 
   void SSLM::observe_data_given_state(int t) {
     if (!is_missing_observation(t)) {
-      dat()[t]->set_offset(observation_matrix(t).dot(state(t)));
+      dat()[t]->set_offset(cached_observation_matrix(t).dot(state(t)));
       signal_complete_data_change(t);
     }
   }
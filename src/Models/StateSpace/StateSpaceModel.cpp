@@ -87,7 +87,7 @@ namespace BOOM{
   void SSM::observe_data_given_state(int t) {
     // Assuming ignorable missing data.
     if(!is_missing_observation(t)) {
-      double mu = observation_matrix(t).dot(state(t));
+      double mu = cached_observation_matrix(t).dot(state(t));
       double y = adjusted_observation(t) - mu;
       observation_model_->suf()->update_raw(y);
     }
@@ -34,6 +34,7 @@ namespace BOOM{
         state_positions_(1, 0),
         state_is_fixed_(false),
         mcmc_kalman_storage_is_current_(false),
+        observation_matrices_are_current_(false),
         kalman_filter_is_current_(false),
         default_state_transition_matrix_(new BlockDiagonalMatrix),
         default_state_variance_matrix_(new BlockDiagonalMatrix)
@@ -47,6 +48,7 @@ namespace BOOM{
         state_positions_(1, 0),
         state_is_fixed_(rhs.state_is_fixed_),
         mcmc_kalman_storage_is_current_(false),
+        observation_matrices_are_current_(false),
         kalman_filter_is_current_(false),
         default_state_transition_matrix_(new BlockDiagonalMatrix),
         default_state_variance_matrix_(new BlockDiagonalMatrix)
@@ -58,23 +60,21 @@ namespace BOOM{
   }
 
   //----------------------------------------------------------------------
-  void SSMB::impute_state() {
+  void SSMB::impute_state(RNG &rng) {
     set_state_model_behavior(StateModel::MIXTURE);
     if (state_is_fixed_) {
       observe_fixed_state();
     } else {
       resize_state();
       clear_client_data();
-      simulate_forward();
-      Vector r0_sim = smooth_disturbances(kalman_storage_);
-      Vector r0_obs = smooth_disturbances(supplemental_kalman_storage_);
-      propagate_disturbances(r0_sim, r0_obs, true);
+      simulate_forward(rng);
+      smooth_disturbances(kalman_storage_, r0_sim_);
+      smooth_disturbances(supplemental_kalman_storage_, r0_obs_);
+      propagate_disturbances(r0_sim_, r0_obs_, true);
     }
   }
 
   //----------------------------------------------------------------------
-  // Ensure that state_ is large enough to hold the results of
-  // impute_state().
   void SSMB::resize_state() {
     if (nrow(state_) != state_dimension()
        || ncol(state_) != time_dimension()) {
@@ -94,23 +94,29 @@ namespace BOOM{
   // y_+ and alpha_+ will be simulated in parallel with
   // Kalman filtering and disturbance smoothing of y, and the results
   // will be subtracted to compute y_*.
-  void SSMB::simulate_forward() {
+  void SSMB::simulate_forward(RNG &rng) {
     check_kalman_storage(kalman_storage_);
     check_kalman_storage(supplemental_kalman_storage_);
+    update_observation_matrices();
     log_likelihood_ = 0;
+    bool time_invariant = model_matrices_are_time_invariant();
+    steady_state_filter_.reset(time_invariant);
+    supplemental_steady_state_filter_.reset(time_invariant);
     for (int t = 0; t < time_dimension(); ++t) {
       // simulate_state at time t
       if (t == 0) {
-        simulate_initial_state(state_.col(0));
+        simulate_initial_state(rng, state_.col(0));
         a_ = initial_state_mean();
         P_ = initial_state_variance();
         supplemental_a_ = a_;
         supplemental_P_ = P_;
       }else{
-        simulate_next_state(state_.col(t-1), state_.col(t), t);
+        simulate_next_state(rng, state_.col(t-1), state_.col(t), t);
       }
-      double y_sim = simulate_adjusted_observation(t);
-      sparse_scalar_kalman_update(
+      const SparseKalmanMatrix &transition(*state_transition_matrix(t));
+      const SparseKalmanMatrix &variance(*state_variance_matrix(t));
+      double y_sim = simulate_adjusted_observation(rng, t);
+      steady_state_filter_.update(
           y_sim,
           a_,
           P_,
@@ -118,16 +124,17 @@ namespace BOOM{
           kalman_storage_[t].F,
           kalman_storage_[t].v,
           is_missing_observation(t),
-          observation_matrix(t),
+          observation_matrices_[t],
           observation_variance(t),
-          *state_transition_matrix(t),
-          *state_variance_matrix(t));
+          transition,
+          variance,
+          kalman_workspace_);
         ////////////////////////
         // TODO(stevescott): The actual one step ahead prediction
         // errors are being stored in supplemental_kalman_storage_,
         // and not kalman_storage_.  We should eventually keep the
         // prediction errors in the right place.
-      log_likelihood_ += sparse_scalar_kalman_update(
+      log_likelihood_ += supplemental_steady_state_filter_.update(
           adjusted_observation(t),
           supplemental_a_,
           supplemental_P_,
@@ -135,10 +142,11 @@ namespace BOOM{
           supplemental_kalman_storage_[t].F,
           supplemental_kalman_storage_[t].v,
           is_missing_observation(t),
-          observation_matrix(t),
+          observation_matrices_[t],
           observation_variance(t),
-          (*state_transition_matrix(t)),
-          (*state_variance_matrix(t)));
+          transition,
+          variance,
+          kalman_workspace_);
 
       // The Kalman update sets a_ to a[t+1] and P to P[t+1], so they
       // will be current for the next iteration.
@@ -147,9 +155,9 @@ namespace BOOM{
   }
 
   //----------------------------------------------------------------------
-  double SSMB::simulate_adjusted_observation(int t) {
-    double mu = observation_matrix(t).dot(state_.col(t));
-    return rnorm(mu, sqrt(observation_variance(t)));
+  double SSMB::simulate_adjusted_observation(RNG &rng, int t) {
+    double mu = observation_matrices_[t].dot(state_.col(t));
+    return rnorm_mt(rng, mu, sqrt(observation_variance(t)));
   }
 
   //----------------------------------------------------------------------
@@ -158,10 +166,14 @@ namespace BOOM{
   // Koopman (2002).
   // TODO(stevescott): make sure you've got t, t-1, and t+1 worked out
   // correctly.
-  Vector SSMB::smooth_disturbances(
-      std::vector<LightKalmanStorage> &kalman_storage) {
+  void SSMB::smooth_disturbances(
+      std::vector<LightKalmanStorage> &kalman_storage,
+      Vector &r) {
     int n = time_dimension();
-    Vector r(state_dimension(), 0.0);
+    r.resize(state_dimension());
+    r = 0.0;
+    kalman_workspace_.resize(state_dimension());
+    Vector &rt_1(kalman_workspace_.state);
     for (int t = n-1; t>=0; --t) {
       // Upon entry r is r[t].
       // On exit, r is r[t-1] and kalman_storage[t].K is r[t]
@@ -177,41 +189,51 @@ namespace BOOM{
       Vector &K(kalman_storage[t].K);
       double coefficient = (v/F) - K.dot(r);
 
-      // Now produce r[t-1]
-      Vector rt_1 = state_transition_matrix(t)->Tmult(r);
-      observation_matrix(t).add_this_to(rt_1, coefficient);
+      // Now produce r[t-1] in the workspace, and swap it into r.
+      state_transition_matrix(t)->Tmult(VectorView(rt_1), ConstVectorView(r));
+      observation_matrices_[t].add_this_to(rt_1, coefficient);
       K = r;
-      r = rt_1;
+      r.swap(rt_1);
     }
-    return r;
   }
 
   //----------------------------------------------------------------------
   // After a call to smooth_disturbances() puts r[t] in
   // kalman_storage_[t].K, this function propagates the r's forward to
   // get E(alpha | y), and add it to the simulated state.
+  //
+  // The smoothed state means for the simulated and observed data obey
+  // the same linear recursion,
+  //   mean[t] = T[t-1] * mean[t-1] + RQR[t-1] * r[t-1],
+  // so only their difference needs to be propagated.
   void SSMB::propagate_disturbances(
       const Vector &r0_sim, const Vector & r0_obs, bool observe) {
-    // TODO(stevescott): Two linear operations are being performed in
-    // parallel.  Can they be replaced by a single linear operation on
-    // the difference?
     if (state_.ncol() <= 0) return;
-    SpdMatrix P0 = initial_state_variance();
-    Vector state_mean_sim = initial_state_mean() + P0*r0_sim;
-    Vector state_mean_obs = initial_state_mean() + P0*r0_obs;
-
-    state_.col(0) += state_mean_obs - state_mean_sim;
+    kalman_workspace_.resize(state_dimension());
+    Vector &r_difference(kalman_workspace_.state);
+    Vector &variance_term(kalman_workspace_.state2);
+    Vector &mean_difference(state_mean_difference_);
+
+    r_difference = r0_obs;
+    r_difference -= r0_sim;
+    mean_difference = initial_state_variance() * r_difference;
+    state_.col(0) += mean_difference;
     if (observe) {
       observe_state(0);
       observe_data_given_state(0);
     }
     for (int t = 1; t < time_dimension(); ++t) {
-      state_mean_sim = (*state_transition_matrix(t-1)) * state_mean_sim
-          + (*state_variance_matrix(t-1)) * kalman_storage_[t-1].K;
-      state_mean_obs = (*state_transition_matrix(t-1)) * state_mean_obs
-          + (*state_variance_matrix(t-1)) * supplemental_kalman_storage_[t-1].K;
-
-      state_.col(t).axpy(state_mean_obs - state_mean_sim);
+      r_difference = supplemental_kalman_storage_[t-1].K;
+      r_difference -= kalman_storage_[t-1].K;
+      state_variance_matrix(t-1)->multiply(
+          VectorView(variance_term), ConstVectorView(r_difference));
+      // r_difference is no longer needed, so it can hold T * mean.
+      state_transition_matrix(t-1)->multiply(
+          VectorView(r_difference), ConstVectorView(mean_difference));
+      mean_difference.swap(r_difference);
+      mean_difference += variance_term;
+
+      state_.col(t) += mean_difference;
       if (observe) {
         observe_state(t);
         observe_data_given_state(t);
@@ -258,12 +280,14 @@ namespace BOOM{
     }
     log_likelihood_ = 0;
     initialize_final_kalman_storage();
+    update_observation_matrices();
     ScalarKalmanStorage &ks(final_kalman_storage_);
+    steady_state_filter_.reset(model_matrices_are_time_invariant());
 
     for (int i = 0; i < n; ++i) {
       double resid = adjusted_observation(i);
       bool missing = is_missing_observation(i);
-      log_likelihood_ += sparse_scalar_kalman_update(
+      log_likelihood_ += steady_state_filter_.update(
           resid,
           ks.a,
           ks.P,
@@ -271,10 +295,11 @@ namespace BOOM{
           ks.F,
           ks.v,
           missing,
-          observation_matrix(i),
+          observation_matrices_[i],
           observation_variance(i),
           (*state_transition_matrix(i)),
-          (*state_variance_matrix(i)));
+          (*state_variance_matrix(i)),
+          kalman_workspace_);
       errors[i] = ks.v;
     }
     kalman_filter_is_current_ = true;
@@ -300,6 +325,7 @@ namespace BOOM{
     state_positions_.push_back(next_position);
     std::vector<Ptr<Params> > params(m->t());
     for (int i = 0; i < params.size(); ++i) observe(params[i]);
+    observation_matrices_are_current_ = false;
   }
 
   //----------------------------------------------------------------------
@@ -311,6 +337,22 @@ namespace BOOM{
     return ans;
   }
 
+  //----------------------------------------------------------------------
+  void SSMB::update_observation_matrices() const {
+    int n = time_dimension();
+    bool fixed = observation_matrices_are_fixed();
+    if (fixed
+        && observation_matrices_are_current_
+        && observation_matrices_.size() == n) {
+      return;
+    }
+    observation_matrices_.resize(n);
+    for (int t = 0; t < n; ++t) {
+      observation_matrices_[t] = observation_matrix(t);
+    }
+    observation_matrices_are_current_ = fixed;
+  }
+
   //----------------------------------------------------------------------
   // TODO(stevescott): This and other code involving model matrices is
   // an optimization opportunity.  Test it out to see if
@@ -349,6 +391,22 @@ namespace BOOM{
   //----------------------------------------------------------------------
   int SSMB::state_dimension() const {return state_dimension_;}
 
+  //----------------------------------------------------------------------
+  bool SSMB::model_matrices_are_time_invariant() const {
+    for (int s = 0; s < state_models_.size(); ++s) {
+      if (!state_models_[s]->is_time_invariant()) return false;
+    }
+    return true;
+  }
+
+  //----------------------------------------------------------------------
+  bool SSMB::observation_matrices_are_fixed() const {
+    for (int s = 0; s < state_models_.size(); ++s) {
+      if (!state_models_[s]->observation_matrix_is_fixed()) return false;
+    }
+    return true;
+  }
+
   //----------------------------------------------------------------------
   double SSMB::log_likelihood() const {
     filter();
@@ -362,12 +420,14 @@ namespace BOOM{
     initialize_final_kalman_storage();
     int n = time_dimension();
     if (n == 0) return final_kalman_storage_;
+    update_observation_matrices();
     ScalarKalmanStorage &ks(final_kalman_storage_);
+    steady_state_filter_.reset(model_matrices_are_time_invariant());
 
     for (int i = 0; i < n; ++i) {
       double resid = adjusted_observation(i);
       bool missing = is_missing_observation(i);
-      log_likelihood_ += sparse_scalar_kalman_update(
+      log_likelihood_ += steady_state_filter_.update(
           resid,
           ks.a,
           ks.P,
@@ -375,10 +435,11 @@ namespace BOOM{
           ks.F,
           ks.v,
           missing,
-          observation_matrix(i),
+          observation_matrices_[i],
           observation_variance(i),
           (*state_transition_matrix(i)),
-          (*state_variance_matrix(i)));
+          (*state_variance_matrix(i)),
+          kalman_workspace_);
     }
     kalman_filter_is_current_ = true;
     return final_kalman_storage_;
@@ -387,25 +448,30 @@ namespace BOOM{
   //----------------------------------------------------------------------
   Vector SSMB::simulate_initial_state() const {
     Vector ans(state_dimension_);
-    simulate_initial_state(VectorView(ans));
+    simulate_initial_state(GlobalRng::rng, VectorView(ans));
     return ans;
   }
 
   //----------------------------------------------------------------------
   // TODO(stevescott):  test
-  void SSMB::simulate_initial_state(VectorView state0) const {
+  void SSMB::simulate_initial_state(RNG &rng, VectorView state0) const {
     for (int s = 0; s < state_models_.size(); ++s) {
-      state_model(s)->simulate_initial_state(state_component(state0, s));
+      state_model(s)->simulate_initial_state(
+          rng, state_component(state0, s));
     }
   }
 
   //----------------------------------------------------------------------
   // Simulates state for time period t
-  void SSMB::simulate_next_state(ConstVectorView last,
+  void SSMB::simulate_next_state(RNG &rng,
+                                 ConstVectorView last,
                                  VectorView next,
                                  int t) const {
-    next= (*state_transition_matrix(t-1)) * last;
-    next += simulate_state_error(t-1);
+    state_transition_matrix(t-1)->multiply(next, last);
+    state_error_workspace_.resize(next.size());
+    state_error_workspace_ = 0.0;
+    simulate_state_error(rng, VectorView(state_error_workspace_), t-1);
+    next += state_error_workspace_;
   }
 
   //----------------------------------------------------------------------
@@ -420,14 +486,19 @@ namespace BOOM{
 
   //----------------------------------------------------------------------
   Vector SSMB::simulate_state_error(int t) const {
+    Vector ans(state_dimension(), 0);
+    simulate_state_error(VectorView(ans), t);
+    return ans;
+  }
+
+  //----------------------------------------------------------------------
+  void SSMB::simulate_state_error(RNG &rng, VectorView ans, int t) const {
     // simulate N(0, RQR) for the state at time t+1, using the
     // variance matrix at time t.
-    Vector ans(state_dimension_, 0);
     for (int s = 0; s < state_models_.size(); ++s) {
       VectorView eta(state_component(ans, s));
-      state_model(s)->simulate_state_error(eta, t);
+      state_model(s)->simulate_state_error(rng, eta, t);
     }
-    return ans;
   }
   //----------------------------------------------------------------------
   Vector SSMB::initial_state_mean() const {
@@ -558,6 +629,7 @@ namespace BOOM{
   //----------------------------------------------------------------------
   void SSMB::observe_fixed_state() {
     clear_client_data();
+    update_observation_matrices();
     for (int t = 0; t < time_dimension(); ++t) {
       observe_state(t);
       observe_data_given_state(t);
@@ -0,0 +1,203 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include <Models/StateSpace/StateSpacePanel.hpp>
+#include <typeinfo>
+#include <cpputil/report_error.hpp>
+
+namespace BOOM {
+
+  typedef StateSpacePanel SSP;
+
+  SSP::StateSpacePanel() {}
+
+  SSP::StateSpacePanel(const SSP &rhs)
+      : Model(rhs),
+        CompositeParamPolicy(rhs),
+        NullDataPolicy(rhs),
+        PriorPolicy(rhs)
+  {
+    for (int s = 0; s < rhs.nstate(); ++s) {
+      add_shared_state(rhs.shared_state_model(s)->clone());
+    }
+    for (int i = 0; i < rhs.number_of_series(); ++i) {
+      add_series(rhs.series(i)->clone());
+    }
+  }
+
+  SSP * SSP::clone() const {return new SSP(*this);}
+
+  //----------------------------------------------------------------------
+  void SSP::add_shared_state(Ptr<StateModel> state_model) {
+    if (!series_.empty()) {
+      report_error("All shared state models must be added to a "
+                   "StateSpacePanel before any series is added.");
+    }
+    shared_state_models_.push_back(state_model);
+    ParamPolicy::add_model(state_model);
+  }
+
+  //----------------------------------------------------------------------
+  void SSP::add_series(Ptr<StateSpaceModelBase> series) {
+    check_series(series);
+    series_.push_back(series);
+    for (int s = 0; s < nstate(); ++s) {
+      series->state_model(s)->unvectorize_params(
+          shared_state_models_[s]->vectorize_params());
+    }
+  }
+
+  //----------------------------------------------------------------------
+  void SSP::check_series(const Ptr<StateSpaceModelBase> &series) const {
+    if (!series) {
+      report_error("A StateSpacePanel series may not be NULL.");
+    }
+    if (series->nstate() != nstate()) {
+      std::ostringstream err;
+      err << "A series added to a StateSpacePanel has " << series->nstate()
+          << " state models, but the panel has " << nstate()
+          << " shared state models.";
+      report_error(err.str());
+    }
+    for (int s = 0; s < nstate(); ++s) {
+      const StateModel &shared(*shared_state_models_[s]);
+      const StateModel &own(*series->state_model(s));
+      if (typeid(shared) != typeid(own)
+          || shared.state_dimension() != own.state_dimension()
+          || shared.vectorize_params().size()
+             != own.vectorize_params().size()) {
+        std::ostringstream err;
+        err << "State model " << s << " of a series added to a "
+            << "StateSpacePanel does not match shared state model " << s
+            << ".";
+        report_error(err.str());
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------
+  void SSP::set_nthreads(int n, RNG &seeding_rng) {
+    if (n < 0) {
+      report_error("Number of threads must be non-negative.");
+    }
+    worker_rngs_.clear();
+    for (int i = 0; i < n; ++i) {
+      worker_rngs_.push_back(split_rng(seeding_rng));
+    }
+    pool_.set_number_of_threads(n);
+  }
+
+  //----------------------------------------------------------------------
+  void SSP::distribute_shared_parameters() {
+    for (int s = 0; s < nstate(); ++s) {
+      Vector params = shared_state_models_[s]->vectorize_params();
+      for (int i = 0; i < series_.size(); ++i) {
+        series_[i]->state_model(s)->unvectorize_params(params);
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------
+  void SSP::for_each_series(const std::function<void(int, int)> &f) const {
+    int nworkers = nthreads();
+    int nseries = series_.size();
+    if (nworkers <= 1) {
+      for (int i = 0; i < nseries; ++i) f(i, 0);
+      return;
+    }
+    std::vector<std::function<void()> > tasks;
+    tasks.reserve(nworkers);
+    for (int w = 0; w < nworkers; ++w) {
+      tasks.push_back([&f, w, nworkers, nseries]() {
+          for (int i = w; i < nseries; i += nworkers) f(i, w);
+        });
+    }
+    try {
+      pool_.run(tasks);
+    } catch (const std::exception &e) {
+      report_error(e.what());
+    } catch (...) {
+      report_error("StateSpacePanel caught unknown exception from a "
+                   "worker thread.");
+    }
+  }
+
+  //----------------------------------------------------------------------
+  void SSP::impute_state(RNG &rng) {
+    distribute_shared_parameters();
+    if (nthreads() <= 1) {
+      for (int i = 0; i < series_.size(); ++i) {
+        series_[i]->impute_state(rng);
+      }
+    } else {
+      for_each_series([this](int i, int worker) {
+          series_[i]->impute_state(worker_rngs_[worker]);
+        });
+    }
+    observe_shared_state();
+  }
+
+  //----------------------------------------------------------------------
+  // The shared models see the imputed state of each series in turn.
+  // This is cheap compared to the simulation smoother, and it works
+  // with any state model, because it relies on the same observe_state
+  // calls a single series makes for itself.
+  void SSP::observe_shared_state() {
+    int max_time = 0;
+    for (int i = 0; i < series_.size(); ++i) {
+      max_time = std::max(max_time, series_[i]->time_dimension());
+    }
+    for (int s = 0; s < nstate(); ++s) {
+      StateModel &shared(*shared_state_models_[s]);
+      shared.clear_data();
+      shared.observe_time_dimension(max_time);
+      for (int i = 0; i < series_.size(); ++i) {
+        const StateSpaceModelBase &model(*series_[i]);
+        int n = model.time_dimension();
+        if (n <= 0) continue;
+        const Matrix &state(model.state());
+        ConstVectorView then(model.state_component(state.col(0), s));
+        shared.observe_initial_state(then);
+        for (int t = 1; t < n; ++t) {
+          ConstVectorView now(model.state_component(state.col(t), s));
+          shared.observe_state(then, now, t);
+          then = now;
+        }
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------
+  void SSP::sample_observation_posteriors() {
+    for_each_series([this](int i, int) {
+        series_[i]->observation_model()->sample_posterior();
+      });
+  }
+
+  //----------------------------------------------------------------------
+  double SSP::log_likelihood() const {
+    std::vector<double> loglike(series_.size());
+    for_each_series([this, &loglike](int i, int) {
+        loglike[i] = series_[i]->log_likelihood();
+      });
+    double ans = 0;
+    for (int i = 0; i < loglike.size(); ++i) ans += loglike[i];
+    return ans;
+  }
+
+}  // namespace BOOM
@@ -116,7 +116,7 @@ namespace BOOM {
 
   void SSPM::observe_data_given_state(int t) {
     if (!is_missing_observation(t)) {
-      double offset = observation_matrix(t).dot(state(t));
+      double offset = cached_observation_matrix(t).dot(state(t));
       dat()[t]->set_offset(offset);
       signal_complete_data_change(t);
     }
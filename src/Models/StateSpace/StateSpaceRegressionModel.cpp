@@ -107,7 +107,7 @@ namespace BOOM{
   void SSRM::observe_data_given_state(int t) {
     if (!is_missing_observation(t)) {
       Ptr<RegressionData> dp(dat()[t]);
-      double state_mean = observation_matrix(t).dot(state(t));
+      double state_mean = cached_observation_matrix(t).dot(state(t));
       regression_->suf()->add_mixture_data(
           dp->y() - state_mean, dp->x(), 1.0);
     }
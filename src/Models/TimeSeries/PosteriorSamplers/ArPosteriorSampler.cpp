@@ -59,11 +59,15 @@ namespace BOOM{
   void ArPosteriorSampler::draw_phi(){
     const SpdMatrix &xtx(model_->suf()->xtx());
     const Vector &xty(model_->suf()->xty());
-    Vector phi_hat = xtx.solve(xty);
+    // Factor xtx once, and reuse the decomposition for the mean and
+    // for each proposal.
+    Chol xtx_chol(xtx);
+    Vector phi_hat = xtx_chol.solve(xty);
+    Chol ivar_chol = xtx_chol * (1.0 / sqrt(model_->sigsq()));
     bool ok = false;
     int attempts = 0;
     while (!ok && ++attempts <= max_number_of_regression_proposals_) {
-      Vector phi = rmvn_ivar(phi_hat, xtx / model_->sigsq());
+      Vector phi = rmvn_ivar_mt(rng(), phi_hat, ivar_chol);
       ok = ArModel::check_stationary(phi);
       if(ok) model_->set_phi(phi);
     }
@@ -23,8 +23,7 @@ namespace BOOM {
   void intrusive_ptr_add_ref(DirectProposal *d) {d->up_count();}
 
   void intrusive_ptr_release(DirectProposal *d) {
-    d->down_count();
-    if (d->ref_count() == 0) {
+    if (d->down_count() == 0) {
       delete d;
     }
   }
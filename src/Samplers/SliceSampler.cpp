@@ -24,8 +24,9 @@
 #include <stdexcept>
 
 namespace BOOM {
-  SliceSampler::SliceSampler(Func F, bool Unimodal)
-      : unimodal_(Unimodal),
+  SliceSampler::SliceSampler(Func F, bool Unimodal, RNG *rng)
+      : Sampler(rng),
+        unimodal_(Unimodal),
         logp_(F)
   {
     hi_ = lo_ = scale_ = 1.0;
@@ -69,7 +70,7 @@ namespace BOOM {
   void SliceSampler::set_random_direction() {
     random_direction_.resize(last_position_.size());
     for(uint i = 0; i < random_direction_.size(); ++i) {
-      random_direction_[i] = scale_ * rnorm();
+      random_direction_[i] = scale_ * rnorm_mt(rng());
     }
   }
 
@@ -135,7 +136,7 @@ namespace BOOM {
     last_position_ = theta;
     initialize();
 
-    log_p_slice_ = logp_(last_position_) - rexp(1);
+    log_p_slice_ = logp_(last_position_) - rexp_mt(rng(), 1);
     find_limits();
     Vector candidate;
     double logp_candidate = log_p_slice_ -1;
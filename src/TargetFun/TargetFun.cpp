@@ -28,8 +28,7 @@ namespace BOOM {
   void intrusive_ptr_add_ref(TargetFun *s){
     s->up_count();}
   void intrusive_ptr_release(TargetFun *s){
-    s->down_count();
-    if(s->ref_count()==0) delete s; }
+    if(s->down_count() == 0) delete s; }
 
   double d2TargetFun::operator()(const Vector &x) const {
     Vector g;
@@ -48,8 +47,7 @@ namespace BOOM {
   void intrusive_ptr_add_ref(ScalarTargetFun *s){
     s->up_count();}
   void intrusive_ptr_release(ScalarTargetFun *s){
-    s->down_count();
-    if(s->ref_count()==0) delete s; }
+    if(s->down_count() == 0) delete s; }
   //----------------------------------------------------------------------
 
   d2TargetFunPointerAdapter::d2TargetFunPointerAdapter(
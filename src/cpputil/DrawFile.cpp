@@ -0,0 +1,429 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include <cpputil/DrawFile.hpp>
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <cpputil/report_error.hpp>
+
+namespace BOOM {
+
+  namespace DrawFileIO {
+
+    namespace {
+      const char kMagic[8] = {'B', 'O', 'O', 'M', 'D', 'R', 'A', 'W'};
+      const std::int32_t kVersion = 1;
+
+      // The draw count lives at a fixed position, after the magic
+      // number and four 32-bit fields, so it can be updated in place.
+      const std::int64_t kNumberOfDrawsOffset = 8 + 4 * 4;
+
+      // The body starts on a multiple of this many bytes.
+      const std::int64_t kAlignment = 64;
+
+      template <class T>
+      void write_value(std::ostream &out, T value) {
+        out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+      }
+
+      template <class T>
+      T read_value(std::istream &in) {
+        T value;
+        in.read(reinterpret_cast<char *>(&value), sizeof(T));
+        if (!in) {
+          report_error("Unexpected end of file while reading the header "
+                       "of a draw file.");
+        }
+        return value;
+      }
+    }  // namespace
+
+    Layout::Layout()
+        : value_type_(DOUBLE_VALUES),
+          iterations_per_chunk_(1),
+          thin_(1),
+          number_of_draws_(0),
+          values_before_(1, 0),
+          header_size_(0)
+    {}
+
+    Layout::Layout(ValueType value_type, int iterations_per_chunk, int thin)
+        : value_type_(value_type),
+          iterations_per_chunk_(iterations_per_chunk),
+          thin_(thin),
+          number_of_draws_(0),
+          values_before_(1, 0),
+          header_size_(0)
+    {
+      if (iterations_per_chunk_ < 1) {
+        report_error("iterations_per_chunk must be positive.");
+      }
+      if (thin_ < 1) {
+        report_error("thin must be positive.");
+      }
+    }
+
+    //----------------------------------------------------------------------
+    void Layout::add_parameter(const std::string &name, int dimension) {
+      if (parameter_index(name) >= 0) {
+        report_error("A parameter named '" + name
+                     + "' has already been added to the draw file.");
+      }
+      names_.push_back(name);
+      dimensions_.push_back(dimension);
+      values_before_.push_back(values_before_.back() + dimension);
+    }
+
+    //----------------------------------------------------------------------
+    int Layout::value_size() const {
+      return value_type_ == FLOAT_VALUES ? sizeof(float) : sizeof(double);
+    }
+
+    //----------------------------------------------------------------------
+    int Layout::parameter_index(const std::string &name) const {
+      for (int i = 0; i < names_.size(); ++i) {
+        if (names_[i] == name) return i;
+      }
+      return -1;
+    }
+
+    //----------------------------------------------------------------------
+    void Layout::write(std::ostream &out) {
+      std::ostringstream header;
+      header.write(kMagic, sizeof(kMagic));
+      write_value<std::int32_t>(header, kVersion);
+      write_value<std::int32_t>(header, value_type_);
+      write_value<std::int32_t>(header, iterations_per_chunk_);
+      write_value<std::int32_t>(header, thin_);
+      write_value<std::int64_t>(header, number_of_draws_);
+      // Placeholder for the header size, which is filled in below.
+      write_value<std::int64_t>(header, 0);
+      write_value<std::int32_t>(header, names_.size());
+      for (int i = 0; i < names_.size(); ++i) {
+        write_value<std::int32_t>(header, dimensions_[i]);
+        write_value<std::int32_t>(header, names_[i].size());
+        header.write(names_[i].data(), names_[i].size());
+      }
+      std::string bytes = header.str();
+      std::int64_t size =
+          (bytes.size() + kAlignment - 1) / kAlignment * kAlignment;
+      bytes.resize(size, '\0');
+      std::memcpy(&bytes[kNumberOfDrawsOffset + sizeof(std::int64_t)],
+                  &size, sizeof(size));
+      header_size_ = size;
+      out.write(bytes.data(), bytes.size());
+    }
+
+    //----------------------------------------------------------------------
+    void Layout::write_number_of_draws(std::ostream &out) const {
+      out.seekp(kNumberOfDrawsOffset);
+      write_value<std::int64_t>(out, number_of_draws_);
+    }
+
+    //----------------------------------------------------------------------
+    void Layout::read(std::istream &in) {
+      char magic[sizeof(kMagic)];
+      in.read(magic, sizeof(magic));
+      if (!in || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+        report_error("The input is not a BOOM draw file.");
+      }
+      std::int32_t version = read_value<std::int32_t>(in);
+      if (version != kVersion) {
+        std::ostringstream err;
+        err << "Unsupported draw file version " << version << ".";
+        report_error(err.str());
+      }
+      std::int32_t value_type = read_value<std::int32_t>(in);
+      if (value_type != DOUBLE_VALUES && value_type != FLOAT_VALUES) {
+        report_error("Unrecognized value type in draw file header.");
+      }
+      value_type_ = static_cast<ValueType>(value_type);
+      iterations_per_chunk_ = read_value<std::int32_t>(in);
+      thin_ = read_value<std::int32_t>(in);
+      number_of_draws_ = read_value<std::int64_t>(in);
+      std::int64_t header_size = read_value<std::int64_t>(in);
+      std::int32_t number_of_parameters = read_value<std::int32_t>(in);
+      names_.clear();
+      dimensions_.clear();
+      values_before_.assign(1, 0);
+      for (int i = 0; i < number_of_parameters; ++i) {
+        std::int32_t dimension = read_value<std::int32_t>(in);
+        std::int32_t name_length = read_value<std::int32_t>(in);
+        std::string name(name_length, '\0');
+        in.read(&name[0], name_length);
+        add_parameter(name, dimension);
+      }
+      if (!in || iterations_per_chunk_ < 1) {
+        report_error("Corrupt draw file header.");
+      }
+      header_size_ = header_size;
+    }
+
+    //----------------------------------------------------------------------
+    std::int64_t Layout::chunk_offset(std::int64_t chunk) const {
+      return header_size_ + chunk * iterations_per_chunk_
+          * values_before_.back() * value_size();
+    }
+
+    //----------------------------------------------------------------------
+    int Layout::chunk_size(std::int64_t chunk) const {
+      std::int64_t remaining = number_of_draws_ - chunk * iterations_per_chunk_;
+      return std::max<std::int64_t>(
+          0, std::min<std::int64_t>(iterations_per_chunk_, remaining));
+    }
+
+    //----------------------------------------------------------------------
+    std::int64_t Layout::block_offset(std::int64_t chunk, int parameter,
+                                      int draws_in_chunk) const {
+      return chunk_offset(chunk)
+          + draws_in_chunk * values_before_[parameter] * value_size();
+    }
+
+    //----------------------------------------------------------------------
+    std::int64_t Layout::value_offset(std::int64_t iteration,
+                                      int parameter) const {
+      std::int64_t chunk = iteration / iterations_per_chunk_;
+      std::int64_t position = iteration - chunk * iterations_per_chunk_;
+      return block_offset(chunk, parameter, chunk_size(chunk))
+          + position * dimensions_[parameter] * value_size();
+    }
+
+  }  // namespace DrawFileIO
+
+  //======================================================================
+  DrawFileWriter::DrawFileWriter(const std::string &filename,
+                                 int iterations_per_chunk,
+                                 int thin,
+                                 DrawFileIO::ValueType value_type)
+      : filename_(filename),
+        layout_(value_type, iterations_per_chunk, thin),
+        buffered_draws_(0),
+        calls_since_last_draw_(0),
+        started_(false),
+        closed_(false)
+  {}
+
+  DrawFileWriter::~DrawFileWriter() {
+    try {
+      close();
+    } catch (...) {
+      // Destructors must not throw.
+    }
+  }
+
+  //----------------------------------------------------------------------
+  void DrawFileWriter::add_parameter(const Ptr<Params> &parameter,
+                                     const std::string &name) {
+    if (started_) {
+      report_error("Parameters cannot be added to a DrawFileWriter "
+                   "after writing has started.");
+    }
+    layout_.add_parameter(name, parameter->size(false));
+    parameters_.push_back(parameter);
+  }
+
+  //----------------------------------------------------------------------
+  void DrawFileWriter::start_writing() {
+    output_.open(filename_.c_str(),
+                 std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!output_) {
+      report_error("Could not open draw file '" + filename_
+                   + "' for writing.");
+    }
+    layout_.write(output_);
+    buffers_.resize(parameters_.size());
+    for (int i = 0; i < parameters_.size(); ++i) {
+      buffers_[i].resize(static_cast<std::size_t>(
+          layout_.iterations_per_chunk()) * layout_.dimension(i));
+    }
+    started_ = true;
+  }
+
+  //----------------------------------------------------------------------
+  void DrawFileWriter::write() {
+    if (closed_) {
+      report_error("write() called on a closed DrawFileWriter.");
+    }
+    if (!started_) start_writing();
+    if (++calls_since_last_draw_ < layout_.thin()) return;
+    calls_since_last_draw_ = 0;
+
+    for (int i = 0; i < parameters_.size(); ++i) {
+      Vector values = parameters_[i]->vectorize(false);
+      const int dimension = layout_.dimension(i);
+      if (values.size() != dimension) {
+        std::ostringstream err;
+        err << "Parameter '" << layout_.name(i) << "' had dimension "
+            << dimension << " when it was added to the draw file, but "
+            << "now has dimension " << values.size() << ".";
+        report_error(err.str());
+      }
+      std::copy(values.begin(), values.end(),
+                buffers_[i].begin() + buffered_draws_ * dimension);
+    }
+    ++buffered_draws_;
+    layout_.set_number_of_draws(layout_.number_of_draws() + 1);
+    if (buffered_draws_ == layout_.iterations_per_chunk()) {
+      write_buffer();
+      buffered_draws_ = 0;
+    }
+  }
+
+  //----------------------------------------------------------------------
+  // Writes the buffered draws at the start of the current chunk, which
+  // begins on a chunk boundary.
+  void DrawFileWriter::write_buffer() {
+    const std::int64_t chunk =
+        (layout_.number_of_draws() - buffered_draws_)
+        / layout_.iterations_per_chunk();
+    output_.seekp(layout_.chunk_offset(chunk));
+    for (int i = 0; i < parameters_.size(); ++i) {
+      const std::size_t number_of_values =
+          static_cast<std::size_t>(buffered_draws_) * layout_.dimension(i);
+      if (layout_.value_type() == DrawFileIO::FLOAT_VALUES) {
+        float_workspace_.resize(number_of_values);
+        std::copy(buffers_[i].begin(),
+                  buffers_[i].begin() + number_of_values,
+                  float_workspace_.begin());
+        output_.write(reinterpret_cast<const char *>(float_workspace_.data()),
+                      number_of_values * sizeof(float));
+      } else {
+        output_.write(reinterpret_cast<const char *>(buffers_[i].data()),
+                      number_of_values * sizeof(double));
+      }
+    }
+    layout_.write_number_of_draws(output_);
+    if (!output_) {
+      report_error("Error writing to draw file '" + filename_ + "'.");
+    }
+  }
+
+  //----------------------------------------------------------------------
+  void DrawFileWriter::flush() {
+    if (!started_ || closed_) return;
+    if (buffered_draws_ > 0) {
+      write_buffer();
+    } else {
+      layout_.write_number_of_draws(output_);
+    }
+    output_.flush();
+  }
+
+  //----------------------------------------------------------------------
+  void DrawFileWriter::close() {
+    if (closed_) return;
+    // An empty file still gets a header, so that it can be read.
+    if (!started_) start_writing();
+    flush();
+    output_.close();
+    closed_ = true;
+  }
+
+  //======================================================================
+  DrawFileReader::DrawFileReader(const std::string &filename)
+      : input_(filename.c_str(), std::ios::in | std::ios::binary),
+        current_chunk_(-1),
+        next_iteration_(0)
+  {
+    if (!input_) {
+      report_error("Could not open draw file '" + filename + "'.");
+    }
+    layout_.read(input_);
+  }
+
+  //----------------------------------------------------------------------
+  void DrawFileReader::add_parameter(const Ptr<Params> &parameter,
+                                     const std::string &name) {
+    int position = layout_.parameter_index(name);
+    if (position < 0) {
+      report_error("The draw file has no parameter named '" + name + "'.");
+    }
+    if (parameter->size(false) != layout_.dimension(position)) {
+      std::ostringstream err;
+      err << "Parameter '" << name << "' has dimension "
+          << layout_.dimension(position) << " in the draw file, but "
+          << parameter->size(false) << " in the model.";
+      report_error(err.str());
+    }
+    parameters_.push_back(parameter);
+    file_positions_.push_back(position);
+    buffers_.push_back(std::vector<double>());
+    current_chunk_ = -1;
+  }
+
+  //----------------------------------------------------------------------
+  void DrawFileReader::rewind() {
+    next_iteration_ = 0;
+  }
+
+  //----------------------------------------------------------------------
+  void DrawFileReader::stream() {
+    seek(next_iteration_);
+  }
+
+  //----------------------------------------------------------------------
+  void DrawFileReader::seek(std::int64_t iteration) {
+    if (iteration < 0 || iteration >= layout_.number_of_draws()) {
+      std::ostringstream err;
+      err << "Draw " << iteration << " was requested, but the draw file "
+          << "contains " << layout_.number_of_draws() << " draws.";
+      report_error(err.str());
+    }
+    const std::int64_t chunk = iteration / layout_.iterations_per_chunk();
+    if (chunk != current_chunk_) read_chunk(chunk);
+    const int position = iteration - chunk * layout_.iterations_per_chunk();
+    for (int i = 0; i < parameters_.size(); ++i) {
+      const int dimension = layout_.dimension(file_positions_[i]);
+      workspace_.resize(dimension);
+      const double *values = buffers_[i].data() + position * dimension;
+      std::copy(values, values + dimension, workspace_.begin());
+      parameters_[i]->unvectorize(workspace_, false);
+    }
+    next_iteration_ = iteration + 1;
+  }
+
+  //----------------------------------------------------------------------
+  void DrawFileReader::read_chunk(std::int64_t chunk) {
+    const int draws_in_chunk = layout_.chunk_size(chunk);
+    for (int i = 0; i < parameters_.size(); ++i) {
+      const int parameter = file_positions_[i];
+      const std::size_t number_of_values =
+          static_cast<std::size_t>(draws_in_chunk)
+          * layout_.dimension(parameter);
+      buffers_[i].resize(number_of_values);
+      input_.clear();
+      input_.seekg(layout_.block_offset(chunk, parameter, draws_in_chunk));
+      if (layout_.value_type() == DrawFileIO::FLOAT_VALUES) {
+        float_workspace_.resize(number_of_values);
+        input_.read(reinterpret_cast<char *>(float_workspace_.data()),
+                    number_of_values * sizeof(float));
+        std::copy(float_workspace_.begin(), float_workspace_.end(),
+                  buffers_[i].begin());
+      } else {
+        input_.read(reinterpret_cast<char *>(buffers_[i].data()),
+                    number_of_values * sizeof(double));
+      }
+      if (!input_) {
+        report_error("Unexpected end of file while reading draws.");
+      }
+    }
+    current_chunk_ = chunk;
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,207 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include <cpputil/MappedDrawFile.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <cpputil/report_error.hpp>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace BOOM {
+
+  MappedDrawFile::MappedDrawFile(const std::string &filename)
+      : data_(nullptr),
+        size_(0)
+  {
+    {
+      std::ifstream header(filename.c_str(), std::ios::in | std::ios::binary);
+      if (!header) {
+        report_error("Could not open draw file '" + filename + "'.");
+      }
+      layout_.read(header);
+    }
+    // Each draw occupies the same number of bytes, whatever chunk it
+    // is in.
+    const std::int64_t bytes_per_draw =
+        (layout_.chunk_offset(1) - layout_.chunk_offset(0))
+        / layout_.iterations_per_chunk();
+    const std::size_t required = layout_.chunk_offset(0)
+        + layout_.number_of_draws() * bytes_per_draw;
+
+#ifndef _WIN32
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+      report_error("Could not open draw file '" + filename + "'.");
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0) {
+      close(fd);
+      report_error("Could not determine the size of draw file '"
+                   + filename + "'.");
+    }
+    size_ = status.st_size;
+    if (size_ > 0) {
+      void *address = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+      if (address == MAP_FAILED) {
+        close(fd);
+        report_error("Could not map draw file '" + filename
+                     + "' into memory.");
+      }
+      data_ = static_cast<const char *>(address);
+    }
+    // The mapping remains valid after the descriptor is closed.
+    close(fd);
+#else
+    std::ifstream in(filename.c_str(), std::ios::in | std::ios::binary);
+    in.seekg(0, std::ios::end);
+    size_ = in.tellg();
+    in.seekg(0, std::ios::beg);
+    contents_.resize(size_);
+    if (size_ > 0) in.read(contents_.data(), size_);
+    data_ = contents_.data();
+#endif
+
+    if (size_ < required) {
+      std::ostringstream err;
+      err << "Draw file '" << filename << "' is truncated.  The header "
+          << "promises " << layout_.number_of_draws() << " draws, which "
+          << "requires " << required << " bytes, but the file has only "
+          << size_ << ".";
+      report_error(err.str());
+    }
+  }
+
+  MappedDrawFile::~MappedDrawFile() {
+#ifndef _WIN32
+    if (data_) munmap(const_cast<char *>(data_), size_);
+#endif
+  }
+
+  //----------------------------------------------------------------------
+  int MappedDrawFile::parameter_index(const std::string &name) const {
+    int ans = layout_.parameter_index(name);
+    if (ans < 0) {
+      report_error("The draw file has no parameter named '" + name + "'.");
+    }
+    return ans;
+  }
+
+  //----------------------------------------------------------------------
+  void MappedDrawFile::check_iteration(std::int64_t iteration) const {
+    if (iteration < 0 || iteration >= layout_.number_of_draws()) {
+      std::ostringstream err;
+      err << "Draw " << iteration << " was requested, but the draw file "
+          << "contains " << layout_.number_of_draws() << " draws.";
+      report_error(err.str());
+    }
+  }
+
+  //----------------------------------------------------------------------
+  const char *MappedDrawFile::value_address(std::int64_t iteration,
+                                            int parameter) const {
+    check_iteration(iteration);
+    return data_ + layout_.value_offset(iteration, parameter);
+  }
+
+  //----------------------------------------------------------------------
+  ConstVectorView MappedDrawFile::values(std::int64_t iteration,
+                                         int parameter) const {
+    if (layout_.value_type() != DrawFileIO::DOUBLE_VALUES) {
+      report_error("MappedDrawFile::values requires a file of doubles.  "
+                   "Use copy_values for files of floats.");
+    }
+    const double *first = reinterpret_cast<const double *>(
+        value_address(iteration, parameter));
+    return ConstVectorView(first, layout_.dimension(parameter), 1);
+  }
+
+  //----------------------------------------------------------------------
+  void MappedDrawFile::copy_values(std::int64_t iteration, int parameter,
+                                   VectorView ans) const {
+    const int dimension = layout_.dimension(parameter);
+    if (ans.size() != dimension) {
+      report_error("Wrong size argument passed to "
+                   "MappedDrawFile::copy_values.");
+    }
+    const char *address = value_address(iteration, parameter);
+    if (layout_.value_type() == DrawFileIO::FLOAT_VALUES) {
+      const float *first = reinterpret_cast<const float *>(address);
+      for (int i = 0; i < dimension; ++i) ans[i] = first[i];
+    } else {
+      const double *first = reinterpret_cast<const double *>(address);
+      for (int i = 0; i < dimension; ++i) ans[i] = first[i];
+    }
+  }
+
+  //----------------------------------------------------------------------
+  std::vector<std::pair<std::int64_t, std::int64_t> >
+  MappedDrawFile::iteration_ranges(int number_of_ranges, std::int64_t begin,
+                                   std::int64_t end) const {
+    if (end < 0) end = number_of_draws();
+    if (begin < 0 || end > number_of_draws() || begin > end) {
+      report_error("Illegal iteration range in "
+                   "MappedDrawFile::iteration_ranges.");
+    }
+    if (number_of_ranges < 1) number_of_ranges = 1;
+    std::vector<std::pair<std::int64_t, std::int64_t> > ans;
+    const std::int64_t total = end - begin;
+    for (int i = 0; i < number_of_ranges; ++i) {
+      std::int64_t lo = begin + total * i / number_of_ranges;
+      std::int64_t hi = begin + total * (i + 1) / number_of_ranges;
+      if (hi > lo) ans.push_back(std::make_pair(lo, hi));
+    }
+    return ans;
+  }
+
+  //======================================================================
+  MappedDrawFile::Cursor::Cursor(const MappedDrawFile &file)
+      : file_(&file)
+  {}
+
+  void MappedDrawFile::Cursor::add_parameter(const Ptr<Params> &parameter,
+                                             const std::string &name) {
+    int position = file_->parameter_index(name);
+    if (parameter->size(false) != file_->layout().dimension(position)) {
+      std::ostringstream err;
+      err << "Parameter '" << name << "' has dimension "
+          << file_->layout().dimension(position) << " in the draw file, but "
+          << parameter->size(false) << " in the model.";
+      report_error(err.str());
+    }
+    parameters_.push_back(parameter);
+    file_positions_.push_back(position);
+  }
+
+  void MappedDrawFile::Cursor::read(std::int64_t iteration) {
+    for (int i = 0; i < parameters_.size(); ++i) {
+      const int position = file_positions_[i];
+      workspace_.resize(file_->layout().dimension(position));
+      file_->copy_values(iteration, position, VectorView(workspace_));
+      parameters_[i]->unvectorize(workspace_, false);
+    }
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,132 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include <cpputil/ThreadTools.hpp>
+
+namespace BOOM {
+
+  ThreadWorkerPool::ThreadWorkerPool(int number_of_threads)
+      : pending_(0),
+        shutting_down_(false)
+  {
+    set_number_of_threads(number_of_threads);
+  }
+
+  ThreadWorkerPool::~ThreadWorkerPool() {
+    shut_down();
+  }
+
+  void ThreadWorkerPool::set_number_of_threads(int n) {
+    if (n < 0) n = 0;
+    if (n == number_of_threads()) return;
+    shut_down();
+#ifndef _WIN32
+    shutting_down_ = false;
+    threads_.reserve(n);
+    for (int i = 0; i < n; ++i) {
+      threads_.emplace_back(&ThreadWorkerPool::worker_loop, this);
+    }
+#endif
+  }
+
+  int ThreadWorkerPool::number_of_threads() const {
+#ifndef _WIN32
+    return threads_.size();
+#else
+    return 0;
+#endif
+  }
+
+  void ThreadWorkerPool::run(const std::vector<std::function<void()>> &tasks) {
+    first_exception_ = nullptr;
+    if (number_of_threads() == 0 || tasks.size() <= 1) {
+      for (int i = 0; i < tasks.size(); ++i) {
+        try {
+          tasks[i]();
+        } catch (...) {
+          record_exception();
+        }
+      }
+    } else {
+#ifndef _WIN32
+      std::unique_lock<std::mutex> lock(mutex_);
+      for (int i = 0; i < tasks.size(); ++i) {
+        queue_.push_back(&tasks[i]);
+      }
+      pending_ = tasks.size();
+      work_available_.notify_all();
+      work_finished_.wait(lock, [this]() {return pending_ == 0;});
+#endif
+    }
+    if (first_exception_) {
+      std::exception_ptr exception = first_exception_;
+      first_exception_ = nullptr;
+      std::rethrow_exception(exception);
+    }
+  }
+
+  void ThreadWorkerPool::worker_loop() {
+#ifndef _WIN32
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      work_available_.wait(lock, [this]() {
+          return shutting_down_ || !queue_.empty();
+        });
+      if (queue_.empty()) {
+        // The only way to get here is if the pool is shutting down.
+        return;
+      }
+      const std::function<void()> *task = queue_.front();
+      queue_.pop_front();
+      lock.unlock();
+      try {
+        (*task)();
+      } catch (...) {
+        lock.lock();
+        record_exception();
+        lock.unlock();
+      }
+      lock.lock();
+      if (--pending_ == 0) {
+        work_finished_.notify_all();
+      }
+    }
+#endif
+  }
+
+  void ThreadWorkerPool::shut_down() {
+#ifndef _WIN32
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      shutting_down_ = true;
+    }
+    work_available_.notify_all();
+    for (int i = 0; i < threads_.size(); ++i) {
+      threads_[i].join();
+    }
+    threads_.clear();
+#endif
+  }
+
+  void ThreadWorkerPool::record_exception() {
+    if (!first_exception_) {
+      first_exception_ = std::current_exception();
+    }
+  }
+
+}  // namespace BOOM
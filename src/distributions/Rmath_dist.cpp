@@ -17,6 +17,8 @@
  */
 
 #include <distributions/Rmath_dist.hpp>
+#include <distributions.hpp>
+#include <LinAlg/VectorView.hpp>
 #define MATHLIB_STANDALONE
 #include <Bmath/Bmath.hpp>
 
@@ -38,6 +40,9 @@ namespace BOOM{
   double rnorm_mt(RNG &rng, double mu, double sig){
     return Rmath::rnorm_mt(rng, mu,sig);  }
 
+  void rnorm_mt(RNG &rng, VectorView out){
+    Rmath::norm_rand_fill(rng, out.data(), out.size(), out.stride());}
+
   /*--- Uniform Distribution ---*/
   double dunif(double x, double lo, double hi, bool log){
     return Rmath::dunif(x,lo,hi,log);  }
@@ -49,6 +54,9 @@ namespace BOOM{
   double runif_mt(RNG &rng, double lo, double hi){
     return Rmath::runif_mt(rng, lo,hi);}
 
+  void runif_mt(RNG &rng, VectorView out){
+    Rmath::unif_rand_fill(rng, out.data(), out.size(), out.stride());}
+
   /*--- Gamma Distribution ---*/
   double dgamma(double x, double a, double b, bool log){
     return Rmath::dgamma(x,a,1.0/b, log);  }
@@ -61,6 +69,9 @@ namespace BOOM{
   double rgamma_mt(RNG & rng, double a, double b){
     return Rmath::rgamma_mt(rng, a, 1.0/b);}
 
+  void rgamma_mt(RNG &rng, double shape, VectorView out){
+    Rmath::rgamma_fill(rng, shape, out.data(), out.size(), out.stride());}
+
   /* Beta Distribution */
   double dbeta(double x, double a, double b, bool log){
     return Rmath::dbeta(x,a,b,log);}
@@ -184,6 +195,9 @@ namespace BOOM{
   double rexp(double lam){ return Rmath::rexp(1.0/lam);}
   double rexp_mt(RNG & rng, double lam){ return Rmath::rexp_mt(rng, 1.0/lam);}
 
+  void rexp_mt(RNG &rng, VectorView out){
+    Rmath::exp_rand_fill(rng, out.data(), out.size(), out.stride());}
+
   /* Geometric Distribution */
   double dgeom(double x, double p, bool log){
     return Rmath::dgeom(x,p,log);}
@@ -25,6 +25,7 @@
 #include <LinAlg/Matrix.hpp>
 #include <LinAlg/SpdMatrix.hpp>
 #include <LinAlg/Cholesky.hpp>
+#include <cpputil/math_utils.hpp>
 #include <algorithm>
 
 namespace BOOM{
@@ -53,9 +54,20 @@ namespace BOOM{
     // L is the lower cholesky triange of Sigma
     uint n = mu.size();
     Vector wsp(n);
-    for(uint i = 0; i<n; ++i) wsp[i] = rnorm_mt(rng, 0,1);
+    rnorm_mt(rng, VectorView(wsp));
     return Lmult(L, wsp) + mu;
   }
+
+  void rmvn_L_mt(RNG &rng, const Matrix &L, VectorView out){
+    rnorm_mt(rng, out);
+    // Multiply by L from the bottom row up, so each z[j] is still
+    // available when rows i >= j need it.
+    for(int i = out.size() - 1; i >= 0; --i){
+      double total = 0;
+      for(int j = 0; j <= i; ++j) total += L(i, j) * out[j];
+      out[i] = total;
+    }
+  }
   //======================================================================
   Vector rmvn(const Vector &mu, const SpdMatrix &V){
     return rmvn_mt(GlobalRng::rng, mu, V); }
@@ -73,8 +85,7 @@ namespace BOOM{
   Vector rmvn_ivar_mt(RNG & rng, const Vector &mu, const SpdMatrix &ivar){
     // draws a multivariate normal with mean mu and inverse variance
     // Matrix ivar
-    Matrix U= ivar.chol().t();  /////// experimental
-    return rmvn_ivar_U_mt(rng, mu, U);
+    return rmvn_ivar_L_mt(rng, mu, ivar.chol());
   }
 
   Vector rmvn_ivar_U(const Vector &mu, const Matrix &U){
@@ -84,7 +95,7 @@ namespace BOOM{
     // U is the upper cholesky factor of the inverse variance Matrix
     uint n = mu.size();
     Vector z(n);
-    for(uint i =0; i<n; ++i) z[i] = rnorm_mt(rng, 0,1);
+    rnorm_mt(rng, VectorView(z));
     //    if ivar = L L^T then Sigma = (L^T)^{-1} L^{-1} = U U^T
     return Usolve_inplace(U,z) + mu;
   }
@@ -92,21 +103,32 @@ namespace BOOM{
   Vector rmvn_ivar_L(const Vector &mu, const Matrix &L){
     return rmvn_ivar_L_mt(GlobalRng::rng, mu, L);  }
   Vector rmvn_ivar_L_mt(RNG & rng, const Vector &mu, const Matrix &L){
-    // L is the lower cholesky triangle  of the inverse variance Matrix
-    return rmvn_ivar_U_mt(rng, mu, L.t());  }
+    // L is the lower cholesky triangle  of the inverse variance Matrix.
+    // Solving with L^T directly avoids forming the transpose.
+    uint n = mu.size();
+    Vector z(n);
+    rnorm_mt(rng, VectorView(z));
+    LTsolve_inplace(L, z);
+    return z += mu;
+  }
 
 
   Vector rmvn_suf(const SpdMatrix & Ivar, const Vector & IvarMu){
     return rmvn_suf_mt(GlobalRng::rng, Ivar, IvarMu);  }
 
   Vector rmvn_suf_mt(RNG & rng, const SpdMatrix & Ivar, const Vector & IvarMu){
-    Chol L(Ivar);
-    uint n = IvarMu.size();
-    Vector z(n);
-    for(uint i=0; i<n; ++i) z[i] = rnorm_mt(rng);
-    LTsolve_inplace(L.getL(), z);  // returns LT^-1 z which is ~ N(0, Ivar.inv)
-    z+= L.solve(IvarMu);
-    return z;
+    return rmvn_suf_mt(rng, Chol(Ivar), IvarMu);
+  }
+
+  Vector rmvn_ivar_mt(RNG & rng, const Vector &mu, const Chol &ivar_chol){
+    Vector z(mu.size());
+    rnorm_mt(rng, VectorView(z));
+    z = ivar_chol.LTsolve(z);  // ~ N(0, Ivar.inv)
+    return z += mu;
+  }
+
+  Vector rmvn_suf_mt(RNG & rng, const Chol & ivar_chol, const Vector & IvarMu){
+    return rmvn_ivar_mt(rng, ivar_chol.solve(IvarMu), ivar_chol);
   }
 
   //======================================================================
@@ -136,4 +158,17 @@ namespace BOOM{
   double dmvn(const Vector &y, const Vector &mu, const SpdMatrix &Siginv, bool logscale){
     double ldsi =Siginv.logdet();
     return dmvn(y,mu,Siginv, ldsi, logscale); }
+
+  double dmvn(const Vector &y, const Vector &mu, const Chol &Siginv_chol,
+              bool logscale){
+    if(!Siginv_chol.is_pos_def()){
+      return logscale ? negative_infinity() : 0.0;
+    }
+    const double log2pi = 1.83787706641;
+    double n = y.size();
+    double ans = 0.5*(Siginv_chol.logdet()
+                      - Siginv_chol.quadratic_form(y - mu)
+                      - n*log2pi);
+    return logscale ? ans : std::exp(ans);
+  }
 }
@@ -0,0 +1,204 @@
+/*
+  Copyright (C) 2016 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include <distributions/polya_gamma.hpp>
+#include <distributions.hpp>
+#include <cpputil/report_error.hpp>
+#include <cmath>
+#include <sstream>
+
+namespace BOOM {
+
+namespace {
+
+  const double pi = 3.141592653589793;
+  const double pi_squared = 9.869604401089358;
+
+  // The truncation point dividing the two proposal pieces in
+  // Devroye's method.  0.64 is the value that maximizes the
+  // acceptance rate.
+  const double truncation_point = 0.64;
+
+  // The number of terms kept in the sum of gammas representation.
+  const int number_of_series_terms = 200;
+
+  // The n'th term in the alternating series for the density of
+  // J*(1, z), evaluated at x.  The series has a different form above
+  // and below the truncation point.
+  inline double series_coefficient(int n, double x) {
+    const double k = n + 0.5;
+    if (x > truncation_point) {
+      return pi * k * exp(-0.5 * k * k * pi_squared * x);
+    } else {
+      return pow(2.0 / (pi * x), 1.5) * pi * k * exp(-2.0 * k * k / x);
+    }
+  }
+
+  // The probability that a proposal for J*(1, z) comes from the
+  // exponential piece (above the truncation point) rather than the
+  // inverse Gaussian piece (below it).
+  double exponential_proposal_mass(double z) {
+    const double t = truncation_point;
+    const double fz = 0.125 * pi_squared + 0.5 * z * z;
+    const double b = sqrt(1.0 / t) * (t * z - 1);
+    const double a = -sqrt(1.0 / t) * (t * z + 1);
+    const double x0 = log(fz) + fz * t;
+    const double xb = x0 - z + pnorm(b, 0, 1, true, true);
+    const double xa = x0 + z + pnorm(a, 0, 1, true, true);
+    const double q_over_p = 4.0 / pi * (exp(xb) + exp(xa));
+    return 1.0 / (1.0 + q_over_p);
+  }
+
+  // A draw from the inverse Gaussian distribution with mean 1/z and
+  // shape 1, truncated to (0, truncation_point).
+  double rtrun_inverse_gaussian(RNG &rng, double z) {
+    const double t = truncation_point;
+    const double mu = 1.0 / z;
+    double x = t + 1;
+    if (mu > t) {
+      // Propose from the truncated inverse chi-square (the z == 0
+      // case) and accept with probability exp(-z^2 x / 2).
+      double alpha = 0;
+      while (runif_mt(rng) > alpha) {
+        double e1 = rexp_mt(rng, 1);
+        double e2 = rexp_mt(rng, 1);
+        while (e1 * e1 > 2 * e2 / t) {
+          e1 = rexp_mt(rng, 1);
+          e2 = rexp_mt(rng, 1);
+        }
+        x = t / ((1 + t * e1) * (1 + t * e1));
+        alpha = exp(-0.5 * z * z * x);
+      }
+    } else {
+      // The mean is inside the truncation region, so draw from the
+      // untruncated distribution until the draw lands there.
+      while (x > t) {
+        double y = rnorm_mt(rng);
+        y *= y;
+        x = mu + 0.5 * mu * mu * y
+            - 0.5 * mu * sqrt(4 * mu * y + mu * mu * y * y);
+        if (runif_mt(rng) > mu / (mu + x)) {
+          x = mu * mu / x;
+        }
+      }
+    }
+    return x;
+  }
+
+  // A draw from J*(1, z) = 4 * PG(1, 2z) by Devroye's alternating
+  // series method.  z >= 0.
+  double rjstar1(RNG &rng, double z) {
+    const double fz = 0.125 * pi_squared + 0.5 * z * z;
+    const double exponential_mass = exponential_proposal_mass(z);
+    while (true) {
+      double x;
+      if (runif_mt(rng) < exponential_mass) {
+        x = truncation_point + rexp_mt(rng, 1) / fz;
+      } else {
+        x = rtrun_inverse_gaussian(rng, z);
+      }
+      double s = series_coefficient(0, x);
+      const double y = runif_mt(rng) * s;
+      for (int n = 1; ; ++n) {
+        if (n % 2 == 1) {
+          s -= series_coefficient(n, x);
+          if (y <= s) return x;
+        } else {
+          s += series_coefficient(n, x);
+          if (y > s) break;
+        }
+      }
+    }
+  }
+
+  // A draw from PG(b, z) using the first number_of_series_terms terms
+  // of the sum of gammas representation.  The expected value of the
+  // omitted terms is added to the result.
+  double rpolya_gamma_series(RNG &rng, double b, double z) {
+    const double c = z * z / (4 * pi_squared);
+    double ans = 0;
+    double mean_of_included_terms = 0;
+    for (int k = 1; k <= number_of_series_terms; ++k) {
+      const double denominator = (k - 0.5) * (k - 0.5) + c;
+      ans += rgamma_mt(rng, b, 1.0) / denominator;
+      mean_of_included_terms += b / denominator;
+    }
+    ans /= 2 * pi_squared;
+    mean_of_included_terms /= 2 * pi_squared;
+    const double tail = polya_gamma_mean(b, z) - mean_of_included_terms;
+    return ans + (tail > 0 ? tail : 0);
+  }
+
+  void check_shape(double b, const char *function_name) {
+    if (!(b > 0)) {
+      std::ostringstream err;
+      err << "The first argument to " << function_name
+          << " must be positive, but was " << b << ".";
+      report_error(err.str());
+    }
+  }
+
+}  // namespace
+
+  double polya_gamma_mean(double b, double z) {
+    z = fabs(z);
+    if (z < 1e-6) {
+      // tanh(z/2) / z = 1/2 - z^2 / 24 + ...
+      return b * (0.25 - z * z / 48);
+    }
+    return 0.5 * b * tanh(0.5 * z) / z;
+  }
+
+  double polya_gamma_variance(double b, double z) {
+    z = fabs(z);
+    if (z < 1e-3) {
+      // The leading terms of the Taylor series around z = 0, which
+      // avoid cancellation in sinh(z) - z.
+      return b * (1.0 / 24 - z * z / 120);
+    }
+    const double cosh_half = cosh(0.5 * z);
+    return 0.25 * b * (sinh(z) - z) / (z * z * z * cosh_half * cosh_half);
+  }
+
+  double rpolya_gamma_mt(RNG &rng, double b, double z) {
+    check_shape(b, "rpolya_gamma_mt");
+    const double half_z = 0.5 * fabs(z);
+    const double whole = floor(b);
+    const int number_of_whole_draws = lround(whole);
+    double ans = 0;
+    for (int i = 0; i < number_of_whole_draws; ++i) {
+      ans += rjstar1(rng, half_z);
+    }
+    ans *= 0.25;
+    const double fraction = b - whole;
+    if (fraction > 0) {
+      ans += rpolya_gamma_series(rng, fraction, z);
+    }
+    return ans;
+  }
+
+  double rpolya_gamma_normal_approximation_mt(RNG &rng, double b, double z) {
+    check_shape(b, "rpolya_gamma_normal_approximation_mt");
+    return rtrun_norm_mt(rng,
+                         polya_gamma_mean(b, z),
+                         sqrt(polya_gamma_variance(b, z)),
+                         0.0,
+                         true);
+  }
+
+}  // namespace BOOM
@@ -33,6 +33,62 @@ namespace BOOM{
     return ans;
   }
 
+  RNG split_rng(RNG &parent) {
+#ifdef BOOM_RNG_RANLUX
+    return RNG(seed_rng(parent));
+#else
+    uint64_t bits[4];
+    for (int i = 0; i < 4; ++i) bits[i] = parent.next();
+    RNG child;
+    child.seed(bits);
+    return child;
+#endif
+  }
+
+  namespace {
+    // The output function of splitmix64, a bijection on 64 bit words.
+    uint64_t splitmix64_finalizer(uint64_t z) {
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      return z ^ (z >> 31);
+    }
+  }  // namespace
+
+  void Xoshiro256PlusPlus::seed(unsigned long seed) {
+    uint64_t x = seed;
+    for (int i = 0; i < 4; ++i) {
+      // splitmix64
+      state_[i] = splitmix64_finalizer(x += 0x9e3779b97f4a7c15ULL);
+    }
+  }
+
+  void Xoshiro256PlusPlus::seed(const uint64_t (&bits)[4]) {
+    bool all_zero = true;
+    for (int i = 0; i < 4; ++i) {
+      state_[i] = splitmix64_finalizer(
+          bits[i] + (i + 1) * 0x9e3779b97f4a7c15ULL);
+      all_zero = all_zero && state_[i] == 0;
+    }
+    // The all-zero state is the one fixed point of xoshiro.
+    if (all_zero) state_[0] = 1;
+  }
+
+  void Xoshiro256PlusPlus::jump() {
+    static const uint64_t jump_polynomial[] = {
+      0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+      0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+    uint64_t s[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 4; ++i) {
+      for (int b = 0; b < 64; ++b) {
+        if (jump_polynomial[i] & (uint64_t(1) << b)) {
+          for (int j = 0; j < 4; ++j) s[j] ^= state_[j];
+        }
+        next();
+      }
+    }
+    for (int j = 0; j < 4; ++j) state_[j] = s[j];
+  }
+
   unsigned long seed_rng(){
     return seed_rng(GlobalRng::rng);
   }